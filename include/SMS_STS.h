@@ -70,6 +70,8 @@ public:
 	virtual int LockEprom(u8 ID);//eprom locked
 	virtual int CalibrationOfs(u8 ID);//set middle position
 	virtual int FeedBack(int ID);//servo information feedback
+	virtual int SyncFeedBackTx(u8 ID[], u8 IDN, u8 MemAddr = SMS_STS_PRESENT_POSITION_L, u8 nLen = SMS_STS_PRESENT_CURRENT_H-SMS_STS_PRESENT_POSITION_L+1);//sync read feedback(or part of it) of multi servos, send request
+	virtual int SyncFeedBackRx(u8 ID);//sync read feedback, receive block of one servo(Read*(-1) decode it)
 	virtual int ReadPos(int ID);//read position
 	virtual int ReadSpeed(int ID);//read speed
 	virtual int ReadLoad(int ID);//read motor load(0~1000, 1000 = 100% max load)
@@ -80,6 +82,7 @@ public:
 	virtual int ReadMode(int ID);//read working mode
 private:
 	u8 Mem[SMS_STS_PRESENT_CURRENT_H-SMS_STS_PRESENT_POSITION_L+1];
+	u8 syncMemAddr;
 };
 
 #endif
\ No newline at end of file
@@ -1,13 +1,33 @@
 #pragma once
 
 #include <ESPAsyncWebServer.h>
-#include <ArduinoJson.h>
+#include "metrics.h"
 
 // Initialize ALPACA endpoints
 void setupAlpacaEndpoints(AsyncWebServer &server);
 
-// JSON response helper
-void sendJSONResponse(AsyncWebServerRequest *request, JsonDocument &doc, int error);
+// Handlers must not touch the servo bus; anything slower than this is counted
+#define ALPACA_HANDLER_BUDGET_US 2000
+
+// Per-request cost of the Alpaca handlers (CPU time, heap held on return)
+struct AlpacaRequestStats {
+    uint32_t requests = 0;
+    uint64_t totalUs = 0;
+    uint32_t maxUs = 0;
+    uint32_t overBudget = 0;    // handlers slower than ALPACA_HANDLER_BUDGET_US
+    int64_t heapBytes = 0;      // sum of free-heap drop across each handler
+    uint32_t minFreeHeap = 0;   // since boot
+};
+AlpacaRequestStats getAlpacaRequestStats();
+void resetAlpacaRequestStats();
+
+// Per-endpoint request count and handler time (device methods, management, invalid)
+int getAlpacaEndpointCount();
+const char *getAlpacaEndpointName(int endpoint);
+LatencyHistogram getAlpacaEndpointLatency(int endpoint);
+
+// Device endpoint handler: dev is the validated Alpaca device number (rotator index)
+typedef void (*AlpacaDeviceHandler)(AsyncWebServerRequest *request, int dev);
 
 // ASCOM Alpaca Management Endpoints
 void handleDescription(AsyncWebServerRequest *request);
@@ -15,34 +35,40 @@ void handleApiVersion(AsyncWebServerRequest *request);
 void handleConfiguredDevices(AsyncWebServerRequest *request);
 
 // ASCOM Alpaca Common Device Endpoints
-void handleGetConnected(AsyncWebServerRequest *request);
-void handleSetConnected(AsyncWebServerRequest *request);
-void handleGetConnecting(AsyncWebServerRequest *request);
-void handleConnect(AsyncWebServerRequest *request);
-void handleGetDescription(AsyncWebServerRequest *request);
-void handleDeviceState(AsyncWebServerRequest *request);
-void handleDisconnect(AsyncWebServerRequest *request);
-void handleDriverInfo(AsyncWebServerRequest *request);
-void handleDriverVersion(AsyncWebServerRequest *request);
-void handleGetInterfaceVersion(AsyncWebServerRequest *request);
-void handleGetName(AsyncWebServerRequest *request);
-void handleSupportedActions(AsyncWebServerRequest *request);
+void handleGetConnected(AsyncWebServerRequest *request, int dev);
+void handleSetConnected(AsyncWebServerRequest *request, int dev);
+void handleGetConnecting(AsyncWebServerRequest *request, int dev);
+void handleConnect(AsyncWebServerRequest *request, int dev);
+void handleGetDescription(AsyncWebServerRequest *request, int dev);
+void handleDeviceState(AsyncWebServerRequest *request, int dev);
+void handleDisconnect(AsyncWebServerRequest *request, int dev);
+void handleDriverInfo(AsyncWebServerRequest *request, int dev);
+void handleDriverVersion(AsyncWebServerRequest *request, int dev);
+void handleGetInterfaceVersion(AsyncWebServerRequest *request, int dev);
+void handleGetName(AsyncWebServerRequest *request, int dev);
+void handleSupportedActions(AsyncWebServerRequest *request, int dev);
+void handleAction(AsyncWebServerRequest *request, int dev);
 
 // ASCOM Alpaca Rotator Specific Endpoints
-void handleCanReverse(AsyncWebServerRequest *request);
-void handleIsMoving(AsyncWebServerRequest *request);
-void handleMechanicalPosition(AsyncWebServerRequest *request);
-void handlePosition(AsyncWebServerRequest *request);
-void handleGetReverse(AsyncWebServerRequest *request);
-void handleSetReverse(AsyncWebServerRequest *request);
-void handleStepSize(AsyncWebServerRequest *request);
-void handleTargetPosition(AsyncWebServerRequest *request);
-void handleHalt(AsyncWebServerRequest *request);
-void handleMove(AsyncWebServerRequest *request);
-void handleMoveAbsolute(AsyncWebServerRequest *request);
-void handleMoveMechanical(AsyncWebServerRequest *request);
-void handleSync(AsyncWebServerRequest *request);
-
-// UDP Discovery
-void handleDiscovery();
+void handleCanReverse(AsyncWebServerRequest *request, int dev);
+void handleIsMoving(AsyncWebServerRequest *request, int dev);
+void handleMechanicalPosition(AsyncWebServerRequest *request, int dev);
+void handlePosition(AsyncWebServerRequest *request, int dev);
+void handleGetReverse(AsyncWebServerRequest *request, int dev);
+void handleSetReverse(AsyncWebServerRequest *request, int dev);
+void handleStepSize(AsyncWebServerRequest *request, int dev);
+void handleTargetPosition(AsyncWebServerRequest *request, int dev);
+void handleHalt(AsyncWebServerRequest *request, int dev);
+void handleMove(AsyncWebServerRequest *request, int dev);
+void handleMoveAbsolute(AsyncWebServerRequest *request, int dev);
+void handleMoveMechanical(AsyncWebServerRequest *request, int dev);
+void handleSync(AsyncWebServerRequest *request, int dev);
+
+// Why a move of dev would be refused now (not ready, servo not responding,
+// sequence running), nullptr when it is accepted; error gets the Alpaca
+// error number. Alpaca move handlers and the control panel share it.
+const char *moveRefusal(int dev, int *error = nullptr);
+
+// UDP Discovery (event driven: IPv4 broadcast and IPv6 group ff12::a1:9aca on port 32227)
 void initDiscovery(int alpacaPort);
+uint32_t getDiscoveryReplies();
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+#include "json_writer.h"
+
+// ============================================================================
+// ALPACA RESPONSE
+// ============================================================================
+// The Alpaca envelope (Value, ClientID, ClientTransactionID, ServerTransactionID,
+// ErrorNumber, ErrorMessage) is formatted straight into a fixed buffer inside the
+// response object, which ESPAsyncWebServer sends from there. Response objects come
+// from a static pool; the heap is only used when all pool slots are in flight.
+//
+//   AlpacaResponse *response = AlpacaResponse::begin(request);
+//   response->json().key("Value").number(angle);   // optional
+//   response->send();                              // or send(error, message)
+// ============================================================================
+
+#define ALPACA_RESPONSE_SIZE 768   // configureddevices with MAX_ROTATORS entries fits
+#define ALPACA_RESPONSE_POOL 4     // responses in flight without heap allocation
+
+// Alpaca error numbers
+#define ALPACA_OK 0
+#define ALPACA_ERROR_NOT_IMPLEMENTED 0x400
+#define ALPACA_ERROR_INVALID_VALUE 0x401
+#define ALPACA_ERROR_NOT_CONNECTED 0x407
+#define ALPACA_ERROR_INVALID_OPERATION 0x40B
+#define ALPACA_ERROR_ACTION_NOT_IMPLEMENTED 0x40C
+#define ALPACA_ERROR_DRIVER 0x500
+
+class AlpacaResponse : public AsyncAbstractResponse {
+public:
+    static AlpacaResponse *begin(AsyncWebServerRequest *request);
+    ~AlpacaResponse() override;
+
+    // Writer for the envelope body, positioned after the opening brace
+    JsonWriter &json() { return writer; }
+
+    // Appends the envelope fields, closes the object and hands the response to the server
+    void send(int error = ALPACA_OK, const char *message = "");
+
+    // Pool allocation
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
+
+    // AsyncAbstractResponse
+    bool _sourceValid() const override { return true; }
+    size_t _fillBuffer(uint8_t *data, size_t len) override;
+
+private:
+    explicit AlpacaResponse(AsyncWebServerRequest *request);
+
+    AsyncWebServerRequest *request;
+    uint32_t clientID = 0;
+    uint32_t clientTransactionID = 0;
+    size_t sent = 0;
+    char buffer[ALPACA_RESPONSE_SIZE];
+    JsonWriter writer;
+};
+
+// Case-insensitive Alpaca parameter lookup (query or form body) without temporary
+// Strings; returns "" when the parameter is missing
+const char *alpacaParam(AsyncWebServerRequest *request, const char *name);
+bool alpacaHasParam(AsyncWebServerRequest *request, const char *name);
+
+// Response path statistics
+struct AlpacaResponseStats {
+    uint32_t responses = 0;
+    uint32_t poolMisses = 0;    // responses that had to use the heap
+    uint32_t overflows = 0;     // body did not fit ALPACA_RESPONSE_SIZE
+    uint32_t maxLength = 0;     // longest response body in bytes
+};
+AlpacaResponseStats getAlpacaResponseStats();
+void resetAlpacaResponseStats();
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdint.h>
+#include <math.h>
+
+// ============================================================================
+// FIXED-POINT ANGLE MATH
+// ============================================================================
+// All rotator positions are handled as native servo steps (int32_t).
+// One motor revolution = 4096 steps, the 1:2 gear makes one full rotator
+// revolution = 8192 steps. Wrapping and shortest-path math are O(1) integer
+// operations; doubles are only used at the JSON / text boundary.
+// ============================================================================
+
+// Servo parameters from ST3215
+constexpr int32_t SERVO_STEPS_PER_REV = 4096;     // 0-4095 = 4096 Steps
+constexpr int32_t GEAR_RATIO = 2;                 // 1:2 (180° gear = 360° motor)
+constexpr int32_t GEAR_STEPS_PER_REV = SERVO_STEPS_PER_REV * GEAR_RATIO;
+
+// Conversion constants (gear degrees <-> steps)
+constexpr double DEGREES_PER_STEP = 360.0 / GEAR_STEPS_PER_REV;   // 0.0439°
+constexpr double STEPS_PER_DEGREE = GEAR_STEPS_PER_REV / 360.0;
+constexpr int32_t MILLIDEGREES_PER_REV = 360000;
+
+static_assert(GEAR_STEPS_PER_REV % 2 == 0, "shortest-path math needs an even step count");
+
+// Wrap any step count into [0, stepsPerRev)
+constexpr int32_t wrapSteps(int32_t steps, int32_t stepsPerRev = GEAR_STEPS_PER_REV) {
+    return (steps % stepsPerRev + stepsPerRev) % stepsPerRev;
+}
+
+// Shortest signed path from -> to, result in [-stepsPerRev/2, +stepsPerRev/2)
+constexpr int32_t shortestStepDelta(int32_t from, int32_t to, int32_t stepsPerRev = GEAR_STEPS_PER_REV) {
+    return wrapSteps(wrapSteps(to, stepsPerRev) - wrapSteps(from, stepsPerRev) + stepsPerRev / 2, stepsPerRev)
+           - stepsPerRev / 2;
+}
+
+// Gear steps -> integer millidegrees in [0, 360000), rounded
+constexpr int32_t stepsToMilliDegrees(int32_t steps, int32_t stepsPerRev = GEAR_STEPS_PER_REV) {
+    return (int32_t)(((int64_t)wrapSteps(steps, stepsPerRev) * MILLIDEGREES_PER_REV + stepsPerRev / 2) / stepsPerRev)
+           % MILLIDEGREES_PER_REV;
+}
+
+// JSON boundary: gear degrees (double) -> steps, rounded, not wrapped
+inline int32_t degreesToSteps(double degrees, int32_t stepsPerRev = GEAR_STEPS_PER_REV) {
+    return (int32_t)lround(degrees * stepsPerRev / 360.0);
+}
+
+// JSON boundary: steps -> gear degrees in [0, 360)
+inline double stepsToDegrees(int32_t steps, int32_t stepsPerRev = GEAR_STEPS_PER_REV) {
+    return wrapSteps(steps, stepsPerRev) * (360.0 / stepsPerRev);
+}
+
+static_assert(wrapSteps(-1) == GEAR_STEPS_PER_REV - 1, "wrapSteps");
+static_assert(wrapSteps(3 * GEAR_STEPS_PER_REV + 5) == 5, "wrapSteps");
+static_assert(shortestStepDelta(100, GEAR_STEPS_PER_REV - 100) == -200, "shortestStepDelta");
+static_assert(shortestStepDelta(GEAR_STEPS_PER_REV - 100, 100) == 200, "shortestStepDelta");
+static_assert(stepsToMilliDegrees(GEAR_STEPS_PER_REV / 4) == 90000, "stepsToMilliDegrees");
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+
+// ============================================================================
+// BOOT STAGES
+// ============================================================================
+// setup() brings the firmware up in parallel stages: the display first (a
+// few ms), the servo bus in its own one-shot task (scan, EEPROM setup, first
+// read) while setup() associates WiFi and starts the HTTP server. Alpaca
+// requests are answered from then on; device methods that need the servo
+// answer "not connected" until the servo stage is done (see alpaca_handlers).
+//
+// Each stage records its completion time since boot, the first Alpaca
+// response is logged on every boot, all of it is exported in /metrics
+// (moma_boot_*).
+// ============================================================================
+
+enum BootStage : uint8_t {
+    BOOT_DISPLAY = 0,   // OLED up, UI task running
+    BOOT_SERVO,         // rotators scanned and configured, bus tasks running
+    BOOT_NETWORK,       // station connected or access point up
+    BOOT_HTTP,          // web server accepting requests
+    BOOT_STAGE_COUNT
+};
+
+void bootStageDone(BootStage stage);        // logs the time since boot
+bool isBootStageDone(BootStage stage);
+uint32_t getBootStageMs(BootStage stage);   // 0 = not done yet
+const char *getBootStageName(int stage);
+
+// Called after every Alpaca response; only the first one is recorded and logged
+void bootAlpacaResponded();
+uint32_t getFirstAlpacaResponseMs();        // 0 = none yet
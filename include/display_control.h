@@ -17,9 +17,10 @@
 #endif
 
 // OLED Display functions
+// Drawing happens in the UI task (see task_monitor.h): before startDisplayTask()
+// calls draw right away, afterwards they are queued and return immediately.
 void initDisplay();
-void updateDisplay();
-void displayMotorInfo();
+void startDisplayTask();
 void displayMotorScan();
 void displayMessage(const char* line1, const char* line2 = nullptr, const char* line3 = nullptr, const char* line4 = nullptr);
 void displayOff();
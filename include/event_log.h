@@ -0,0 +1,104 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <ESPAsyncWebServer.h>
+
+// ============================================================================
+// ASYNCHRONOUS LEVELED LOG
+// ============================================================================
+// LOG_E/W/I/D(tag, fmt, args...) append a compact binary record (timestamp,
+// level, tag, format pointer, up to LOG_MAX_ARGS 32-bit arguments) to a
+// lock-free ring and return immediately. A low-priority task formats the
+// records and writes them to Serial and to a text buffer served at GET /log.
+// When the ring is full the record is dropped and counted, the caller never waits.
+//
+// The format string and %s arguments are stored as pointers: use string
+// literals or other static strings only (no String::c_str() of temporaries).
+// Floating point arguments are stored as float.
+//
+// Levels: LOG_LEVEL (build flag) removes calls above it at compile time,
+// per-tag runtime levels filter further: GET /log?level=debug[&tag=servo]
+// ============================================================================
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO   // build flag -DLOG_LEVEL=4 compiles in debug records
+#endif
+
+#define LOG_RING_SIZE 128          // records, power of two
+#define LOG_MAX_ARGS 6
+#define LOG_TEXT_BUFFER 4096       // formatted lines kept for GET /log
+
+enum LogTag : uint8_t {
+    LOG_TAG_SYSTEM = 0,
+    LOG_TAG_SERVO,
+    LOG_TAG_ALPACA,
+    LOG_TAG_WIFI,
+    LOG_TAG_DISPLAY,
+    LOG_TAG_COUNT
+};
+
+// Ring and drain statistics
+struct LogStats {
+    uint32_t written = 0;
+    uint32_t dropped = 0;       // ring full
+    uint32_t filtered = 0;      // below runtime level
+    uint32_t maxUsed = 0;       // high-water mark of the ring in records
+};
+
+void logInit();                 // Start the drain task (call first in setup())
+void setupLogEndpoints(AsyncWebServer &server);
+void setLogLevel(int tag, uint8_t level);   // tag < 0: all tags
+uint8_t getLogLevel(int tag);
+LogStats getLogStats();
+
+// ============================================================================
+// Internals used by the macros
+// ============================================================================
+
+extern uint8_t logRuntimeLevel[LOG_TAG_COUNT];
+void logPush(uint8_t level, LogTag tag, const char *fmt, const uintptr_t *args, uint8_t argc);
+void logFiltered();
+
+template<typename T>
+inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, uintptr_t>::type
+logArg(T v) {
+    return (uintptr_t)(intptr_t)v;
+}
+
+template<typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value, uintptr_t>::type
+logArg(T v) {
+    float f = (float)v;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+inline uintptr_t logArg(const char *s) {
+    return (uintptr_t)s;
+}
+
+template<typename... Args>
+inline void logWrite(uint8_t level, LogTag tag, const char *fmt, Args... args) {
+    static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+    if(level > logRuntimeLevel[tag]) {
+        logFiltered();
+        return;
+    }
+    const uintptr_t words[LOG_MAX_ARGS + 1] = {logArg(args)...};
+    logPush(level, tag, fmt, words, sizeof...(Args));
+}
+
+#define LOG_AT(level, tag, ...) do { if((level) <= LOG_LEVEL) logWrite((level), (tag), __VA_ARGS__); } while(0)
+#define LOG_E(tag, ...) LOG_AT(LOG_LEVEL_ERROR, tag, __VA_ARGS__)
+#define LOG_W(tag, ...) LOG_AT(LOG_LEVEL_WARN, tag, __VA_ARGS__)
+#define LOG_I(tag, ...) LOG_AT(LOG_LEVEL_INFO, tag, __VA_ARGS__)
+#define LOG_D(tag, ...) LOG_AT(LOG_LEVEL_DEBUG, tag, __VA_ARGS__)
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// ============================================================================
+// FIXED-BUFFER JSON WRITER
+// ============================================================================
+// Appends JSON into a caller-provided buffer: no heap, no printf, no floating
+// point formatting library. Commas are inserted automatically. When the buffer
+// is full the writer stops and sets overflow(); the output is then truncated.
+// Plain C++ (no Arduino headers), also used by host tools.
+// ============================================================================
+
+class JsonWriter {
+public:
+    JsonWriter(char *buffer, size_t capacity) : buf(buffer), cap(capacity) { reset(); }
+
+    void reset() {
+        len = 0;
+        first = true;
+        overflowed = false;
+        if(cap) buf[0] = '\0';
+    }
+
+    const char *c_str() const { return buf; }
+    size_t length() const { return len; }
+    bool overflow() const { return overflowed; }
+
+    JsonWriter &beginObject() { separator(); put('{'); first = true; return *this; }
+    JsonWriter &endObject() { put('}'); first = false; return *this; }
+    JsonWriter &beginArray() { separator(); put('['); first = true; return *this; }
+    JsonWriter &endArray() { put(']'); first = false; return *this; }
+
+    // Object member name; the next value follows without a comma
+    JsonWriter &key(const char *name) {
+        separator();
+        quoted(name);
+        put(':');
+        first = true;
+        return *this;
+    }
+
+    JsonWriter &string(const char *s) { separator(); quoted(s); return *this; }
+    JsonWriter &boolean(bool v) { separator(); append(v ? "true" : "false"); return *this; }
+    JsonWriter &null() { separator(); append("null"); return *this; }
+
+    JsonWriter &integer(long long v) {
+        separator();
+        if(v < 0) {
+            put('-');
+            digits(0ULL - (unsigned long long)v);
+        } else {
+            digits((unsigned long long)v);
+        }
+        return *this;
+    }
+
+    // Fixed-point decimal with up to `decimals` (max 9) fraction digits, trailing zeros trimmed
+    JsonWriter &number(double v, int decimals = 6) {
+        separator();
+        if(!finite(v) || v > 9.2e9 || v < -9.2e9) {  // out of range for the fixed-point path
+            append("null");
+            return *this;
+        }
+        if(decimals > 9) decimals = 9;
+        if(decimals < 0) decimals = 0;
+        unsigned long long scale = 1;
+        for(int i = 0; i < decimals; i++) scale *= 10;
+
+        bool negative = v < 0;
+        unsigned long long scaled = (unsigned long long)((negative ? -v : v) * (double)scale + 0.5);
+        unsigned long long whole = scaled / scale;
+        unsigned long long frac = scaled % scale;
+        if(negative && scaled != 0) put('-');
+        digits(whole);
+        if(frac != 0) {
+            char tmp[9];
+            int n = decimals;
+            while(n > 0 && frac % 10 == 0) { frac /= 10; n--; }
+            for(int i = n - 1; i >= 0; i--) { tmp[i] = (char)('0' + frac % 10); frac /= 10; }
+            put('.');
+            for(int i = 0; i < n; i++) put(tmp[i]);
+        }
+        return *this;
+    }
+
+    // Pre-formatted JSON fragment (caller guarantees validity)
+    JsonWriter &raw(const char *json) { separator(); append(json); return *this; }
+
+private:
+    char *buf;
+    size_t cap;
+    size_t len;
+    bool first;
+    bool overflowed;
+
+    // Exponent bits instead of isfinite(): survives -ffast-math
+    static bool finite(double v) {
+        uint64_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        return ((bits >> 52) & 0x7FF) != 0x7FF;
+    }
+
+    void separator() {
+        if(!first) put(',');
+        first = false;
+    }
+
+    void put(char c) {
+        if(len + 1 >= cap) {
+            overflowed = true;
+            return;
+        }
+        buf[len++] = c;
+        buf[len] = '\0';
+    }
+
+    void append(const char *s) {
+        while(*s) put(*s++);
+    }
+
+    void digits(unsigned long long v) {
+        char tmp[20];
+        int n = 0;
+        do {
+            tmp[n++] = (char)('0' + v % 10);
+            v /= 10;
+        } while(v);
+        while(n) put(tmp[--n]);
+    }
+
+    void quoted(const char *s) {
+        static const char hex[] = "0123456789abcdef";
+        put('"');
+        for(; *s; s++) {
+            unsigned char c = (unsigned char)*s;
+            if(c == '"' || c == '\\') {
+                put('\\');
+                put((char)c);
+            } else if(c < 0x20) {
+                append("\\u00");
+                put(hex[c >> 4]);
+                put(hex[c & 15]);
+            } else {
+                put((char)c);
+            }
+        }
+        put('"');
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include <ESPAsyncWebServer.h>
+
+// ============================================================================
+// PROMETHEUS METRICS
+// ============================================================================
+// GET /metrics in the Prometheus text exposition format (version 0.0.4):
+// task work time, budget overruns and stack (task_monitor.h), bus
+// transactions and errors, Alpaca requests and handler latency per endpoint,
+// feedback sample age, heap and WiFi link.
+//
+// Rendered block by block straight into the TCP send buffer from a response
+// object in static storage: no String, no heap (only when two scrapes
+// overlap, counted as moma_metrics_pool_misses_total).
+// ============================================================================
+
+#define METRICS_BUCKETS 12            // finite latency buckets, see metricsBucketsUs
+#define METRICS_BLOCK_SIZE 2048       // largest rendered block (one labelled histogram ~1.5 KB)
+
+// Fixed-bucket latency histogram; counts are per bucket, counts[METRICS_BUCKETS] is +Inf.
+// Not synchronized: the owner updates it from one task or under its own lock.
+struct LatencyHistogram {
+    uint32_t counts[METRICS_BUCKETS + 1] = {};
+    uint32_t count = 0;
+    uint64_t sumUs = 0;
+};
+extern const uint32_t metricsBucketsUs[METRICS_BUCKETS];
+void histogramObserve(LatencyHistogram &h, uint32_t us);
+
+void setupMetricsEndpoint(AsyncWebServer &server);
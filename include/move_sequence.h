@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdint.h>
+
+// ============================================================================
+// MOVE SEQUENCES
+// ============================================================================
+// A list of absolute moves, each followed by a dwell, run on the device
+// without a client round-trip per step (mosaic panels, flat-field series).
+// Started through the Alpaca Action "RunSequence", queried with
+// "SequenceStatus", stopped with "AbortSequence" or Halt.
+//
+// Arrival is taken from the bus task's position reads (isMotionSettled); the
+// next move is issued from an esp_timer one-shot at arrival + dwell, so the
+// step start does not depend on the FreeRTOS tick. Step start jitter is the
+// time from that schedule to the bus task writing the move (the step really
+// starting); the one-shot's own lateness, the part before the move is
+// queued, is reported separately.
+// ============================================================================
+
+#define SEQUENCE_MAX_STEPS 32
+#define SEQUENCE_MAX_DWELL_MS 3600000      // 1 h per step
+#define SEQUENCE_MOVE_TIMEOUT_MS 120000    // a move that does not settle fails the sequence
+
+struct SequenceStep {
+    int32_t targetSteps;    // absolute position
+    uint32_t dwellMs;       // after arrival
+    int16_t speed;          // 0 = keep the active speed
+};
+
+enum SequenceState : uint8_t {
+    SEQUENCE_IDLE = 0,
+    SEQUENCE_MOVING,
+    SEQUENCE_DWELLING,
+    SEQUENCE_DONE,
+    SEQUENCE_ABORTED,
+    SEQUENCE_FAILED,        // move timed out
+};
+
+struct SequenceStatus {
+    SequenceState state = SEQUENCE_IDLE;
+    int step = 0;                   // current step, 0-based
+    int steps = 0;
+    uint32_t elapsedMs = 0;         // since start
+    uint32_t dwellRemainingMs = 0;
+    // Step start lateness: move written to the servo minus arrival + dwell
+    uint32_t jitterCount = 0;
+    uint32_t jitterLastUs = 0;
+    uint32_t jitterMeanUs = 0;
+    uint32_t jitterMaxUs = 0;
+    // Part of it until the move was queued: esp_timer callback lateness
+    uint32_t timerLateLastUs = 0;
+    uint32_t timerLateMeanUs = 0;
+    uint32_t timerLateMaxUs = 0;
+};
+
+// "deg,dwellMs[,speed];deg,dwellMs[,speed];..." -> steps; error is set on failure
+bool parseSequence(const char *text, int32_t stepsPerRev, SequenceStep *steps, int &count, const char *&error);
+
+bool startSequence(int dev, const SequenceStep *steps, int count);  // false while one is running
+void abortSequence(int dev);    // Halts the rotator if a sequence is running
+bool isSequenceRunning(int dev);
+SequenceStatus getSequenceStatus(int dev);
+const char *sequenceStateName(SequenceState state);
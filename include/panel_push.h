@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+#include <ESPAsyncWebServer.h>
+
+// ============================================================================
+// CONTROL PANEL PUSH CHANNEL
+// ============================================================================
+// WebSocket /setup/v1/rotator/0/ws. One producer task samples the polled
+// rotator state (no bus access) every PANEL_PUSH_INTERVAL_MS and broadcasts
+// only what changed, as one message shared by all connected panels:
+//   {"ip":"192.168.1.50","rot":[{"d":0,"p":123.45,"m":true,"s":400,"r":false}]}
+//   d device, p position (°, 0.01 resolution), m moving, s speed, r reverse
+// No message is sent when nothing changed; after a panel connects the next
+// message carries the full state. Panel commands use the same socket as text
+// "I,P,D" (command number as for /cmd, position, device).
+// Statistics: GET /setup/v1/rotator/0/panelstats
+// ============================================================================
+
+#define PANEL_PUSH_INTERVAL_MS 200     // max. 5 messages/s, independent of the number of panels
+#define PANEL_MAX_CLIENTS 4
+
+struct PanelPushStats {
+    uint32_t clients = 0;
+    uint32_t messages = 0;      // broadcasts (one per change, not per panel)
+    uint32_t bytes = 0;
+    uint32_t fullStates = 0;
+    uint32_t commands = 0;
+    uint32_t refusedMoves = 0;  // not ready, servo not responding or sequence running
+    uint32_t rejected = 0;      // connections over PANEL_MAX_CLIENTS
+};
+
+void setupPanelPush(AsyncWebServer &server);   // Registers the socket and starts the producer task
+PanelPushStats getPanelPushStats();
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stdint.h>
+
+// ============================================================================
+// POSITION JOURNAL
+// ============================================================================
+// In Motor-Mode 3 the rotator position is only the step count the firmware
+// accumulated since boot (absolutePosition in servo_control). The journal
+// keeps it, with the motor target, in one NVS blob so a reboot comes back at
+// the last position instead of 0°.
+//
+// Writes are batched: a low-priority task looks at the polled state every
+// JOURNAL_CHECK_MS and writes once all rotators are settled, unchanged for
+// JOURNAL_QUIET_MS and JOURNAL_MIN_INTERVAL_MS after the previous write.
+// A burst of small moves costs one write; NVS appends the blob to its own
+// log-structured, wear-levelled pages, so repeated writes spread over the
+// partition. esp_restart() (restart endpoints, OTA) runs a shutdown handler
+// that writes the current state, a move still in flight included.
+//
+// A brownout resets the chip from the detector interrupt without running
+// any code, so the last batched state is what survives it: at most the
+// moves of the last JOURNAL_MIN_INTERVAL_MS are missing. The reset reason
+// is logged and reported.
+//
+// Restore (servo boot task, one NVS read and the first feedback read): an
+// entry is used when bus and ID match and the remaining distance the servo
+// reports fits the entry - near 0 after a settled write, at most the
+// distance still to go for an in-flight one. In-flight entries are only used
+// after esp_restart(): any other reset may have cut the servo power mid-move.
+// A servo that does not answer gets a settled entry unverified (nothing can
+// have moved it). Anything else keeps the former start at 0 and is reported.
+// A rotator turned by hand while the firmware was down cannot be detected:
+// Mode 3 has no absolute position.
+//
+// State per rotator: GET /setup/v1/rotator/0/servoboot; ?journal=flush
+// writes right away. Before switching the power off, wait until the
+// rotators stand still: an entry written mid-move does not survive it.
+// ============================================================================
+
+#define JOURNAL_CHECK_MS 500             // state check interval of the journal task
+#define JOURNAL_QUIET_MS 2000            // settled and unchanged this long before a write
+#define JOURNAL_MIN_INTERVAL_MS 10000    // between two batched writes
+
+#define JOURNAL_IN_FLIGHT 0x01           // entry flag: written while the rotator was moving
+
+// One rotator; all fields explicit, the blob is compared as bytes
+struct JournalEntry {
+    uint8_t bus;
+    uint8_t id;
+    uint8_t flags;
+    uint8_t reserved;
+    int32_t position;                    // absolutePosition: logical steps, target of the last move
+    int32_t motorTarget;                 // currentTargetPosition: motor steps
+    int32_t spanSteps;                   // distance still to go when written, 0 when settled
+};
+
+enum PositionRestoreState : uint8_t {
+    RESTORE_NONE = 0,                    // no journal entry for this rotator
+    RESTORE_OK,
+    RESTORE_UNVERIFIED,                  // restored, servo not answering at boot
+    RESTORE_OTHER_SERVO,                 // bus or ID differ from the journal: start at 0
+    RESTORE_RESIDUAL,                    // reported remaining distance does not fit: start at 0
+};
+
+struct PositionJournalStats {
+    uint32_t writes = 0;                 // NVS writes since boot, shutdown included
+    uint32_t folded = 0;                 // settled changes merged into a later write
+    uint32_t shutdownWrites = 0;
+    bool dirty = false;                  // state differs from the last write
+    int64_t lastWriteUs = 0;             // esp_timer time, 0 = none since boot
+    uint32_t lastWriteDurationUs = 0;
+    uint32_t loadUs = 0;                 // boot: NVS read of the journal
+};
+
+// Boot: reads the journal (also the baseline later writes are compared
+// with) and returns the number of entries, 0 = none
+int loadPositionJournal(JournalEntry *entries, int max);
+
+// Restore decision for one rotator; residual = remaining distance the servo reports
+PositionRestoreState checkJournalEntry(const JournalEntry &saved, uint8_t bus, uint8_t id,
+                                       bool feedback, int32_t residual);
+const char *restoreStateName(PositionRestoreState state);
+
+void startPositionJournal();             // task and shutdown handler, after the rotators are ready
+void flushPositionJournal();             // write now if changed, moves in flight included (restart only)
+PositionJournalStats getPositionJournalStats();
+const char *getResetReasonName();        // reason of the last reset, e.g. "brownout"
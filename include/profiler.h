@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "metrics.h"
+
+// ============================================================================
+// STAGE PROFILER
+// ============================================================================
+// Cycle-counter timing of the stages the tasks run per iteration (the work
+// the main loop used to do, see task_monitor.h): motion requests, move
+// writes and feedback reads in the bus tasks, the OLED frame, captive portal
+// DNS and the discovery reply.
+//
+// A task keeps one ProfileFrame on its stack per iteration: profileBegin(),
+// then profileMark(frame, stage) after each stage (the time since the
+// previous mark goes to that stage), then profileEnd(). Marks only read the
+// CPU cycle counter; profileEnd() folds the frame into the statistics under
+// one lock. Per stage: rolling average, maximum and latency histogram.
+// Iterations slower than the threshold keep their stage breakdown (the
+// PROFILER_WORST slowest since the last reset).
+//
+// GET /setup/v1/rotator/0/profile[?reset=1][&thresholdUs=n][&oled=0|1];
+// oled=1 shows the slowest stages on the display instead of the motor info.
+// Build flag -DPROFILER_ENABLED=0 compiles the calls to nothing.
+// ============================================================================
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#define PROFILER_WORST 4                    // slowest iterations kept
+#define PROFILER_DEFAULT_THRESHOLD_US 2000  // iterations captured above this
+
+enum ProfileStage : uint8_t {
+    STAGE_BUS_MOTION = 0,   // queued Alpaca motion requests
+    STAGE_BUS_MOVES,        // move writes
+    STAGE_BUS_FEEDBACK,     // scheduled feedback reads
+    STAGE_UI_DRAW,          // one OLED frame
+    STAGE_NET_DNS,          // captive portal DNS
+    STAGE_DISCOVERY,        // Alpaca discovery reply
+    STAGE_COUNT
+};
+
+struct ProfileStageStats {
+    uint32_t count = 0;
+    uint32_t avgCycles = 0;                 // moving average
+    uint32_t maxCycles = 0;
+    LatencyHistogram histogram;             // µs
+};
+
+struct ProfileCapture {
+    int64_t timeUs = 0;                     // esp_timer time at the end of the iteration
+    const char *task = "";
+    uint32_t totalCycles = 0;
+    uint32_t cycles[STAGE_COUNT] = {};
+    uint8_t stages = 0;                     // bit per stage the iteration ran
+};
+
+#if PROFILER_ENABLED
+
+struct ProfileFrame {
+    uint32_t mark;
+    uint32_t start;
+    uint32_t cycles[STAGE_COUNT];
+    uint8_t stages;
+    int core;                               // the cycle counter is per core
+};
+
+inline void profileBegin(ProfileFrame &frame) {
+    memset(frame.cycles, 0, sizeof(frame.cycles));
+    frame.stages = 0;
+    frame.core = xPortGetCoreID();
+    frame.start = frame.mark = ESP.getCycleCount();
+}
+
+inline void profileMark(ProfileFrame &frame, ProfileStage stage) {
+    uint32_t now = ESP.getCycleCount();
+    frame.cycles[stage] += now - frame.mark;
+    frame.stages |= 1 << stage;
+    frame.mark = now;
+}
+
+void profileEnd(ProfileFrame &frame, const char *task);
+
+#else
+
+struct ProfileFrame {};
+inline void profileBegin(ProfileFrame &) {}
+inline void profileMark(ProfileFrame &, ProfileStage) {}
+inline void profileEnd(ProfileFrame &, const char *) {}
+
+#endif
+
+const char *getProfileStageName(int stage);
+ProfileStageStats getProfileStageStats(int stage);
+int getProfileCaptures(ProfileCapture *out, int max);   // slowest first
+float profileCyclesToUs(uint32_t cycles);
+void resetProfiler();
+
+void setProfileThresholdUs(uint32_t us);
+uint32_t getProfileThresholdUs();
+void setProfileOnDisplay(bool on);
+bool isProfileOnDisplay();
+
+void setupProfileEndpoint(AsyncWebServer &server);
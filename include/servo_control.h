@@ -1,41 +1,190 @@
 #pragma once
 
+#include <stdint.h>
+#include "position_journal.h"
+
+// Maximum number of ST3215 rotators (Alpaca devices 0..N-1) and servo buses (UARTs)
+#define MAX_ROTATORS 4
+#define MAX_SERVO_BUSES 2
+
 // Servo initialization and control
-void initServo();
-int scanForMotor();  // Scan for motor ID on the bus
+void initServo();  // Opens the buses and returns; scan, EEPROM setup and bus tasks follow in a boot task
+
+// Bus layout cache: ID, bus, model and baud rate of every rotator are kept in
+// NVS; a warm boot checks them with one short read each and only scans the
+// buses when a servo does not answer as before
+struct ServoLinkResult {
+    bool cached = false;          // layout from the cache, no scan
+    uint32_t linkUs = 0;          // boot task start to all rotators known
+};
+ServoLinkResult getServoLinkResult();
+void forgetServoLinkCache();      // next boot scans
+bool isServoReady();  // Boot task done: rotators scanned and configured
+int scanForMotors();  // Scan all buses for motor IDs (or check the ROTATOR_MAP build flag servos), returns number found
+int getRotatorCount();  // 0 until isServoReady()
+void startServoBusTasks();  // One task per bus: flushes pending moves, polls feedback on schedule
+
+// Bus throughput benchmark: bus tasks taking turns vs. running in parallel
+struct BusBenchResult {
+    bool running = false;
+    uint32_t durationMs = 0;      // per phase
+    int activeBuses = 0;
+    float oneBusSamplesPerSec = 0;
+    float parallelSamplesPerSec = 0;
+};
+bool startBusBenchmark(uint32_t durationMs);
+BusBenchResult getBusBenchmarkResult();
+
+// Adaptive polling: position/speed/load fast while moving, slow when idle;
+// voltage/temperature/current and the mode register on their own low rates
+enum PollTier { POLL_TIER_POSITION = 0, POLL_TIER_SLOW, POLL_TIER_MODE, POLL_TIER_COUNT };
+struct PollSchedule {
+    uint16_t motionMs = 10;       // position tier while moving
+    uint16_t idleMs = 500;        // position tier while idle
+    uint32_t slowMs = 2000;       // voltage, temperature, current
+    uint32_t modeMs = 10000;      // mode register
+    uint16_t lingerMs = 1000;     // keep the motion rate this long after the last motion
+};
+struct PollTierStats {            // Achieved read intervals
+    uint32_t count = 0;
+    uint32_t lastIntervalUs = 0;
+    uint32_t avgIntervalUs = 0;   // moving average
+    uint32_t maxIntervalUs = 0;   // since boot or last setPollSchedule()
+};
+struct BusPollStats {
+    bool enabled = false;
+    int rotators = 0;
+    bool moving = false;
+    float occupancyPercent = 0;   // share of time the bus was busy (last second)
+    uint32_t transactions = 0;
+    uint32_t errors = 0;          // missing or invalid replies
+    PollTierStats tiers[POLL_TIER_COUNT];
+};
+// Link health: a rotator that stops answering (unplugged, unpowered) is
+// degraded from the first missed reply and offline after LINK_OFFLINE_AFTER.
+// Offline rotators are left out of reads, moves and mode polls, readers get
+// the last known state flagged stale, and the bus task probes with one PING
+// at exponential backoff; the first answer brings the rotator back with a
+// full read in the same bus task iteration.
+enum LinkState : uint8_t { LINK_ONLINE = 0, LINK_DEGRADED, LINK_OFFLINE };
+struct LinkHealth {
+    LinkState state = LINK_ONLINE;
+    uint32_t consecutiveErrors = 0;
+    uint32_t outages = 0;         // times the rotator went offline
+    uint32_t probes = 0;          // PINGs while offline
+    uint32_t probeIntervalMs = 0; // current backoff, 0 unless offline
+    int64_t changedUs = 0;        // esp_timer time of the last state change
+};
+LinkHealth getLinkHealth(int dev);
+bool isFeedbackStale(int dev);    // offline: all values are the last known state
+const char *linkStateName(LinkState state);
 
-// Movement functions
-void moveServoToAngle(double angleDeg);
-void moveServoByAngle(double deltaDeg);
-void gotoPosition(int targetPosition, int currentPos);
+PollSchedule getPollSchedule();
+void setPollSchedule(const PollSchedule &schedule);  // Clamped, persisted in NVS
+BusPollStats getBusPollStats(int bus);
+void setStreamPollInterval(uint16_t ms);  // Telemetry stream: idle position poll at most ms apart (0 = off)
+
+// Movement functions (dev = rotator/device number, positions in steps, see angle_math.h)
+void moveServoToSteps(int dev, int32_t targetSteps);
+void moveServoToAngle(int dev, double angleDeg);
+void moveServoByAngle(int dev, double deltaDeg);
+void gotoPosition(int dev, int targetPosition, int currentPos);
+
+// Deferred motion for request handlers: only records the request and wakes the
+// bus task, which reads fresh feedback and sends the move (no bus access here).
+// A newer request replaces a queued one, relative moves add up.
+void requestMoveTo(int dev, int32_t targetSteps);
+void requestMoveBy(int dev, int32_t deltaSteps);
+void requestHalt(int dev);
+struct MotionStats {
+    uint32_t requests = 0;
+    uint32_t applied = 0;
+    uint32_t merged = 0;          // replaced or combined before the bus task ran
+    uint32_t lastDelayUs = 0;     // request to bus write
+    uint32_t maxDelayUs = 0;
+};
+MotionStats getMotionStats();
+void resetMotionStats();
 
 // Zero point and calibration
-void resetServoAngleZero();
-void setZeroPointExact();
-void setZeroPointMode3();
-void setCurrentTargetPosition(int steps);  // For Sync command
+void resetServoAngleZero(int dev);
+void setZeroPointExact(int dev);
+void setZeroPointMode3(int dev);
+void setCurrentTargetPosition(int dev, int32_t steps);  // For Sync command
 
 // Control functions
-void stopServo();
-void servoTorque(bool enable);
-void setMode(int mode);
+void stopServo(int dev);
+void servoTorque(int dev, bool enable);
+void setMode(int dev, int mode);
+
+// EEPROM setup at boot and by setMode(): the motor-mode registers are read in
+// one transaction and only differing ones are written (read-compare-write)
+struct ServoConfigResult {
+    bool verified = false;        // profile read back and matching
+    uint8_t bytesChanged = 0;     // registers that differed
+    uint8_t writes = 0;           // EEPROM commands sent, unlock/lock included
+    uint8_t writesAvoided = 0;    // compared with the former unconditional setup
+    uint32_t durationUs = 0;
+    uint32_t savedMs = 0;         // compared with the former setup's fixed delays
+};
+ServoConfigResult getServoConfigResult(int dev);
+
+// Position journal (see position_journal.h): state to journal from the polled
+// values, no bus access; true when the rotator is settled (or offline, it
+// cannot move). The boot task restores the journaled position before the
+// rotators become ready.
+bool getJournalEntry(int dev, JournalEntry &entry);
+struct PositionRestore {
+    PositionRestoreState state = RESTORE_NONE;
+    bool inFlight = false;        // journaled while moving
+    int32_t position = 0;         // restored absolute position, steps
+    int32_t residual = 0;         // remaining distance reported at boot
+};
+PositionRestore getPositionRestore(int dev);
 
 // Status and feedback
-double getServoAngle();
-void getFeedback();
-bool isServoMoving();
-bool isMotorBlocked();
-int getServoLoad();
-int getServoSpeed();
-int getServoVoltage();
-int getServoCurrent();
-int getServoTemperature();
-int getServoMode();
-int getMotorID();
-void setReverseDirection(bool reverse);
-bool getReverseDirection();
+int32_t getServoSteps(int dev);
+int32_t getLastServoSteps(int dev);  // From the last poll, no bus access
+int64_t getLastFeedbackUs(int dev);  // esp_timer time of the last successful position read, 0 = none
+int64_t getLastMoveSentUs(int dev);  // esp_timer time the bus task wrote the last move, 0 = none
+// Arrived and stopped according to a read taken after the last move, nothing queued;
+// readUs = esp_timer time of that read. Uses the polled state, no bus transaction.
+bool isMotionSettled(int dev, int64_t *readUs = nullptr);
+double getServoAngle(int dev);
+
+// Consistent state of one rotator: every field comes from the same feedback read
+// of the bus task and the motion queue; no bus access, never waits for the bus
+struct RotatorSnapshot {
+    bool moving = false;          // queued, applied or sent and not yet read back settled
+    int32_t steps = 0;            // current position, wrapped to one revolution
+    int32_t targetSteps = 0;      // position after the active and any queued move
+    int32_t stepsPerRev = 0;
+    int64_t timeUs = 0;           // esp_timer time of the read
+    bool stale = false;           // rotator offline: last known state
+};
+bool getRotatorSnapshot(int dev, RotatorSnapshot &snapshot);  // false for an invalid device
+void getFeedback();  // On-demand: one SYNC_READ per bus for all rotators
+bool isServoMoving(int dev);      // Same rule as RotatorSnapshot::moving, polled state
+bool isMotorBlocked(int dev);     // Link offline
+int getServoLoad(int dev);
+int getServoSpeed(int dev);
+int getServoVoltage(int dev);
+int getServoCurrent(int dev);
+int getServoTemperature(int dev);
+int getServoMode(int dev);
+int getMotorID(int dev);
+int getServoModel(int dev);       // Model register from the scan or the link cache
+int getServoBus(int dev);
+int32_t getStepsPerRev(int dev);  // Steps per rotator revolution (gear ratio)
+// Gear ratio 1:ratio (motor revolutions per rotator revolution), NVS
+// "rotators"/"gear<dev>"; false when out of range or the rotator is moving
+#define GEAR_RATIO_MAX 100
+int getGearRatio(int dev);
+bool setGearRatio(int dev, int ratio);
+void setReverseDirection(int dev, bool reverse);
+bool getReverseDirection(int dev);
 
 // Position management
-int getCurrentTargetPosition();
-void setActiveSpeed(int speed);
-int getActiveSpeed();
\ No newline at end of file
+int32_t getCurrentTargetPosition(int dev);
+void setActiveSpeed(int dev, int speed);
+int getActiveSpeed(int dev);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include <ESPAsyncWebServer.h>
+#include "metrics.h"
+
+// ============================================================================
+// TASKS & TASK MONITOR
+// ============================================================================
+// The firmware runs as prioritized FreeRTOS tasks; loop() is not used.
+//
+//   task        core  prio  period            work
+//   bus0/bus1    1     3    poll schedule     moves, feedback reads (servo_control)
+//   sequence     1     2    5 ms when active  move sequence steps (move_sequence)
+//   ui           1     1    300 ms            OLED from polled state, display commands (display_control)
+//   net          0     1    10 ms AP / 500 ms DNS for the captive portal (wifi_manager)
+//   panel        0     1    200 ms            WebSocket push (panel_push)
+//   telstream    0     1    10 ms             binary telemetry stream (telemetry_stream)
+//   log          -     1    10 ms             log drain to Serial (event_log)
+//   journal      -     1    500 ms            batched position journal writes to NVS (position_journal)
+//   servoinit    1     2    once at boot      scan and EEPROM setup, not monitored (servo_control)
+//
+// Core 0 runs the WiFi driver and lwIP: network senders share it, motion and
+// UI stay on core 1 where WiFi interrupts and bursts cannot delay a bus read.
+// Tasks exchange state only through queues and polled snapshots; only the
+// bus tasks talk to the servos.
+//
+// Every task registers itself and brackets one unit of work per iteration:
+// work time against its budget, lateness of periodic wake-ups and the stack
+// high-water mark are reported at GET /setup/v1/rotator/0/tasks[?reset=1]
+// and in /metrics (moma_task_*).
+// ============================================================================
+
+#define TASK_CORE_NETWORK 0         // with the WiFi/lwIP tasks
+#define TASK_CORE_MOTION 1          // bus, sequences, display
+
+#define TASK_MONITOR_SLOTS 10
+
+struct TaskStats {
+    const char *name = "";
+    int core = -1;                  // -1: not pinned
+    uint8_t priority = 0;
+    uint32_t budgetUs = 0;          // work time allowed per iteration
+    uint32_t stackSize = 0;         // bytes
+    uint32_t stackFree = 0;         // high-water mark: least free stack since start, bytes
+    uint32_t runs = 0;
+    uint64_t totalUs = 0;
+    uint32_t lastUs = 0;
+    uint32_t maxUs = 0;
+    uint32_t overBudget = 0;        // iterations slower than budgetUs
+    uint32_t lateMaxUs = 0;         // periodic wake-up later than due
+    LatencyHistogram work;          // work time per iteration
+};
+
+// Called by the task itself; returns its slot (-1 when all slots are taken)
+int taskMonitorAdd(const char *name, int core, uint32_t budgetUs, uint32_t stackSize);
+
+// One unit of work; dueUs = esp_timer time the task was meant to wake (0: event driven)
+void taskWorkBegin(int slot, int64_t dueUs = 0);
+void taskWorkEnd(int slot);
+
+// Fixed-rate wait: advances dueUs by periodUs and sleeps until then; after an
+// overrun the schedule restarts from now instead of running back to back
+void taskDelayUntil(int64_t &dueUs, uint32_t periodUs);
+
+int getTaskCount();
+bool getTaskStats(int slot, TaskStats &stats);   // stack high-water mark read on the call
+void resetTaskStats();
+
+void setupTaskEndpoint(AsyncWebServer &server);
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdint.h>
+#include <ESPAsyncWebServer.h>
+
+// ============================================================================
+// TELEMETRY TIME-SERIES LOG
+// ============================================================================
+// In-RAM ring buffers of packed servo samples, fed by the bus tasks:
+//   tier 0 (full): one sample per rotator every TELEMETRY_FULL_PERIOD_MS
+//   tier 1:        min/max/mean per rotator over TELEMETRY_TIER1_PERIOD_MS
+//   tier 2:        min/max/mean per rotator over TELEMETRY_TIER2_PERIOD_MS
+// All buffers are static (fixed memory budget, no heap). With several rotators
+// the buffers are shared, so the covered time span divides by the rotator count.
+// Export: GET /telemetry?tier=0|1|2&format=csv|bin[&dev=n]
+// ============================================================================
+
+#define TELEMETRY_FULL_PERIOD_MS 100      // 10 Hz
+#define TELEMETRY_FULL_SAMPLES 1200       // 2 min for one rotator
+#define TELEMETRY_TIER1_PERIOD_MS 10000   // 10 s buckets
+#define TELEMETRY_TIER1_SAMPLES 180       // 30 min
+#define TELEMETRY_TIER2_PERIOD_MS 60000   // 1 min buckets
+#define TELEMETRY_TIER2_SAMPLES 480       // 8 h
+#define TELEMETRY_MEMORY_BUDGET 65536     // bytes for all three tiers
+
+// Status bits
+#define TELEMETRY_STATUS_MOVING 0x01
+#define TELEMETRY_STATUS_BLOCKED 0x02     // Motor block / communication lost
+#define TELEMETRY_STATUS_HIGH_LOAD 0x04
+#define TELEMETRY_STATUS_COMM_ERROR 0x08  // This poll failed, values are last known
+
+// Full-rate sample, little-endian, 22 bytes (binary export record)
+struct __attribute__((packed)) TelemetrySample {
+    uint64_t timeUs;        // esp_timer time since boot
+    int32_t position;       // logical position in steps (not wrapped)
+    int16_t speed;          // steps/s
+    int16_t load;           // 0.1 %
+    int16_t current;        // 6.5 mA units
+    uint8_t voltage;        // 0.1 V
+    uint8_t temperature;    // °C
+    uint8_t status;         // TELEMETRY_STATUS_*
+    uint8_t dev;            // rotator number
+};
+
+// Downsampled bucket, little-endian, 48 bytes (binary export record)
+struct __attribute__((packed)) TelemetryAggregate {
+    uint64_t startUs;       // time of first sample in bucket
+    uint16_t count;         // samples in bucket
+    uint8_t dev;
+    uint8_t status;         // OR of all sample status bits
+    int32_t positionMin, positionMax, positionMean;
+    int16_t speedMin, speedMax, speedMean;
+    int16_t loadMin, loadMax, loadMean;
+    int16_t currentMin, currentMax, currentMean;
+    uint8_t voltageMin, voltageMax, voltageMean;
+    uint8_t temperatureMin, temperatureMax, temperatureMean;
+};
+
+// Record one poll result (called by the bus tasks, decimated internally)
+void telemetryRecord(const TelemetrySample &sample);
+
+// Number of records currently held in a tier (0..2)
+uint32_t telemetryCount(int tier);
+
+// HTTP export endpoint
+void setupTelemetryEndpoints(AsyncWebServer &server);
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include <ESPAsyncWebServer.h>
+#include "telemetry_log.h"
+
+// ============================================================================
+// BINARY TELEMETRY STREAM
+// ============================================================================
+// Raw TCP on TELEMETRY_STREAM_PORT: every position poll of every rotator as a
+// fixed-size little-endian record, undecimated (the HTTP export keeps 10 Hz).
+// While a client is connected the idle position poll runs at the stream rate
+// (default 50 Hz, client may send "rate <hz>\n", 1..100).
+//
+// Connection: TelemetryStreamHeader once, then TelemetryStreamRecord records.
+// seq counts all records of the stream (all rotators); a jump in seq means
+// records were dropped because the client read too slowly. No seq jump = lossless.
+// Decoder: tools/telemetry_stream.cpp
+// Statistics: GET /setup/v1/rotator/0/telemetrystream
+// ============================================================================
+
+#define TELEMETRY_STREAM_PORT 8765
+#define TELEMETRY_STREAM_RING 512         // records buffered for slow clients (~2.5 s at 4 x 50 Hz)
+#define TELEMETRY_STREAM_CLIENTS 2
+#define TELEMETRY_STREAM_DEFAULT_HZ 50
+#define TELEMETRY_STREAM_MAGIC 0x5354524D  // "MRTS" little-endian
+#define TELEMETRY_STREAM_VERSION 1
+
+// Sent once per connection, 16 bytes
+struct __attribute__((packed)) TelemetryStreamHeader {
+    uint32_t magic;         // TELEMETRY_STREAM_MAGIC
+    uint16_t version;       // TELEMETRY_STREAM_VERSION
+    uint16_t recordSize;    // sizeof(TelemetryStreamRecord)
+    int32_t stepsPerRev;    // rotator 0, for step -> degree conversion
+    uint8_t rotators;
+    uint8_t rateHz;         // position poll rate while streaming
+    uint16_t reserved;
+};
+
+// One position poll, 22 bytes
+struct __attribute__((packed)) TelemetryStreamRecord {
+    uint32_t seq;           // stream sequence number
+    uint64_t timeUs;        // esp_timer time since boot
+    int32_t position;       // logical position in steps (not wrapped)
+    int16_t speed;          // steps/s
+    int16_t load;           // 0.1 %
+    uint8_t status;         // TELEMETRY_STATUS_*
+    uint8_t dev;            // rotator number
+};
+
+// Called by the bus tasks for every position poll
+void telemetryStreamRecord(const TelemetrySample &sample);
+
+void setupTelemetryStream(AsyncWebServer &server);   // Statistics endpoint, starts the TCP server task
+
+struct TelemetryStreamStats {
+    uint32_t records = 0;       // produced
+    uint32_t sent = 0;          // records sent, all clients
+    uint32_t dropped = 0;       // skipped by slow clients
+    uint8_t clients = 0;
+    uint8_t rateHz = 0;
+};
+TelemetryStreamStats getTelemetryStreamStats();
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// EMBEDDED WEB ASSETS
+// ============================================================================
+// Pages from web/, minified and gzipped at build time by tools/embed_web.py
+// into src/web_assets.cpp (const data, stays in flash). Served as is with
+// Content-Encoding: gzip, ETag and Cache-Control; no per-request copy.
+// ============================================================================
+
+struct WebAsset {
+    const char *name;           // file name in web/
+    const char *contentType;
+    const uint8_t *data;        // gzip
+    size_t length;
+    const char *etag;           // quoted, hash of the gzip data
+};
+
+extern const WebAsset webAssets[];
+extern const size_t webAssetCount;
@@ -18,10 +18,20 @@ void handleCaptivePortal(AsyncWebServerRequest *request);
 
 // Control panel
 void handleConfigDevices(AsyncWebServerRequest *request);
+// cmdI: command number of /cmd; returns why a move was refused, nullptr when done
+const char *handlePanelCommand(int dev, int cmdI, double cmdP);
 
 // Helper functions
 void setupWiFiEndpoints(AsyncWebServer &server);
 void processDNS();
+void startNetworkTask();   // runs processDNS() on TASK_CORE_NETWORK
 
 // Get IP address
 String getIPAddress();
+
+// Station link events since boot
+struct WiFiLinkStats {
+    uint32_t disconnects = 0;
+    uint32_t reconnects = 0;    // got an IP again after the first connection
+};
+WiFiLinkStats getWiFiLinkStats();
@@ -9,14 +9,17 @@
 SMS_STS::SMS_STS()
 {
 	End = 0;
+	syncMemAddr = SMS_STS_PRESENT_POSITION_L;
 }
 
 SMS_STS::SMS_STS(u8 End):SCSerial(End)
 {
+	syncMemAddr = SMS_STS_PRESENT_POSITION_L;
 }
 
 SMS_STS::SMS_STS(u8 End, u8 Level):SCSerial(End, Level)
 {
+	syncMemAddr = SMS_STS_PRESENT_POSITION_L;
 }
 
 int SMS_STS::WritePosEx(u8 ID, s16 Position, u16 Speed, u8 ACC)
@@ -133,6 +136,29 @@ int SMS_STS::FeedBack(int ID)
 	return nLen;
 }
 
+int SMS_STS::SyncFeedBackTx(u8 ID[], u8 IDN, u8 MemAddr, u8 nLen)
+{
+	if(MemAddr<SMS_STS_PRESENT_POSITION_L || MemAddr+nLen>SMS_STS_PRESENT_POSITION_L+sizeof(Mem)){
+		return -1;
+	}
+	syncMemAddr = MemAddr;
+	rFlushSCS();
+	syncReadPacketTx(ID, IDN, MemAddr, nLen);
+	wFlushSCS();
+	return IDN;
+}
+
+int SMS_STS::SyncFeedBackRx(u8 ID)
+{
+	int nLen = syncReadPacketRx(ID, Mem+(syncMemAddr-SMS_STS_PRESENT_POSITION_L));
+	if(nLen==0 || nLen!=syncReadRxPacketLen){
+		Err = 1;
+		return -1;
+	}
+	Err = 0;
+	return nLen;
+}
+
 int SMS_STS::ReadPos(int ID)
 {
 	int Pos = -1;
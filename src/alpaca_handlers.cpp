@@ -1,142 +1,329 @@
 #include "alpaca_handlers.h"
 #include "servo_control.h"
-#include <WiFiUdp.h>
-
-// Constants for Sync calculation (same as in servo_control.cpp)
-#define GEAR_RATIO 2.0
-#define SERVO_STEPS 4096.0
-#define SERVO_ANGLE_RANGE 360.0
-
-// Device status
-static bool isConnected = false;
-static bool reverseState = false;
-static String deviceName = "MoMa Rotator";
-
-// UDP Discovery
-static WiFiUDP udp;
+#include "angle_math.h"
+#include "alpaca_response.h"
+#include "move_sequence.h"
+#include "metrics.h"
+#include "event_log.h"
+#include "profiler.h"
+#include "boot_status.h"
+#include <AsyncUDP.h>
+#include <esp_heap_caps.h>
+#include <sys/time.h>
+#include <time.h>
+
+// Device status (per rotator / Alpaca device number)
+static bool isConnected[MAX_ROTATORS] = {false};
+static const char *deviceName = "MoMa Rotator";
+
+#define TIME_VALID_AFTER 1609459200   // 2021-01-01: earlier wall time means SNTP has not synced yet
+
+// UDP Discovery: AsyncUDP answers from the lwIP task, nothing runs in loop()
+static AsyncUDP discovery4;
+#ifdef CONFIG_LWIP_IPV6
+static AsyncUDP discovery6;
+static const uint8_t discoveryGroup6[16] = {0xff, 0x12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xa1, 0x9a, 0xca};  // ff12::a1:9aca
+#endif
 static const int udpPort = 32227;
-static IPAddress multicastAddress(233, 255, 255, 255);
-static char packetBuffer[255];
-static int alpacaPortGlobal = 80;
-static bool udpInitialized = false;
+static char discoveryReply[32];         // {"AlpacaPort":n}, built once in initDiscovery()
+static size_t discoveryReplyLength = 0;
+static uint32_t discoveryReplies = 0;
 
 // ============================================================================
-// INITIALIZATION
+// UDP DISCOVERY
 // ============================================================================
 
+static void onDiscoveryPacket(AsyncUDPPacket &packet) {
+    if (packet.length() < 16 || memcmp(packet.data(), "alpacadiscovery1", 16) != 0) {
+        return;
+    }
+    ProfileFrame frame;
+    profileBegin(frame);
+    packet.write((const uint8_t *)discoveryReply, discoveryReplyLength);  // to the sender
+    profileMark(frame, STAGE_DISCOVERY);
+    profileEnd(frame, "discovery");
+    discoveryReplies++;
+    LOG_D(LOG_TAG_ALPACA, "Discovery response sent (%s)", packet.isIPv6() ? "IPv6" : "IPv4");
+}
+
 void initDiscovery(int alpacaPort) {
-    alpacaPortGlobal = alpacaPort;
-    if(WiFi.status() == WL_CONNECTED) {
-        udp.beginMulticast(multicastAddress, udpPort);
-        udpInitialized = true;
-        Serial.println("UDP Discovery initialized on port 32227");
-    } else {
-        Serial.println("UDP Discovery will start when WiFi connects");
-        udpInitialized = false;
+    discoveryReplyLength = snprintf(discoveryReply, sizeof(discoveryReply), "{\"AlpacaPort\":%d}", alpacaPort);
+
+    // Bound to the any-address: works on every interface once it is up (STA or AP)
+    discovery4.onPacket(onDiscoveryPacket);
+    if (!discovery4.listen(IPAddress(0, 0, 0, 0), udpPort)) {
+        LOG_E(LOG_TAG_ALPACA, "UDP Discovery: port %d not available", udpPort);
     }
+#ifdef CONFIG_LWIP_IPV6
+    discovery6.onPacket(onDiscoveryPacket);
+    if (!discovery6.listenMulticast(IPv6Address(discoveryGroup6), udpPort)) {
+        LOG_W(LOG_TAG_ALPACA, "UDP Discovery: IPv6 group ff12::a1:9aca not joined");
+    }
+#endif
+    LOG_I(LOG_TAG_ALPACA, "UDP Discovery listening on port %d", udpPort);
 }
 
-void setupAlpacaEndpoints(AsyncWebServer &server) {
-    // ASCOM Alpaca Management Endpoints
-    server.on("/management/v1/description", HTTP_GET, handleDescription);
-    server.on("/management/apiversions", HTTP_GET, handleApiVersion);
-    server.on("/management/v1/configureddevices", HTTP_GET, handleConfiguredDevices);
+uint32_t getDiscoveryReplies() {
+    return discoveryReplies;
+}
 
+// ============================================================================
+// DEVICE API ROUTING
+// ============================================================================
+// One handler for /api/v1/{devicetype}/{n}/{method}: the path is parsed once,
+// the method name is looked up in a compile-time perfect-hash table and device
+// number and HTTP verb are validated before the typed handler runs.
+// Until the servo boot stage is done only methods marked early are served.
+
+struct AlpacaMethod {
+    const char *name;
+    AlpacaDeviceHandler get;
+    AlpacaDeviceHandler put;
+    bool early = false;     // answered while the servo is still initializing
+};
+
+static constexpr AlpacaMethod alpacaMethods[] = {
     // ASCOM Alpaca Common Device Endpoints
-    server.on("/api/v1/rotator/0/connected", HTTP_GET, handleGetConnected);
-    server.on("/api/v1/rotator/0/connected", HTTP_PUT, handleSetConnected);
-    server.on("/api/v1/rotator/0/connecting", HTTP_GET, handleGetConnecting);
-    server.on("/api/v1/rotator/0/connect", HTTP_PUT, handleConnect);
-    server.on("/api/v1/rotator/0/description", HTTP_GET, handleGetDescription);
-    server.on("/api/v1/rotator/0/devicestate", HTTP_GET, handleDeviceState);
-    server.on("/api/v1/rotator/0/disconnect", HTTP_PUT, handleDisconnect);
-    server.on("/api/v1/rotator/0/driverinfo", HTTP_GET, handleDriverInfo);
-    server.on("/api/v1/rotator/0/driverversion", HTTP_GET, handleDriverVersion);
-    server.on("/api/v1/rotator/0/interfaceversion", HTTP_GET, handleGetInterfaceVersion);
-    server.on("/api/v1/rotator/0/name", HTTP_GET, handleGetName);
-    server.on("/api/v1/rotator/0/supportedactions", HTTP_GET, handleSupportedActions);
+    {"connected", handleGetConnected, handleSetConnected, true},
+    {"connecting", handleGetConnecting, nullptr, true},
+    {"connect", nullptr, handleConnect, true},
+    {"description", handleGetDescription, nullptr, true},
+    {"devicestate", handleDeviceState, nullptr},
+    {"disconnect", nullptr, handleDisconnect, true},
+    {"driverinfo", handleDriverInfo, nullptr, true},
+    {"driverversion", handleDriverVersion, nullptr, true},
+    {"interfaceversion", handleGetInterfaceVersion, nullptr, true},
+    {"name", handleGetName, nullptr, true},
+    {"supportedactions", handleSupportedActions, nullptr, true},
+    {"action", nullptr, handleAction},
 
     // ASCOM Alpaca Rotator Specific Endpoints
-    server.on("/api/v1/rotator/0/canreverse", HTTP_GET, handleCanReverse);
-    server.on("/api/v1/rotator/0/ismoving", HTTP_GET, handleIsMoving);
-    server.on("/api/v1/rotator/0/mechanicalposition", HTTP_GET, handleMechanicalPosition);
-    server.on("/api/v1/rotator/0/position", HTTP_GET, handlePosition);
-    server.on("/api/v1/rotator/0/reverse", HTTP_GET, handleGetReverse);
-    server.on("/api/v1/rotator/0/reverse", HTTP_PUT, handleSetReverse);
-    server.on("/api/v1/rotator/0/stepsize", HTTP_GET, handleStepSize);
-    server.on("/api/v1/rotator/0/targetposition", HTTP_GET, handleTargetPosition);
-    server.on("/api/v1/rotator/0/halt", HTTP_PUT, handleHalt);
-    server.on("/api/v1/rotator/0/move", HTTP_PUT, handleMove);
-    server.on("/api/v1/rotator/0/moveabsolute", HTTP_PUT, handleMoveAbsolute);
-    server.on("/api/v1/rotator/0/movemechanical", HTTP_PUT, handleMoveMechanical);
-    server.on("/api/v1/rotator/0/sync", HTTP_PUT, handleSync);
+    {"canreverse", handleCanReverse, nullptr},
+    {"ismoving", handleIsMoving, nullptr},
+    {"mechanicalposition", handleMechanicalPosition, nullptr},
+    {"position", handlePosition, nullptr},
+    {"reverse", handleGetReverse, handleSetReverse},
+    {"stepsize", handleStepSize, nullptr},
+    {"targetposition", handleTargetPosition, nullptr},
+    {"halt", nullptr, handleHalt},
+    {"move", nullptr, handleMove},
+    {"moveabsolute", nullptr, handleMoveAbsolute},
+    {"movemechanical", nullptr, handleMoveMechanical},
+    {"sync", nullptr, handleSync},
+};
+
+#define ALPACA_METHOD_COUNT (sizeof(alpacaMethods) / sizeof(alpacaMethods[0]))
+#define ALPACA_METHOD_SLOTS 128  // power of two, > 2x method count keeps seed search short
+#define ALPACA_API_PREFIX "/api/v1/"
+#define ALPACA_DEVICE_TYPE "rotator"
+
+static_assert(ALPACA_METHOD_COUNT < ALPACA_METHOD_SLOTS, "too many Alpaca methods for the hash table");
+
+// FNV-1a with a seed, evaluated at compile time for the table and at run time for lookups
+static constexpr uint32_t methodHash(const char *s, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    while (*s) {
+        h = (h ^ (uint8_t)*s++) * 16777619u;
+    }
+    return h & (ALPACA_METHOD_SLOTS - 1);
 }
 
-// ============================================================================
-// JSON RESPONSE HELPER
-// ============================================================================
+static constexpr bool seedIsPerfect(uint32_t seed) {
+    bool used[ALPACA_METHOD_SLOTS] = {};
+    for (size_t i = 0; i < ALPACA_METHOD_COUNT; i++) {
+        uint32_t slot = methodHash(alpacaMethods[i].name, seed);
+        if (used[slot]) return false;  // also catches duplicate names
+        used[slot] = true;
+    }
+    return true;
+}
+
+static constexpr uint32_t findMethodSeed() {
+    for (uint32_t seed = 0; seed < 10000; seed++) {
+        if (seedIsPerfect(seed)) return seed;
+    }
+    return UINT32_MAX;
+}
 
-void sendJSONResponse(AsyncWebServerRequest *request, JsonDocument &doc, int error) {
-    static int serverTransactionID = 0;
-    serverTransactionID++;
+struct AlpacaMethodSlots {
+    int8_t index[ALPACA_METHOD_SLOTS];
+};
 
-    int clientID = request->hasParam("ClientID") ? request->getParam("ClientID")->value().toInt() : 0;
-    int clientTransactionID = request->hasParam("ClientTransactionID") ? request->getParam("ClientTransactionID")->value().toInt() : 0;
+static constexpr uint32_t ALPACA_METHOD_SEED = findMethodSeed();
+static_assert(ALPACA_METHOD_SEED != UINT32_MAX, "no perfect hash seed for the Alpaca method names");
 
-    doc["ClientID"] = clientID;
-    doc["ClientTransactionID"] = clientTransactionID;
-    doc["ServerTransactionID"] = serverTransactionID;
-    doc["ErrorNumber"] = error;
+static constexpr AlpacaMethodSlots buildMethodSlots() {
+    AlpacaMethodSlots t = {};
+    for (size_t i = 0; i < ALPACA_METHOD_SLOTS; i++) t.index[i] = -1;
+    for (size_t i = 0; i < ALPACA_METHOD_COUNT; i++) {
+        t.index[methodHash(alpacaMethods[i].name, ALPACA_METHOD_SEED)] = (int8_t)i;
+    }
+    return t;
+}
 
-    String response;
-    serializeJson(doc, response);
-    Serial.println("ALPACA Response: " + response);
+static constexpr AlpacaMethodSlots methodSlots = buildMethodSlots();
 
-    request->send(200, "application/json", response);
+static const AlpacaMethod *findMethod(const char *name) {
+    int8_t i = methodSlots.index[methodHash(name, ALPACA_METHOD_SEED)];
+    if (i < 0 || strcmp(alpacaMethods[i].name, name) != 0) return nullptr;
+    return &alpacaMethods[i];
 }
 
 // ============================================================================
-// UDP DISCOVERY
+// REQUEST STATISTICS
 // ============================================================================
 
-void handleDiscovery() {
-    // Only handle discovery if WiFi is connected in STA mode
-    if(WiFi.status() != WL_CONNECTED) {
-        udpInitialized = false;
-        return;
+static AlpacaRequestStats requestStats;
+
+// Per-endpoint handler time: the device methods in alpacaMethods order, then
+// the management endpoints and requests that matched no method
+enum AlpacaEndpoint {
+    ENDPOINT_DESCRIPTION = ALPACA_METHOD_COUNT,
+    ENDPOINT_API_VERSIONS,
+    ENDPOINT_CONFIGURED_DEVICES,
+    ENDPOINT_INVALID,
+    ENDPOINT_COUNT
+};
+static const char *const managementEndpointNames[] = {
+    "management/description", "management/apiversions", "management/configureddevices", "invalid",
+};
+static_assert(sizeof(managementEndpointNames) / sizeof(managementEndpointNames[0]) == ENDPOINT_COUNT - ALPACA_METHOD_COUNT,
+              "managementEndpointNames");
+static LatencyHistogram endpointLatency[ENDPOINT_COUNT];
+static int currentEndpoint = ENDPOINT_INVALID;   // the dispatcher sets the method (async_tcp task only)
+
+// Handler CPU time and heap still held when it returns (response object, copies)
+template<typename Handler>
+static void timedRequest(AsyncWebServerRequest *request, Handler handler, int endpoint) {
+    size_t heapBefore = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    int64_t start = esp_timer_get_time();
+    currentEndpoint = endpoint;
+    handler(request);
+    uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start);
+    bootAlpacaResponded();
+    int32_t heapUsed = (int32_t)heapBefore - (int32_t)heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    histogramObserve(endpointLatency[currentEndpoint], elapsed);
+
+    requestStats.requests++;
+    requestStats.totalUs += elapsed;
+    if(elapsed > requestStats.maxUs) requestStats.maxUs = elapsed;
+    requestStats.heapBytes += heapUsed;
+    if(elapsed > ALPACA_HANDLER_BUDGET_US) {
+        requestStats.overBudget++;
+        LOG_D(LOG_TAG_ALPACA, "Handler over budget: %lu us", (unsigned long)elapsed);
     }
-    
-    // Initialize UDP if not already done
-    if(!udpInitialized) {
-        udp.beginMulticast(multicastAddress, udpPort);
-        udpInitialized = true;
-        Serial.println("UDP Discovery initialized after WiFi connect");
+}
+
+AlpacaRequestStats getAlpacaRequestStats() {
+    AlpacaRequestStats result = requestStats;
+    result.minFreeHeap = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    return result;
+}
+
+void resetAlpacaRequestStats() {
+    requestStats = AlpacaRequestStats();
+    resetAlpacaResponseStats();
+}
+
+int getAlpacaEndpointCount() {
+    return ENDPOINT_COUNT;
+}
+
+const char *getAlpacaEndpointName(int endpoint) {
+    if(endpoint < 0 || endpoint >= ENDPOINT_COUNT) return "";
+    return endpoint < (int)ALPACA_METHOD_COUNT ? alpacaMethods[endpoint].name
+                                               : managementEndpointNames[endpoint - ALPACA_METHOD_COUNT];
+}
+
+LatencyHistogram getAlpacaEndpointLatency(int endpoint) {
+    if(endpoint < 0 || endpoint >= ENDPOINT_COUNT) return LatencyHistogram();
+    return endpointLatency[endpoint];
+}
+
+static void sendEmpty(AsyncWebServerRequest *request, int error = ALPACA_OK, const char *message = "");
+
+// Alpaca: unknown device type, device number or method is HTTP 400 with a text message
+static void sendBadRequest(AsyncWebServerRequest *request, const char *message) {
+    LOG_D(LOG_TAG_ALPACA, "400 %s", message);
+    request->send(400, "text/plain", message);
+}
+
+static void dispatchDeviceRequest(AsyncWebServerRequest *request) {
+    const String &url = request->url();
+    const char *p = url.c_str() + strlen(ALPACA_API_PREFIX);
+
+    // {devicetype}/
+    size_t typeLen = strlen(ALPACA_DEVICE_TYPE);
+    if (strncmp(p, ALPACA_DEVICE_TYPE, typeLen) != 0 || p[typeLen] != '/') {
+        sendBadRequest(request, "Unsupported device type");
+        return;
     }
-    
-    int packetSize = udp.parsePacket();
-    if (packetSize) {
-        Serial.print("ALPACA Discovery packet received: size=");
-        Serial.println(packetSize);
-
-        int len = udp.read(packetBuffer, 255);
-        if (len > 0) {
-            packetBuffer[len] = 0;
-        }
+    p += typeLen + 1;
 
-        // Check for valid discovery packet
-        if (len < 16 || strncmp("alpacadiscovery1", packetBuffer, 16) != 0) {
-            return;
-        }
+    // {n}/
+    if (*p < '0' || *p > '9') {
+        sendBadRequest(request, "Invalid device number");
+        return;
+    }
+    int dev = 0;
+    while (*p >= '0' && *p <= '9' && dev < 1000) {
+        dev = dev * 10 + (*p++ - '0');
+    }
+    // Before the scan the rotator count is unknown: any possible number is accepted
+    bool ready = isServoReady();
+    if (*p != '/' || dev >= (ready ? getRotatorCount() : MAX_ROTATORS)) {
+        sendBadRequest(request, "Invalid device number");
+        return;
+    }
 
-        char response[36] = {0};
-        sprintf(response, "{\"AlpacaPort\": %d}", alpacaPortGlobal);
+    // {method}
+    const AlpacaMethod *method = findMethod(p + 1);
+    if (!method) {
+        sendBadRequest(request, "Unknown method");
+        return;
+    }
+    currentEndpoint = method - alpacaMethods;
+    AlpacaDeviceHandler handler = request->method() == HTTP_GET ? method->get
+                                : request->method() == HTTP_PUT ? method->put : nullptr;
+    if (!handler) {
+        request->send(405, "text/plain", "Method not allowed");
+        return;
+    }
+    if (!ready && !method->early) {
+        sendEmpty(request, ALPACA_ERROR_NOT_CONNECTED, "Rotator initializing");
+        return;
+    }
+    handler(request, dev);
+}
 
-        udp.beginPacket(udp.remoteIP(), udp.remotePort());
-        udp.write((uint8_t *)response, strlen(response));
-        udp.endPacket();
+class AlpacaApiHandler : public AsyncWebHandler {
+public:
+    bool canHandle(AsyncWebServerRequest *request) override {
+        return strncmp(request->url().c_str(), ALPACA_API_PREFIX, strlen(ALPACA_API_PREFIX)) == 0;
+    }
 
-        Serial.println("ALPACA Discovery response sent");
+    void handleRequest(AsyncWebServerRequest *request) override {
+        timedRequest(request, dispatchDeviceRequest, ENDPOINT_INVALID);
     }
+
+    // PUT parameters arrive as form body
+    bool isRequestHandlerTrivial() override { return false; }
+};
+
+void setupAlpacaEndpoints(AsyncWebServer &server) {
+    // Device API first: checked before the setup page handlers
+    server.addHandler(new AlpacaApiHandler());
+
+    // ASCOM Alpaca Management Endpoints
+    server.on("/management/v1/description", HTTP_GET, [](AsyncWebServerRequest *request) {
+        timedRequest(request, handleDescription, ENDPOINT_DESCRIPTION);
+    });
+    server.on("/management/apiversions", HTTP_GET, [](AsyncWebServerRequest *request) {
+        timedRequest(request, handleApiVersion, ENDPOINT_API_VERSIONS);
+    });
+    server.on("/management/v1/configureddevices", HTTP_GET, [](AsyncWebServerRequest *request) {
+        timedRequest(request, handleConfiguredDevices, ENDPOINT_CONFIGURED_DEVICES);
+    });
 }
 
 // ============================================================================
@@ -144,241 +331,374 @@ void handleDiscovery() {
 // ============================================================================
 
 void handleDescription(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    JsonObject value = doc["Value"].to<JsonObject>();
-    value["Manufacturer"] = "MoMa";
-    value["ManufacturerVersion"] = "1.0";
-    value["ServerName"] = "MoMa Rotator";
-    sendJSONResponse(request, doc, 0);
+    AlpacaResponse *response = AlpacaResponse::begin(request);
+    JsonWriter &json = response->json();
+    json.key("Value").beginObject();
+    json.key("Manufacturer").string("MoMa");
+    json.key("ManufacturerVersion").string("1.0");
+    json.key("ServerName").string("MoMa Rotator");
+    json.endObject();
+    response->send();
 }
 
 void handleApiVersion(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    JsonArray versions = doc["Value"].to<JsonArray>();
-    versions.add(1);
-    sendJSONResponse(request, doc, 0);
+    AlpacaResponse *response = AlpacaResponse::begin(request);
+    response->json().key("Value").beginArray().integer(1).endArray();
+    response->send();
 }
 
 void handleConfiguredDevices(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    JsonArray value = doc["Value"].to<JsonArray>();
-
-    JsonObject device = value.add<JsonObject>();
-    device["DeviceName"] = "Rotator";
-    device["DeviceType"] = "Rotator";
-    device["DeviceNumber"] = 0;
-    device["UniqueID"] = "6109ff28-84d0-4f79-aa90-05ef3c191f50";
+    AlpacaResponse *response = AlpacaResponse::begin(request);
+    JsonWriter &json = response->json();
+    json.key("Value").beginArray();
+
+    for (int dev = 0; dev < getRotatorCount(); dev++) {
+        char name[20];       // "Rotator " and any int
+        char uniqueID[40];
+        if (dev == 0) {
+            snprintf(name, sizeof(name), "Rotator");
+        } else {
+            snprintf(name, sizeof(name), "Rotator %d", dev);
+        }
+        snprintf(uniqueID, sizeof(uniqueID), "6109ff28-84d0-4f79-aa90-05ef3c191f%02x",
+                 (unsigned)(uint8_t)(0x50 + dev));
+
+        json.beginObject();
+        json.key("DeviceName").string(name);
+        json.key("DeviceType").string("Rotator");
+        json.key("DeviceNumber").integer(dev);
+        json.key("UniqueID").string(uniqueID);
+        json.endObject();
+    }
+    json.endArray();
 
-    sendJSONResponse(request, doc, 0);
+    response->send();
 }
 
 // ============================================================================
 // COMMON DEVICE ENDPOINTS
 // ============================================================================
 
-void handleGetConnected(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = isConnected;
-    sendJSONResponse(request, doc, 0);
+static void sendBool(AsyncWebServerRequest *request, bool value) {
+    AlpacaResponse *response = AlpacaResponse::begin(request);
+    response->json().key("Value").boolean(value);
+    response->send();
+}
+
+static void sendString(AsyncWebServerRequest *request, const char *value) {
+    AlpacaResponse *response = AlpacaResponse::begin(request);
+    response->json().key("Value").string(value);
+    response->send();
+}
+
+static void sendAngle(AsyncWebServerRequest *request, double value) {
+    AlpacaResponse *response = AlpacaResponse::begin(request);
+    response->json().key("Value").number(value);
+    response->send();
 }
 
-void handleSetConnected(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    if (!request->hasArg("Connected")) {
-        sendJSONResponse(request, doc, 1025);
+static void sendEmpty(AsyncWebServerRequest *request, int error, const char *message) {
+    AlpacaResponse::begin(request)->send(error, message);
+}
+
+// Alpaca booleans are case-insensitive "true"/"false"
+static bool paramIsTrue(AsyncWebServerRequest *request, const char *name) {
+    return strcasecmp(alpacaParam(request, name), "true") == 0;
+}
+
+// Connect is asynchronous: Connecting stays true until the servo boot stage is done
+void handleGetConnected(AsyncWebServerRequest *request, int dev) {
+    sendBool(request, isConnected[dev] && isServoReady());
+}
+
+void handleSetConnected(AsyncWebServerRequest *request, int dev) {
+    if (!alpacaHasParam(request, "Connected")) {
+        sendEmpty(request, ALPACA_ERROR_INVALID_VALUE, "Missing Connected");
         return;
     }
-    isConnected = request->arg("Connected").equalsIgnoreCase("true");
-    doc["Value"] = isConnected;
-    sendJSONResponse(request, doc, 0);
+    isConnected[dev] = paramIsTrue(request, "Connected");
+    sendBool(request, isConnected[dev]);
 }
 
-void handleConnect(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    isConnected = true;
-    sendJSONResponse(request, doc, 0);
+void handleConnect(AsyncWebServerRequest *request, int dev) {
+    isConnected[dev] = true;
+    sendEmpty(request);
 }
 
-void handleDisconnect(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    isConnected = false;
-    sendJSONResponse(request, doc, 0);
+void handleDisconnect(AsyncWebServerRequest *request, int dev) {
+    isConnected[dev] = false;
+    sendEmpty(request);
 }
 
-void handleGetConnecting(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = false;
-    sendJSONResponse(request, doc, 0);
+void handleGetConnecting(AsyncWebServerRequest *request, int dev) {
+    sendBool(request, isConnected[dev] && !isServoReady());
 }
 
-void handleDeviceState(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    JsonArray value = doc["Value"].to<JsonArray>();
-    sendJSONResponse(request, doc, 0);
+// One {"Name":..., "Value":...} entry of the DeviceState list; the caller writes the value
+static JsonWriter &beginStateValue(JsonWriter &json, const char *name) {
+    return json.beginObject().key("Name").string(name).key("Value");
+}
+
+void handleDeviceState(AsyncWebServerRequest *request, int dev) {
+    RotatorSnapshot s;
+    getRotatorSnapshot(dev, s);
+    double position = stepsToDegrees(s.steps, s.stepsPerRev);
+
+    AlpacaResponse *response = AlpacaResponse::begin(request);
+    JsonWriter &json = response->json();
+    json.key("Value").beginArray();
+    beginStateValue(json, "IsMoving").boolean(s.moving).endObject();
+    beginStateValue(json, "MechanicalPosition").number(position).endObject();
+    beginStateValue(json, "Position").number(position).endObject();
+    beginStateValue(json, "TargetPosition").number(stepsToDegrees(s.targetSteps, s.stepsPerRev)).endObject();
+
+    // UTC time of the read, only once SNTP has set the clock
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    int64_t readUs = (int64_t)now.tv_sec * 1000000 + now.tv_usec - (esp_timer_get_time() - s.timeUs);
+    if(readUs > TIME_VALID_AFTER * 1000000LL) {
+        time_t seconds = (time_t)(readUs / 1000000);
+        struct tm utc;
+        gmtime_r(&seconds, &utc);
+        char stamp[32];
+        size_t n = strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", &utc);
+        snprintf(stamp + n, sizeof(stamp) - n, ".%03dZ", (int)(readUs / 1000 % 1000));
+        beginStateValue(json, "TimeStamp").string(stamp).endObject();
+    }
+    json.endArray();
+    response->send();
 }
 
-void handleGetDescription(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    int id = request->arg("Id").toInt();
-    if (id != 0) {
-        sendJSONResponse(request, doc, 1025);
+void handleGetDescription(AsyncWebServerRequest *request, int dev) {
+    if (atoi(alpacaParam(request, "Id")) != 0) {
+        sendEmpty(request, ALPACA_ERROR_INVALID_VALUE, "Invalid Id");
         return;
     }
-    doc["Value"] = String("MoMa Rotator");
-    sendJSONResponse(request, doc, 0);
+    sendString(request, "MoMa Rotator");
 }
 
-void handleDriverInfo(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = "MoMa DIY Rotator";
-    sendJSONResponse(request, doc, 0);
+void handleDriverInfo(AsyncWebServerRequest *request, int dev) {
+    sendString(request, "MoMa DIY Rotator");
 }
 
-void handleDriverVersion(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = "1.0";
-    sendJSONResponse(request, doc, 0);
+void handleDriverVersion(AsyncWebServerRequest *request, int dev) {
+    sendString(request, "1.0");
 }
 
-void handleGetInterfaceVersion(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = 3;
-    sendJSONResponse(request, doc, 0);
+void handleGetInterfaceVersion(AsyncWebServerRequest *request, int dev) {
+    AlpacaResponse *response = AlpacaResponse::begin(request);
+    response->json().key("Value").integer(3);
+    response->send();
 }
 
-void handleGetName(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    int id = request->arg("Id").toInt();
-    if (id != 0) {
-        sendJSONResponse(request, doc, 1025);
+void handleGetName(AsyncWebServerRequest *request, int dev) {
+    if (atoi(alpacaParam(request, "Id")) != 0) {
+        sendEmpty(request, ALPACA_ERROR_INVALID_VALUE, "Invalid Id");
         return;
     }
-    doc["Value"] = deviceName;
-    sendJSONResponse(request, doc, 0);
+    sendString(request, deviceName);
+}
+
+// Device-specific actions (see move_sequence.h); names are case-insensitive
+static const char *const supportedActions[] = {"RunSequence", "SequenceStatus", "AbortSequence"};
+
+void handleSupportedActions(AsyncWebServerRequest *request, int dev) {
+    AlpacaResponse *response = AlpacaResponse::begin(request);
+    JsonWriter &json = response->json();
+    json.key("Value").beginArray();
+    for (const char *name : supportedActions) {
+        json.string(name);
+    }
+    json.endArray();
+    response->send();
 }
 
-void handleSupportedActions(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    JsonArray actions = doc["Value"].to<JsonArray>();
-    sendJSONResponse(request, doc, 0);
+// RunSequence: Parameters "angle,dwellMs[,speed];..." (degrees, ms, servo speed 0 = current)
+static void runSequenceAction(AsyncWebServerRequest *request, int dev) {
+    SequenceStep steps[SEQUENCE_MAX_STEPS];
+    int count = 0;
+    const char *error = "";
+    if (!parseSequence(alpacaParam(request, "Parameters"), getStepsPerRev(dev), steps, count, error)) {
+        sendEmpty(request, ALPACA_ERROR_INVALID_VALUE, error);
+        return;
+    }
+    if (!startSequence(dev, steps, count)) {
+        sendEmpty(request, ALPACA_ERROR_INVALID_OPERATION, "Sequence already running");
+        return;
+    }
+    char value[16];
+    snprintf(value, sizeof(value), "%d", count);
+    sendString(request, value);
+}
+
+// SequenceStatus: Value is a JSON object as string (Alpaca actions return strings)
+static void sequenceStatusAction(AsyncWebServerRequest *request, int dev) {
+    SequenceStatus s = getSequenceStatus(dev);
+    char value[256];
+    JsonWriter json(value, sizeof(value));
+    json.beginObject();
+    json.key("state").string(sequenceStateName(s.state));
+    json.key("step").integer(s.step);
+    json.key("steps").integer(s.steps);
+    json.key("elapsedMs").integer(s.elapsedMs);
+    json.key("dwellRemainingMs").integer(s.dwellRemainingMs);
+    json.key("jitterUs").beginObject();
+    json.key("count").integer(s.jitterCount);
+    json.key("last").integer(s.jitterLastUs);
+    json.key("mean").integer(s.jitterMeanUs);
+    json.key("max").integer(s.jitterMaxUs);
+    json.endObject();
+    json.key("timerLateUs").beginObject();
+    json.key("last").integer(s.timerLateLastUs);
+    json.key("mean").integer(s.timerLateMeanUs);
+    json.key("max").integer(s.timerLateMaxUs);
+    json.endObject().endObject();
+    sendString(request, value);
+}
+
+void handleAction(AsyncWebServerRequest *request, int dev) {
+    const char *action = alpacaParam(request, "Action");
+    if (strcasecmp(action, "RunSequence") == 0) {
+        runSequenceAction(request, dev);
+    } else if (strcasecmp(action, "SequenceStatus") == 0) {
+        sequenceStatusAction(request, dev);
+    } else if (strcasecmp(action, "AbortSequence") == 0) {
+        abortSequence(dev);
+        sendString(request, "");
+    } else {
+        sendEmpty(request, ALPACA_ERROR_ACTION_NOT_IMPLEMENTED, "Action not implemented");
+    }
 }
 
 // ============================================================================
 // ROTATOR SPECIFIC ENDPOINTS
 // ============================================================================
 
-void handleCanReverse(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = true;
-    sendJSONResponse(request, doc, 0);
+void handleCanReverse(AsyncWebServerRequest *request, int dev) {
+    sendBool(request, true);
 }
 
-void handleIsMoving(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = isServoMoving();
-    sendJSONResponse(request, doc, 0);
+void handleIsMoving(AsyncWebServerRequest *request, int dev) {
+    sendBool(request, isServoMoving(dev));
 }
 
-void handleMechanicalPosition(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = getServoAngle();
-    sendJSONResponse(request, doc, 0);
+// Getters answer from the bus task's polled state: no bus lock, no transaction
+// on async_tcp, so their time does not depend on a move or EEPROM write in progress
+void handleMechanicalPosition(AsyncWebServerRequest *request, int dev) {
+    sendAngle(request, stepsToDegrees(getLastServoSteps(dev), getStepsPerRev(dev)));
 }
 
-void handlePosition(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = getServoAngle();
-    sendJSONResponse(request, doc, 0);
+void handlePosition(AsyncWebServerRequest *request, int dev) {
+    sendAngle(request, stepsToDegrees(getLastServoSteps(dev), getStepsPerRev(dev)));
 }
 
-void handleGetReverse(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = reverseState;
-    sendJSONResponse(request, doc, 0);
+void handleGetReverse(AsyncWebServerRequest *request, int dev) {
+    sendBool(request, getReverseDirection(dev));
 }
 
-void handleSetReverse(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    String reverseStr = request->arg("Reverse");
-    reverseState = (reverseStr == "true");
-    sendJSONResponse(request, doc, 0);
+void handleSetReverse(AsyncWebServerRequest *request, int dev) {
+    setReverseDirection(dev, paramIsTrue(request, "Reverse"));
+    sendEmpty(request);
 }
 
-void handleStepSize(AsyncWebServerRequest *request) {
-    JsonDocument doc;
+void handleStepSize(AsyncWebServerRequest *request, int dev) {
     // Step size in degrees: 4096 steps for 360° motor / 2 (gear ratio) = 0.0439° per step on gear
-    doc["Value"] = (360.0 / 4096.0) / 2.0;
-    sendJSONResponse(request, doc, 0);
+    AlpacaResponse *response = AlpacaResponse::begin(request);
+    response->json().key("Value").number(360.0 / getStepsPerRev(dev), 9);
+    response->send();
+}
+
+void handleTargetPosition(AsyncWebServerRequest *request, int dev) {
+    RotatorSnapshot s;
+    getRotatorSnapshot(dev, s);
+    sendAngle(request, stepsToDegrees(s.targetSteps, s.stepsPerRev));
+}
+
+// Motion handlers only validate and queue: the bus task reads feedback and moves.
+// While a sequence runs it owns the rotator: Halt aborts it, moves are refused.
+// Moves are refused while a sequence owns the rotator or the servo does not answer
+// (the position would be the last known one and the move would be dropped)
+const char *moveRefusal(int dev, int *error) {
+    int code = ALPACA_OK;
+    const char *reason = nullptr;
+    if (!isServoReady() || dev < 0 || dev >= getRotatorCount()) {
+        code = ALPACA_ERROR_NOT_CONNECTED;
+        reason = "Rotator initializing";
+    } else if (isFeedbackStale(dev)) {
+        code = ALPACA_ERROR_NOT_CONNECTED;
+        reason = "Rotator not responding";
+    } else if (isSequenceRunning(dev)) {
+        code = ALPACA_ERROR_INVALID_OPERATION;
+        reason = "Sequence running";
+    }
+    if (error) *error = code;
+    return reason;
 }
 
-void handleTargetPosition(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["Value"] = getServoAngle();
-    sendJSONResponse(request, doc, 0);
+static bool rejectMove(AsyncWebServerRequest *request, int dev) {
+    int error;
+    const char *reason = moveRefusal(dev, &error);
+    if (!reason) return false;
+    sendEmpty(request, error, reason);
+    return true;
 }
 
-void handleHalt(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    stopServo();
-    sendJSONResponse(request, doc, 0);
+void handleHalt(AsyncWebServerRequest *request, int dev) {
+    abortSequence(dev);
+    requestHalt(dev);
+    sendEmpty(request);
 }
 
-void handleMove(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    double value = request->arg("Position").toDouble();
-    double currentAngle = getServoAngle();
+void handleMove(AsyncWebServerRequest *request, int dev) {
+    if (rejectMove(request, dev)) return;
+    double value = atof(alpacaParam(request, "Position"));
+    double currentAngle = stepsToDegrees(getLastServoSteps(dev), getStepsPerRev(dev));
     double newPosition = currentAngle + value;
 
     // Validate range
     if (newPosition < 0.0 || newPosition > 359.99) {
-        sendJSONResponse(request, doc, 1025);
+        sendEmpty(request, ALPACA_ERROR_INVALID_VALUE, "Position out of range");
     } else {
-        sendJSONResponse(request, doc, 0);
-        moveServoByAngle(value);
+        requestMoveBy(dev, degreesToSteps(value, getStepsPerRev(dev)));
+        sendEmpty(request);
     }
 }
 
-void handleMoveAbsolute(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    double value = request->arg("Position").toDouble();
+void handleMoveAbsolute(AsyncWebServerRequest *request, int dev) {
+    if (rejectMove(request, dev)) return;
+    double value = atof(alpacaParam(request, "Position"));
 
     if (value < 0.0 || value > 359.99) {
-        sendJSONResponse(request, doc, 1025);
+        sendEmpty(request, ALPACA_ERROR_INVALID_VALUE, "Position out of range");
     } else {
-        sendJSONResponse(request, doc, 0);
-        moveServoToAngle(value);
+        requestMoveTo(dev, degreesToSteps(value, getStepsPerRev(dev)));
+        sendEmpty(request);
     }
 }
 
-void handleMoveMechanical(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    double value = request->arg("Position").toDouble();
-    
+void handleMoveMechanical(AsyncWebServerRequest *request, int dev) {
+    if (rejectMove(request, dev)) return;
+    double value = atof(alpacaParam(request, "Position"));
+
     if (value < 0.0 || value > 359.99) {
-        sendJSONResponse(request, doc, 1025);
+        sendEmpty(request, ALPACA_ERROR_INVALID_VALUE, "Position out of range");
     } else {
-        sendJSONResponse(request, doc, 0);
-        moveServoToAngle(value);
+        requestMoveTo(dev, degreesToSteps(value, getStepsPerRev(dev)));
+        sendEmpty(request);
     }
 }
 
-void handleSync(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    double value = request->arg("Position").toDouble();
-    
+void handleSync(AsyncWebServerRequest *request, int dev) {
+    double value = atof(alpacaParam(request, "Position"));
+
     // Sync: Set virtual position to specified angle without moving motor
-    // Convert gear angle to motor steps
-    double motorDegrees = value * GEAR_RATIO;  // GEAR_RATIO = 2.0
-    int targetSteps = (int)((motorDegrees / 360.0) * 4096.0);
-    
+    // Convert gear angle to steps (JSON boundary)
+    int32_t targetSteps = degreesToSteps(value, getStepsPerRev(dev));
+
     // Update current position to synced value
-    setCurrentTargetPosition(targetSteps);
-    
-    Serial.print("Synced to ");
-    Serial.print(value);
-    Serial.print("° (steps: ");
-    Serial.print(targetSteps);
-    Serial.println(")");
-    
-    sendJSONResponse(request, doc, 0);
+    setCurrentTargetPosition(dev, targetSteps);
+
+    LOG_I(LOG_TAG_ALPACA, "Rotator %d synced to %.2f° (steps: %ld)", dev, value, (long)targetSteps);
+
+    sendEmpty(request);
 }
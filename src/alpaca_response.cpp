@@ -0,0 +1,154 @@
+#include "alpaca_response.h"
+#include "event_log.h"
+#include <new>
+#include <utility>
+
+// Response pool: fixed slots, a slot is released when the server deletes the response
+static uint8_t pool[ALPACA_RESPONSE_POOL][sizeof(AlpacaResponse)] __attribute__((aligned(8)));
+static bool poolUsed[ALPACA_RESPONSE_POOL];
+// Content type per slot, handed to the response and taken back: "application/json"
+// does not fit the String inline buffer, so it is allocated once per slot, not per response
+static String poolContentType[ALPACA_RESPONSE_POOL];
+static portMUX_TYPE poolMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t serverTransactionID = 0;
+static AlpacaResponseStats stats;
+
+// ============================================================================
+// POOL
+// ============================================================================
+
+void *AlpacaResponse::operator new(size_t size) {
+    portENTER_CRITICAL(&poolMux);
+    for(int i = 0; i < ALPACA_RESPONSE_POOL; i++) {
+        if(!poolUsed[i]) {
+            poolUsed[i] = true;
+            portEXIT_CRITICAL(&poolMux);
+            return pool[i];
+        }
+    }
+    stats.poolMisses++;
+    portEXIT_CRITICAL(&poolMux);
+    return ::operator new(size);
+}
+
+// Slot of a response object, -1 when it came from the heap
+static int poolSlot(const void *ptr) {
+    const uint8_t *p = static_cast<const uint8_t *>(ptr);
+    if(p < pool[0] || p >= pool[0] + sizeof(pool)) return -1;
+    return (p - pool[0]) / sizeof(AlpacaResponse);
+}
+
+void AlpacaResponse::operator delete(void *ptr) {
+    int slot = poolSlot(ptr);
+    if(slot >= 0) {
+        portENTER_CRITICAL(&poolMux);
+        poolUsed[slot] = false;
+        portEXIT_CRITICAL(&poolMux);
+        return;
+    }
+    ::operator delete(ptr);
+}
+
+// ============================================================================
+// PARAMETERS
+// ============================================================================
+
+static const AsyncWebParameter *findParam(AsyncWebServerRequest *request, const char *name) {
+    size_t count = request->params();
+    for(size_t i = 0; i < count; i++) {
+        const AsyncWebParameter *p = request->getParam(i);
+        if(strcasecmp(p->name().c_str(), name) == 0) return p;
+    }
+    return nullptr;
+}
+
+const char *alpacaParam(AsyncWebServerRequest *request, const char *name) {
+    const AsyncWebParameter *p = findParam(request, name);
+    return p ? p->value().c_str() : "";
+}
+
+bool alpacaHasParam(AsyncWebServerRequest *request, const char *name) {
+    return findParam(request, name) != nullptr;
+}
+
+// ============================================================================
+// RESPONSE
+// ============================================================================
+
+AlpacaResponse::AlpacaResponse(AsyncWebServerRequest *request)
+    : request(request), writer(buffer, sizeof(buffer)) {
+    _code = 200;
+    int slot = poolSlot(this);
+    if(slot < 0) {
+        _contentType = "application/json";
+    } else {
+        if(poolContentType[slot] != "application/json") poolContentType[slot] = "application/json";
+        _contentType = std::move(poolContentType[slot]);
+    }
+
+    // Alpaca: missing or invalid client IDs are reported back as 0
+    clientID = strtoul(alpacaParam(request, "ClientID"), nullptr, 10);
+    clientTransactionID = strtoul(alpacaParam(request, "ClientTransactionID"), nullptr, 10);
+    writer.beginObject();
+}
+
+AlpacaResponse::~AlpacaResponse() {
+    int slot = poolSlot(this);
+    if(slot >= 0) poolContentType[slot] = std::move(_contentType);
+}
+
+AlpacaResponse *AlpacaResponse::begin(AsyncWebServerRequest *request) {
+    return new AlpacaResponse(request);
+}
+
+void AlpacaResponse::send(int error, const char *message) {
+    uint32_t transaction;
+    portENTER_CRITICAL(&poolMux);
+    transaction = ++serverTransactionID;
+    portEXIT_CRITICAL(&poolMux);
+
+    writer.key("ClientID").integer(clientID);
+    writer.key("ClientTransactionID").integer(clientTransactionID);
+    writer.key("ServerTransactionID").integer(transaction);
+    writer.key("ErrorNumber").integer(error);
+    writer.key("ErrorMessage").string(message);
+    writer.endObject();
+
+    if(writer.overflow()) {
+        // Never send truncated JSON: replace the body with a driver error
+        stats.overflows++;
+        writer.reset();
+        writer.beginObject();
+        writer.key("ClientID").integer(clientID);
+        writer.key("ClientTransactionID").integer(clientTransactionID);
+        writer.key("ServerTransactionID").integer(transaction);
+        writer.key("ErrorNumber").integer(ALPACA_ERROR_DRIVER);
+        writer.key("ErrorMessage").string("Response too large");
+        writer.endObject();
+    }
+
+    stats.responses++;
+    if(writer.length() > stats.maxLength) stats.maxLength = writer.length();
+    _contentLength = writer.length();
+
+    LOG_D(LOG_TAG_ALPACA, "Response %u: error %d, %u bytes", transaction, error, (unsigned)writer.length());
+
+    request->send(this);
+}
+
+size_t AlpacaResponse::_fillBuffer(uint8_t *data, size_t len) {
+    size_t left = writer.length() - sent;
+    if(len > left) len = left;
+    memcpy(data, buffer + sent, len);
+    sent += len;
+    return len;
+}
+
+AlpacaResponseStats getAlpacaResponseStats() {
+    return stats;
+}
+
+void resetAlpacaResponseStats() {
+    stats = AlpacaResponseStats();
+}
@@ -0,0 +1,43 @@
+#include "boot_status.h"
+#include "event_log.h"
+#include <esp_timer.h>
+
+static const char *stageNames[BOOT_STAGE_COUNT] = {"display", "servo", "network", "http"};
+static volatile uint32_t stageMs[BOOT_STAGE_COUNT];
+static volatile uint32_t firstResponseMs = 0;
+
+// Never 0 once done: 0 means "not yet"
+static uint32_t sinceBootMs() {
+    uint32_t ms = (uint32_t)(esp_timer_get_time() / 1000);
+    return ms ? ms : 1;
+}
+
+void bootStageDone(BootStage stage) {
+    if(stage >= BOOT_STAGE_COUNT || stageMs[stage]) return;
+    stageMs[stage] = sinceBootMs();
+    LOG_I(LOG_TAG_SYSTEM, "Boot: %s ready after %lu ms", stageNames[stage], (unsigned long)stageMs[stage]);
+}
+
+bool isBootStageDone(BootStage stage) {
+    return stage < BOOT_STAGE_COUNT && stageMs[stage] != 0;
+}
+
+uint32_t getBootStageMs(BootStage stage) {
+    return stage < BOOT_STAGE_COUNT ? stageMs[stage] : 0;
+}
+
+const char *getBootStageName(int stage) {
+    return stage >= 0 && stage < BOOT_STAGE_COUNT ? stageNames[stage] : "?";
+}
+
+// Requests are served by the async_tcp task only: no lock needed
+void bootAlpacaResponded() {
+    if(firstResponseMs) return;
+    firstResponseMs = sinceBootMs();
+    LOG_I(LOG_TAG_SYSTEM, "Boot: first Alpaca response after %lu ms (servo %lu ms, network %lu ms)",
+          (unsigned long)firstResponseMs, (unsigned long)stageMs[BOOT_SERVO], (unsigned long)stageMs[BOOT_NETWORK]);
+}
+
+uint32_t getFirstAlpacaResponseMs() {
+    return firstResponseMs;
+}
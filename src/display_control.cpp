@@ -1,15 +1,39 @@
 #include "display_control.h"
 #include "servo_control.h"
 #include "wifi_manager.h"
+#include "angle_math.h"
+#include "task_monitor.h"
+#include "profiler.h"
 #include <Wire.h>
+#include <freertos/queue.h>
 
-// Global display object
+#define DISPLAY_TASK_STACK 3072
+#define DISPLAY_TASK_PRIORITY 1         // below bus and sequence tasks
+#define DISPLAY_QUEUE_LENGTH 4
+#define DISPLAY_BUDGET_US 20000         // one 128x32 frame over I2C is ~12 ms at 400 kHz
+#define DISPLAY_LINE_LENGTH 22          // 21 characters at text size 1
+
+// Global display object (UI task only once it runs)
 static Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 
 // Display state
-static bool displayEnabled = true;
-static unsigned long lastUpdate = 0;
+static volatile bool displayEnabled = true;
 static const unsigned long UPDATE_INTERVAL = 300; // ms
+static const unsigned long ROTATOR_PAGE_INTERVAL = 3000; // ms per rotator page
+static const unsigned long MESSAGE_HOLD = 2000; // ms a message stays before motor info returns
+
+// Requests from other tasks, drawn by the UI task
+enum DisplayCommandType : uint8_t { DISPLAY_CMD_ON, DISPLAY_CMD_OFF, DISPLAY_CMD_MESSAGE };
+
+struct DisplayCommand {
+    DisplayCommandType type;
+    uint8_t lines;                                  // bit per line present
+    char text[4][DISPLAY_LINE_LENGTH];
+};
+
+static QueueHandle_t commands = nullptr;
+static TaskHandle_t uiTask = nullptr;
+static int64_t holdUntilUs = 0;                     // UI task only
 
 // ============================================================================
 // INITIALIZATION
@@ -33,71 +57,78 @@ void initDisplay() {
     display.display();
     displayEnabled = true;
     
-    // Show startup message
+    // Show startup message (held by the UI task while the other boot stages run)
     displayMessage("MoMa Rotator", "Initializing...");
-    delay(1000);
 }
 
 // ============================================================================
-// DISPLAY CONTROL
+// DRAWING (UI task, or the setup task before the UI task starts)
 // ============================================================================
 
-void displayOn() {
-    displayEnabled = true;
+static void drawOn() {
     display.ssd1306_command(SSD1306_DISPLAYON);
 }
 
-void displayOff() {
-    displayEnabled = false;
+static void drawOff() {
     display.clearDisplay();
     display.display();
     display.ssd1306_command(SSD1306_DISPLAYOFF);
 }
 
-bool isDisplayEnabled() {
-    return displayEnabled;
-}
-
-// ============================================================================
-// DISPLAY UPDATE
-// ============================================================================
-
-void updateDisplay() {
+static void drawMessage(const DisplayCommand &cmd) {
     if (!displayEnabled) return;
     
-    // Throttle updates
-    unsigned long now = millis();
-    if (now - lastUpdate < UPDATE_INTERVAL) {
-        return;
+    display.clearDisplay();
+    display.setTextSize(1);
+    display.setTextColor(SSD1306_WHITE);
+    display.setCursor(0, 0);
+    
+    for (int i = 0; i < 4; i++) {
+        if (cmd.lines & (1 << i)) display.println(cmd.text[i]);
     }
-    lastUpdate = now;
     
-    displayMotorInfo();
+    display.display();
 }
 
-int getMotorID();  // Forward declaration
-
-void displayMotorInfo() {
+// Motor info from the polled state: the UI never waits for the servo bus
+static void drawMotorInfo() {
     if (!displayEnabled) return;
     
+    // Still scanning: the boot message stays
+    if (getRotatorCount() == 0) return;
+
+    // With several rotators on the bus, page through them
+    int dev = (millis() / ROTATOR_PAGE_INTERVAL) % getRotatorCount();
+    
     display.clearDisplay();
     display.setTextSize(1);
     display.setTextColor(SSD1306_WHITE);
     display.setCursor(0, 0);
     
     // Line 1: Title
-    display.println(F("MoMa Rotator"));
+    display.print(F("MoMa Rotator"));
+    if (getRotatorCount() > 1) {
+        display.print(F(" #"));
+        display.print(dev);
+    }
+    display.println();
     
     // Line 2: Motor ID & Mode
     display.print(F("ID:"));
-    display.print(getMotorID());  // Get actual motor ID
-    display.print(F(" Mode:"));
-    display.println(getServoMode());
+    display.print(getMotorID(dev));  // Get actual motor ID
+    if (isFeedbackStale(dev)) {
+        display.println(F(" NO REPLY"));  // position below is the last known one
+    } else {
+        display.print(F(" Mode:"));
+        display.println(getServoMode(dev));
+    }
     
-    // Line 3: Position
+    // Line 3: Position (rounded to 0.1 deg, 360.0 wraps to 0.0)
     display.print(F("Pos: "));
-    double pos = getServoAngle();
-    display.print(pos, 1);
+    int32_t tenths = (stepsToMilliDegrees(getLastServoSteps(dev), getStepsPerRev(dev)) + 50) / 100 % 3600;
+    display.print(tenths / 10);
+    display.print('.');
+    display.print(tenths % 10);
     display.println(F(" deg"));
     
     // Line 4: IP Address
@@ -107,30 +138,149 @@ void displayMotorInfo() {
     display.display();
 }
 
-void displayMotorScan() {
+// Profiler page: the three stages with the highest maximum, average and maximum in µs
+static void drawProfile() {
     if (!displayEnabled) return;
     
+    ProfileStageStats stats[STAGE_COUNT];
+    int order[STAGE_COUNT];
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        stats[s] = getProfileStageStats(s);
+        order[s] = s;
+    }
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        for (int j = i + 1; j < STAGE_COUNT; j++) {
+            if (stats[order[j]].maxCycles > stats[order[i]].maxCycles) {
+                int t = order[i];
+                order[i] = order[j];
+                order[j] = t;
+            }
+        }
+    }
+    
     display.clearDisplay();
     display.setTextSize(1);
     display.setTextColor(SSD1306_WHITE);
     display.setCursor(0, 0);
-    display.println(F("Scanning for"));
-    display.println(F("motor..."));
+    
+    char line[DISPLAY_LINE_LENGTH];
+    snprintf(line, sizeof(line), "%-9s%5s %6s", "Stage us", "avg", "max");
+    display.println(line);
+    for (int i = 0; i < 3; i++) {
+        const ProfileStageStats &st = stats[order[i]];
+        snprintf(line, sizeof(line), "%-9.9s%5lu %6lu", getProfileStageName(order[i]),
+                 (unsigned long)profileCyclesToUs(st.avgCycles), (unsigned long)profileCyclesToUs(st.maxCycles));
+        display.println(line);
+    }
+    
     display.display();
 }
 
+static void applyCommand(const DisplayCommand &cmd) {
+    switch (cmd.type) {
+        case DISPLAY_CMD_ON:
+            drawOn();
+            break;
+        case DISPLAY_CMD_OFF:
+            drawOff();
+            break;
+        case DISPLAY_CMD_MESSAGE:
+            drawMessage(cmd);
+            holdUntilUs = esp_timer_get_time() + MESSAGE_HOLD * 1000LL;
+            break;
+    }
+}
+
+// ============================================================================
+// UI TASK
+// ============================================================================
+
+// Applies queued commands as they arrive and redraws the motor info (or the
+// profiler page) every UPDATE_INTERVAL unless a message is being held
+static void displayTask(void *param) {
+    int slot = taskMonitorAdd("ui", TASK_CORE_MOTION, DISPLAY_BUDGET_US, DISPLAY_TASK_STACK);
+    int64_t dueUs = esp_timer_get_time();
+    for (;;) {
+        int64_t waitUs = dueUs - esp_timer_get_time();
+        TickType_t wait = waitUs > 0 ? pdMS_TO_TICKS(waitUs / 1000) : 0;
+        DisplayCommand cmd;
+        if (xQueueReceive(commands, &cmd, wait) == pdTRUE) {
+            taskWorkBegin(slot);
+            applyCommand(cmd);
+            taskWorkEnd(slot);
+            continue;
+        }
+
+        taskWorkBegin(slot, dueUs);
+        int64_t now = esp_timer_get_time();
+        if (now >= holdUntilUs) {
+            ProfileFrame frame;
+            profileBegin(frame);
+            if (isProfileOnDisplay()) {
+                drawProfile();
+            } else {
+                drawMotorInfo();
+            }
+            profileMark(frame, STAGE_UI_DRAW);
+            profileEnd(frame, "ui");
+        }
+        taskWorkEnd(slot);
+
+        dueUs += UPDATE_INTERVAL * 1000LL;
+        if (dueUs < now) dueUs = now + UPDATE_INTERVAL * 1000LL;   // no catch-up burst after a stall
+    }
+}
+
+void startDisplayTask() {
+    if (uiTask) return;
+    commands = xQueueCreate(DISPLAY_QUEUE_LENGTH, sizeof(DisplayCommand));
+    xTaskCreatePinnedToCore(displayTask, "ui", DISPLAY_TASK_STACK, nullptr,
+                            DISPLAY_TASK_PRIORITY, &uiTask, TASK_CORE_MOTION);
+}
+
+// Queued for the UI task once it runs; drawn right away before that (setup).
+// A full queue drops the command: the next refresh redraws anyway.
+static void submit(const DisplayCommand &cmd) {
+    if (uiTask) {
+        xQueueSend(commands, &cmd, 0);
+    } else {
+        applyCommand(cmd);
+    }
+}
+
+// ============================================================================
+// DISPLAY CONTROL
+// ============================================================================
+
+void displayOn() {
+    displayEnabled = true;
+    DisplayCommand cmd = {DISPLAY_CMD_ON, 0, {}};
+    submit(cmd);
+}
+
+void displayOff() {
+    displayEnabled = false;
+    DisplayCommand cmd = {DISPLAY_CMD_OFF, 0, {}};
+    submit(cmd);
+}
+
+bool isDisplayEnabled() {
+    return displayEnabled;
+}
+
+void displayMotorScan() {
+    displayMessage("Scanning for", "motor...");
+}
+
 void displayMessage(const char* line1, const char* line2, const char* line3, const char* line4) {
     if (!displayEnabled) return;
     
-    display.clearDisplay();
-    display.setTextSize(1);
-    display.setTextColor(SSD1306_WHITE);
-    display.setCursor(0, 0);
-    
-    if (line1) display.println(line1);
-    if (line2) display.println(line2);
-    if (line3) display.println(line3);
-    if (line4) display.println(line4);
-    
-    display.display();
+    const char *lines[4] = {line1, line2, line3, line4};
+    DisplayCommand cmd = {DISPLAY_CMD_MESSAGE, 0, {}};
+    for (int i = 0; i < 4; i++) {
+        if (!lines[i]) continue;
+        cmd.lines |= 1 << i;
+        snprintf(cmd.text[i], DISPLAY_LINE_LENGTH, "%s", lines[i]);
+    }
+    submit(cmd);
 }
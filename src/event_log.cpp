@@ -0,0 +1,279 @@
+#include "event_log.h"
+#include "task_monitor.h"
+#include <atomic>
+#include <string.h>
+
+#define LOG_TASK_STACK 3072
+#define LOG_TASK_PRIORITY 1        // below the bus tasks and the web server
+#define LOG_TASK_BUDGET_US 20000   // Serial.write blocks once the UART buffer is full
+#define LOG_DRAIN_INTERVAL 10      // ms
+
+static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE must be a power of two");
+
+// Binary record. seq is the slot state of the bounded MPSC queue for position
+// pos (lap = pos / LOG_RING_SIZE): 2 * lap = free, 2 * lap + 1 = holds record pos.
+// Zero-initialized memory is a valid empty ring, so logging works before logInit().
+struct LogRecord {
+    std::atomic<uint32_t> seq;
+    uint32_t timeMs;
+    uint8_t level;
+    uint8_t tag;
+    uint8_t argc;
+    const char *fmt;
+    uintptr_t args[LOG_MAX_ARGS];
+};
+
+static LogRecord ring[LOG_RING_SIZE];
+
+static inline uint32_t slotFree(uint32_t pos) { return 2 * (pos / LOG_RING_SIZE); }
+static inline uint32_t slotFull(uint32_t pos) { return 2 * (pos / LOG_RING_SIZE) + 1; }
+static std::atomic<uint32_t> head(0);   // next producer position
+static uint32_t tail = 0;               // next consumer position (drain task only)
+
+static std::atomic<uint32_t> written(0);
+static std::atomic<uint32_t> dropped(0);
+static std::atomic<uint32_t> filtered(0);
+static uint32_t maxUsed = 0;
+
+static_assert(LOG_TAG_COUNT == 5, "update logRuntimeLevel and tagNames");
+uint8_t logRuntimeLevel[LOG_TAG_COUNT] = {LOG_LEVEL, LOG_LEVEL, LOG_LEVEL, LOG_LEVEL, LOG_LEVEL};
+
+static const char *const tagNames[LOG_TAG_COUNT] = {"system", "servo", "alpaca", "wifi", "display"};
+static const char levelLetters[] = "-EWID";
+static const char *const levelNames[] = {"none", "error", "warn", "info", "debug"};
+
+// Recent formatted output for GET /log (drain task writes, handler copies under lock)
+static char textBuffer[LOG_TEXT_BUFFER];
+static uint32_t textWritten = 0;        // total characters ever written
+static portMUX_TYPE textMux = portMUX_INITIALIZER_UNLOCKED;
+
+static TaskHandle_t drainTask = nullptr;
+
+// ============================================================================
+// PRODUCER
+// ============================================================================
+
+void logFiltered() {
+    filtered.fetch_add(1, std::memory_order_relaxed);
+}
+
+void logPush(uint8_t level, LogTag tag, const char *fmt, const uintptr_t *args, uint8_t argc) {
+    uint32_t pos = head.load(std::memory_order_relaxed);
+    LogRecord *rec;
+    for(;;) {
+        rec = &ring[pos & (LOG_RING_SIZE - 1)];
+        uint32_t seq = rec->seq.load(std::memory_order_acquire);
+        int32_t diff = (int32_t)(seq - slotFree(pos));
+        if(diff == 0) {
+            if(head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if(diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);  // Ring full
+            return;
+        } else {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    rec->timeMs = (uint32_t)(esp_timer_get_time() / 1000);
+    rec->level = level;
+    rec->tag = tag;
+    rec->argc = argc;
+    rec->fmt = fmt;
+    for(uint8_t i = 0; i < argc; i++) rec->args[i] = args[i];
+    rec->seq.store(slotFull(pos), std::memory_order_release);
+    written.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// DRAIN TASK
+// ============================================================================
+
+// printf with the stored argument words; the conversion decides how a word is read
+static size_t formatRecord(char *out, size_t size, const LogRecord &rec) {
+    size_t len = 0;
+    uint8_t arg = 0;
+    const char *p = rec.fmt;
+    auto emit = [&](int n) { if(n > 0) len += ((size_t)n < size - len) ? n : size - len - 1; };
+
+    while(*p && len < size - 1) {
+        if(*p != '%') {
+            out[len++] = *p++;
+            continue;
+        }
+        if(p[1] == '%') {
+            out[len++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Copy the conversion spec: flags, width, precision, length, conversion
+        char spec[16];
+        size_t n = 0;
+        spec[n++] = *p++;
+        while(*p && strchr("-+ #0123456789.lh", *p) && n < sizeof(spec) - 2) spec[n++] = *p++;
+        if(!*p) break;
+        char conv = *p++;
+        spec[n++] = conv;
+        spec[n] = '\0';
+
+        uintptr_t word = arg < rec.argc ? rec.args[arg] : 0;
+        arg++;
+        if(strchr("fFeEgG", conv)) {
+            float f;
+            uint32_t bits = (uint32_t)word;
+            memcpy(&f, &bits, sizeof(f));
+            emit(snprintf(out + len, size - len, spec, (double)f));
+        } else if(conv == 's') {
+            emit(snprintf(out + len, size - len, spec, word ? (const char *)word : "(null)"));
+        } else if(strchr(spec, 'l')) {
+            emit(snprintf(out + len, size - len, spec, (long)(intptr_t)word));
+        } else {
+            emit(snprintf(out + len, size - len, spec, (int)(intptr_t)word));
+        }
+    }
+    out[len] = '\0';
+    return len;
+}
+
+static void appendText(const char *line, size_t len) {
+    portENTER_CRITICAL(&textMux);
+    for(size_t i = 0; i < len; i++) {
+        textBuffer[textWritten++ % LOG_TEXT_BUFFER] = line[i];
+    }
+    portEXIT_CRITICAL(&textMux);
+}
+
+static void emitLine(const char *line, size_t len) {
+    Serial.write((const uint8_t *)line, len);  // Blocks this task only
+    appendText(line, len);
+}
+
+static void logDrainTask(void *param) {
+    char line[192];
+    uint32_t lastDropped = 0;
+    int slot = taskMonitorAdd("log", -1, LOG_TASK_BUDGET_US, LOG_TASK_STACK);
+    for(;;) {
+        taskWorkBegin(slot);
+        for(;;) {
+            LogRecord &rec = ring[tail & (LOG_RING_SIZE - 1)];
+            if(rec.seq.load(std::memory_order_acquire) != slotFull(tail)) break;
+
+            uint32_t used = head.load(std::memory_order_relaxed) - tail;
+            if(used > maxUsed) maxUsed = used;
+
+            int n = snprintf(line, sizeof(line), "[%6lu.%03lu] %c %s: ",
+                             (unsigned long)(rec.timeMs / 1000), (unsigned long)(rec.timeMs % 1000),
+                             levelLetters[rec.level < 5 ? rec.level : 0],
+                             rec.tag < LOG_TAG_COUNT ? tagNames[rec.tag] : "?");
+            size_t len = n + formatRecord(line + n, sizeof(line) - n - 2, rec);
+            line[len++] = '\r';
+            line[len++] = '\n';
+
+            rec.seq.store(slotFree(tail + LOG_RING_SIZE), std::memory_order_release);
+            tail++;
+            emitLine(line, len);
+        }
+
+        uint32_t d = dropped.load(std::memory_order_relaxed);
+        if(d != lastDropped) {
+            int n = snprintf(line, sizeof(line), "[log] %lu records dropped\r\n", (unsigned long)(d - lastDropped));
+            emitLine(line, n);
+            lastDropped = d;
+        }
+        taskWorkEnd(slot);
+        vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_INTERVAL));
+    }
+}
+
+void logInit() {
+    if(drainTask) return;
+    xTaskCreate(logDrainTask, "log", LOG_TASK_STACK, nullptr, LOG_TASK_PRIORITY, &drainTask);
+}
+
+// ============================================================================
+// LEVELS & STATISTICS
+// ============================================================================
+
+void setLogLevel(int tag, uint8_t level) {
+    if(level > LOG_LEVEL_DEBUG) level = LOG_LEVEL_DEBUG;
+    for(int t = 0; t < LOG_TAG_COUNT; t++) {
+        if(tag < 0 || tag == t) logRuntimeLevel[t] = level;
+    }
+}
+
+uint8_t getLogLevel(int tag) {
+    return (tag >= 0 && tag < LOG_TAG_COUNT) ? logRuntimeLevel[tag] : LOG_LEVEL_NONE;
+}
+
+LogStats getLogStats() {
+    LogStats s;
+    s.written = written.load(std::memory_order_relaxed);
+    s.dropped = dropped.load(std::memory_order_relaxed);
+    s.filtered = filtered.load(std::memory_order_relaxed);
+    s.maxUsed = maxUsed;
+    return s;
+}
+
+// ============================================================================
+// HTTP
+// ============================================================================
+
+static int findTag(const String &name) {
+    for(int t = 0; t < LOG_TAG_COUNT; t++) {
+        if(name.equalsIgnoreCase(tagNames[t])) return t;
+    }
+    return -2;
+}
+
+static int findLevel(const String &name) {
+    for(int l = 0; l <= LOG_LEVEL_DEBUG; l++) {
+        if(name.equalsIgnoreCase(levelNames[l])) return l;
+    }
+    return -1;
+}
+
+void setupLogEndpoints(AsyncWebServer &server) {
+    // GET /log: recent lines (text), ?level=&tag= sets the runtime level, ?stats=1 JSON counters
+    server.on("/log", HTTP_GET, [](AsyncWebServerRequest *request) {
+        if(request->hasArg("level")) {
+            int level = findLevel(request->arg("level"));
+            int tag = request->hasArg("tag") ? findTag(request->arg("tag")) : -1;
+            if(level < 0 || tag == -2) {
+                request->send(400, "text/plain", "unknown level or tag");
+                return;
+            }
+            setLogLevel(tag, level);
+        }
+
+        if(request->hasArg("stats")) {
+            LogStats s = getLogStats();
+            String json = "{\"written\":" + String(s.written) + ",";
+            json += "\"dropped\":" + String(s.dropped) + ",";
+            json += "\"filtered\":" + String(s.filtered) + ",";
+            json += "\"maxUsed\":" + String(s.maxUsed) + ",";
+            json += "\"ringSize\":" + String(LOG_RING_SIZE) + ",";
+            json += "\"compileLevel\":\"" + String(levelNames[LOG_LEVEL]) + "\",\"levels\":{";
+            for(int t = 0; t < LOG_TAG_COUNT; t++) {
+                if(t > 0) json += ",";
+                json += "\"" + String(tagNames[t]) + "\":\"" + String(levelNames[logRuntimeLevel[t]]) + "\"";
+            }
+            json += "}}";
+            request->send(200, "application/json", json);
+            return;
+        }
+
+        // Only the two ring halves are copied with interrupts masked; the String
+        // (heap) is built afterwards. Handlers all run on async_tcp: one copy buffer.
+        static char copy[LOG_TEXT_BUFFER + 1];
+        portENTER_CRITICAL(&textMux);
+        uint32_t end = textWritten;
+        size_t length = end > LOG_TEXT_BUFFER ? LOG_TEXT_BUFFER : end;
+        size_t first = (end - length) % LOG_TEXT_BUFFER;   // oldest character
+        size_t head = length < LOG_TEXT_BUFFER - first ? length : LOG_TEXT_BUFFER - first;
+        memcpy(copy, textBuffer + first, head);
+        memcpy(copy + head, textBuffer, length - head);
+        portEXIT_CRITICAL(&textMux);
+        copy[length] = '\0';
+        request->send(200, "text/plain", String(copy));
+    });
+}
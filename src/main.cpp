@@ -11,6 +11,14 @@
 #include "wifi_manager.h"
 #include "alpaca_handlers.h"
 #include "display_control.h"
+#include "telemetry_log.h"
+#include "telemetry_stream.h"
+#include "event_log.h"
+#include "panel_push.h"
+#include "metrics.h"
+#include "task_monitor.h"
+#include "profiler.h"
+#include "boot_status.h"
 
 // ============================================================================
 // CONFIGURATION
@@ -32,29 +40,30 @@ AsyncWebServer server(ALPACA_PORT);
 void setup() {
     Serial.begin(115200);
     Serial.println("\n\n=== MoMa Rotator - ALPACA Driver ===");
+    logInit();
     
-    // Initialize OLED Display
+    // Boot stages run in parallel (see boot_status.h): display first, then the
+    // servo bus in its own task while WiFi associates and the server starts
     Serial.println("Initializing OLED display...");
     initDisplay();
+    startDisplayTask();
+    bootStageDone(BOOT_DISPLAY);
     
-    // Initialize servo motor
+    // Initialize servo motor (scan and EEPROM setup continue in the background)
     Serial.println("Initializing servo...");
-    displayMessage("Initializing", "Servo...");
     initServo();
     
-    // Initialize WiFi
-    Serial.println("Initializing WiFi...");
-    displayMessage("Connecting", "WiFi...");
-    initWiFi();
-    
-    // Initialize ALPACA UDP Discovery for auto-detection by ASCOM clients
-    Serial.println("Initializing ALPACA discovery...");
-    initDiscovery(ALPACA_PORT);
-    
-    // Setup web server endpoints
+    // Setup web server endpoints; device methods answer "not connected" until the servo is ready
     Serial.println("Setting up web server endpoints...");
+    setupAlpacaEndpoints(server);  // First: Alpaca requests skip the setup handler list
     setupWiFiEndpoints(server);
-    setupAlpacaEndpoints(server);
+    setupPanelPush(server);
+    setupTelemetryEndpoints(server);
+    setupTelemetryStream(server);
+    setupLogEndpoints(server);
+    setupMetricsEndpoint(server);
+    setupTaskEndpoint(server);
+    setupProfileEndpoint(server);
     
     // 404 handler
     server.onNotFound([](AsyncWebServerRequest *request) {
@@ -63,35 +72,35 @@ void setup() {
         request->send(404, "text/plain", message);
     });
     
-    // Start server
+    // Initialize WiFi
+    Serial.println("Initializing WiFi...");
+    displayMessage("Connecting", "WiFi...");
+    initWiFi();
+    
+    // Initialize ALPACA UDP Discovery for auto-detection by ASCOM clients
+    Serial.println("Initializing ALPACA discovery...");
+    initDiscovery(ALPACA_PORT);
+    
+    // Start server as soon as the network is up
     server.begin();
+    bootStageDone(BOOT_HTTP);
     Serial.println("=== Server started ===");
     Serial.print("IP: ");
     Serial.println(getIPAddress());
     Serial.println("Ready for ALPACA connections");
     
-    // Show ready message
+    // Show ready message (held by the UI task before motor info returns)
     displayMessage("MoMa Rotator", "Ready!", getIPAddress().c_str());
-    delay(2000);
+
+    // Periodic work runs in its own tasks from here on (see task_monitor.h)
+    startNetworkTask();
 }
 
 // ============================================================================
 // MAIN LOOP
 // ============================================================================
 
+// Unused: display and DNS run in the UI and network tasks
 void loop() {
-    // Update servo feedback regularly
-    getFeedback();
-    
-    // Update OLED display
-    updateDisplay();
-    
-    // Process DNS requests (only in AP mode - captive portal)
-    processDNS();
-    
-    // Handle ALPACA discovery packets (for ASCOM auto-detection)
-    handleDiscovery();
-    
-    // Small delay to prevent watchdog issues
-    delay(1);
+    vTaskDelete(nullptr);
 }
@@ -0,0 +1,351 @@
+#include "metrics.h"
+#include "servo_control.h"
+#include "alpaca_handlers.h"
+#include "alpaca_response.h"
+#include "wifi_manager.h"
+#include "event_log.h"
+#include "task_monitor.h"
+#include "boot_status.h"
+#include <esp_heap_caps.h>
+#include <stdarg.h>
+#include <new>
+#include <utility>
+
+const uint32_t metricsBucketsUs[METRICS_BUCKETS] = {
+    50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000,
+};
+
+static uint32_t scrapes = 0;
+static uint32_t poolMisses = 0;
+static uint32_t truncatedBlocks = 0;
+
+void histogramObserve(LatencyHistogram &h, uint32_t us) {
+    int i = 0;
+    while(i < METRICS_BUCKETS && us > metricsBucketsUs[i]) i++;
+    h.counts[i]++;
+    h.count++;
+    h.sumUs += us;
+}
+
+// ============================================================================
+// TEXT RENDERING
+// ============================================================================
+
+// Fixed buffer with printf-style appends; overflow is sticky
+struct TextBlock {
+    char *buf;
+    size_t cap;
+    size_t len = 0;
+    bool overflow = false;
+
+    TextBlock(char *buffer, size_t capacity) : buf(buffer), cap(capacity) {}
+
+    void print(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+        if(overflow) return;
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(buf + len, cap - len, fmt, args);
+        va_end(args);
+        if(n < 0 || (size_t)n >= cap - len) {
+            overflow = true;
+            return;
+        }
+        len += n;
+    }
+};
+
+static void family(TextBlock &out, const char *name, const char *type, const char *help) {
+    out.print("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+// Bucket bound in seconds without trailing zeros ("0.00005", "0.25")
+static const char *bucketLabel(int i) {
+    static char text[METRICS_BUCKETS][12];
+    if(!text[i][0]) {
+        int n = snprintf(text[i], sizeof(text[i]), "%.6f", metricsBucketsUs[i] / 1e6);
+        while(n > 1 && text[i][n - 1] == '0') text[i][--n] = '\0';
+        if(text[i][n - 1] == '.') text[i][--n] = '\0';
+    }
+    return text[i];
+}
+
+// labels: "" or e.g. endpoint="position" (without braces)
+static void histogram(TextBlock &out, const char *name, const char *labels, const LatencyHistogram &h) {
+    const char *sep = labels[0] ? "," : "";
+    uint32_t cumulative = 0;
+    for(int i = 0; i < METRICS_BUCKETS; i++) {
+        cumulative += h.counts[i];
+        out.print("%s_bucket{%s%sle=\"%s\"} %u\n", name, labels, sep, bucketLabel(i), (unsigned)cumulative);
+    }
+    out.print("%s_bucket{%s%sle=\"+Inf\"} %u\n", name, labels, sep, (unsigned)h.count);
+    const char *open = labels[0] ? "{" : "";
+    const char *close = labels[0] ? "}" : "";
+    out.print("%s_sum%s%s%s %.6f\n", name, open, labels, close, h.sumUs / 1e6);
+    out.print("%s_count%s%s%s %u\n", name, open, labels, close, (unsigned)h.count);
+}
+
+static void renderSystem(TextBlock &out) {
+    family(out, "moma_uptime_seconds", "gauge", "Time since boot");
+    out.print("moma_uptime_seconds %.3f\n", esp_timer_get_time() / 1e6);
+    family(out, "moma_heap_free_bytes", "gauge", "Free 8-bit heap");
+    out.print("moma_heap_free_bytes %u\n", (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT));
+    family(out, "moma_heap_largest_free_block_bytes", "gauge", "Largest allocatable heap block");
+    out.print("moma_heap_largest_free_block_bytes %u\n", (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+    family(out, "moma_heap_minimum_free_bytes", "gauge", "Lowest free heap since boot");
+    out.print("moma_heap_minimum_free_bytes %u\n", (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT));
+
+    WiFiLinkStats link = getWiFiLinkStats();
+    family(out, "moma_wifi_connected", "gauge", "Station connected to the access point");
+    out.print("moma_wifi_connected %d\n", WiFi.status() == WL_CONNECTED ? 1 : 0);
+    if(WiFi.status() == WL_CONNECTED) {
+        family(out, "moma_wifi_rssi_dbm", "gauge", "Station signal strength");
+        out.print("moma_wifi_rssi_dbm %d\n", (int)WiFi.RSSI());
+    }
+    family(out, "moma_wifi_disconnects_total", "counter", "Station disconnect events");
+    out.print("moma_wifi_disconnects_total %u\n", (unsigned)link.disconnects);
+    family(out, "moma_wifi_reconnects_total", "counter", "Station connections after the first");
+    out.print("moma_wifi_reconnects_total %u\n", (unsigned)link.reconnects);
+
+    LogStats log = getLogStats();
+    family(out, "moma_log_dropped_total", "counter", "Log records dropped because the ring was full");
+    out.print("moma_log_dropped_total %u\n", (unsigned)log.dropped);
+    family(out, "moma_metrics_scrapes_total", "counter", "Requests to /metrics");
+    out.print("moma_metrics_scrapes_total %u\n", (unsigned)scrapes);
+    family(out, "moma_metrics_pool_misses_total", "counter", "Overlapping scrapes served from the heap");
+    out.print("moma_metrics_pool_misses_total %u\n", (unsigned)poolMisses);
+    family(out, "moma_metrics_truncated_blocks_total", "counter", "Metric blocks larger than METRICS_BLOCK_SIZE");
+    out.print("moma_metrics_truncated_blocks_total %u\n", (unsigned)truncatedBlocks);
+}
+
+static void renderTasks(TextBlock &out) {
+    family(out, "moma_task_over_budget_total", "counter", "Task iterations slower than the task's budget");
+    for(int i = 0; i < getTaskCount(); i++) {
+        TaskStats s;
+        if(getTaskStats(i, s)) out.print("moma_task_over_budget_total{task=\"%s\"} %u\n", s.name, (unsigned)s.overBudget);
+    }
+    family(out, "moma_task_wake_late_max_seconds", "gauge", "Latest periodic wake-up after its due time");
+    for(int i = 0; i < getTaskCount(); i++) {
+        TaskStats s;
+        if(getTaskStats(i, s)) out.print("moma_task_wake_late_max_seconds{task=\"%s\"} %.6f\n", s.name, s.lateMaxUs / 1e6);
+    }
+}
+
+static void renderTaskStacks(TextBlock &out) {
+    family(out, "moma_task_stack_free_bytes", "gauge", "Least free task stack since start (high-water mark)");
+    for(int i = 0; i < getTaskCount(); i++) {
+        TaskStats s;
+        if(getTaskStats(i, s)) out.print("moma_task_stack_free_bytes{task=\"%s\"} %u\n", s.name, (unsigned)s.stackFree);
+    }
+}
+
+static void renderBuses(TextBlock &out) {
+    BusPollStats stats[MAX_SERVO_BUSES];
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) stats[b] = getBusPollStats(b);
+
+    family(out, "moma_bus_transactions_total", "counter", "Servo bus transactions");
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) {
+        if(stats[b].enabled) out.print("moma_bus_transactions_total{bus=\"%d\"} %u\n", b, (unsigned)stats[b].transactions);
+    }
+    family(out, "moma_bus_errors_total", "counter", "Servo replies missing or invalid");
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) {
+        if(stats[b].enabled) out.print("moma_bus_errors_total{bus=\"%d\"} %u\n", b, (unsigned)stats[b].errors);
+    }
+    family(out, "moma_bus_occupancy_ratio", "gauge", "Share of time the bus was busy (last second)");
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) {
+        if(stats[b].enabled) out.print("moma_bus_occupancy_ratio{bus=\"%d\"} %.4f\n", b, stats[b].occupancyPercent / 100.0f);
+    }
+}
+
+static void renderRotators(TextBlock &out) {
+    int64_t now = esp_timer_get_time();
+    family(out, "moma_rotator_sample_age_seconds", "gauge", "Age of the last position read (telemetry sample)");
+    for(int dev = 0; dev < getRotatorCount(); dev++) {
+        int64_t readUs = getLastFeedbackUs(dev);
+        if(readUs) out.print("moma_rotator_sample_age_seconds{dev=\"%d\"} %.6f\n", dev, (now - readUs) / 1e6);
+    }
+    family(out, "moma_rotator_moving", "gauge", "Rotator speed above the moving threshold");
+    for(int dev = 0; dev < getRotatorCount(); dev++) {
+        out.print("moma_rotator_moving{dev=\"%d\"} %d\n", dev, abs(getServoSpeed(dev)) > 10 ? 1 : 0);
+    }
+    family(out, "moma_rotator_blocked", "gauge", "Rotator offline: no replies, state is stale");
+    for(int dev = 0; dev < getRotatorCount(); dev++) {
+        out.print("moma_rotator_blocked{dev=\"%d\"} %d\n", dev, isMotorBlocked(dev) ? 1 : 0);
+    }
+    family(out, "moma_rotator_link_state", "gauge", "Servo link: 0 online, 1 degraded, 2 offline");
+    for(int dev = 0; dev < getRotatorCount(); dev++) {
+        out.print("moma_rotator_link_state{dev=\"%d\"} %d\n", dev, (int)getLinkHealth(dev).state);
+    }
+    family(out, "moma_rotator_link_outages_total", "counter", "Times the rotator went offline");
+    for(int dev = 0; dev < getRotatorCount(); dev++) {
+        out.print("moma_rotator_link_outages_total{dev=\"%d\"} %u\n", dev, (unsigned)getLinkHealth(dev).outages);
+    }
+}
+
+static void renderAlpacaTotals(TextBlock &out) {
+    AlpacaRequestStats requests = getAlpacaRequestStats();
+    AlpacaResponseStats responses = getAlpacaResponseStats();
+    family(out, "moma_alpaca_over_budget_total", "counter", "Alpaca handlers slower than ALPACA_HANDLER_BUDGET_US");
+    out.print("moma_alpaca_over_budget_total %u\n", (unsigned)requests.overBudget);
+    family(out, "moma_alpaca_response_pool_misses_total", "counter", "Alpaca responses allocated on the heap");
+    out.print("moma_alpaca_response_pool_misses_total %u\n", (unsigned)responses.poolMisses);
+    family(out, "moma_alpaca_discovery_replies_total", "counter", "Alpaca discovery replies sent");
+    out.print("moma_alpaca_discovery_replies_total %u\n", (unsigned)getDiscoveryReplies());
+}
+
+static void renderBoot(TextBlock &out) {
+    family(out, "moma_boot_stage_seconds", "gauge", "Time from boot to the end of each boot stage");
+    for(int s = 0; s < BOOT_STAGE_COUNT; s++) {
+        uint32_t ms = getBootStageMs((BootStage)s);
+        if(ms) out.print("moma_boot_stage_seconds{stage=\"%s\"} %.3f\n", getBootStageName(s), ms / 1e3);
+    }
+    uint32_t firstMs = getFirstAlpacaResponseMs();
+    if(firstMs) {
+        family(out, "moma_boot_first_alpaca_response_seconds", "gauge", "Time from boot to the first Alpaca response");
+        out.print("moma_boot_first_alpaca_response_seconds %.3f\n", firstMs / 1e3);
+    }
+}
+
+#define ENDPOINT_METRIC "moma_alpaca_request_duration_seconds"
+#define TASK_METRIC "moma_task_work_duration_seconds"
+#define FIRST_ENDPOINT_BLOCK 7
+
+// One labelled work-time histogram per task, after the endpoint histograms
+static bool renderTaskHistogram(int task, TextBlock &out) {
+    TaskStats s;
+    if(!getTaskStats(task, s)) return false;
+    if(task == 0) {
+        family(out, TASK_METRIC, "histogram", "Work time of one task iteration (_count = iterations)");
+    }
+    char labels[48];
+    snprintf(labels, sizeof(labels), "task=\"%s\"", s.name);
+    histogram(out, TASK_METRIC, labels, s.work);
+    return true;
+}
+
+// Block index -> content; false past the last block
+static bool renderBlock(int index, TextBlock &out) {
+    switch(index) {
+        case 0: renderSystem(out); return true;
+        case 1: renderTasks(out); return true;
+        case 2: renderTaskStacks(out); return true;
+        case 3: renderBuses(out); return true;
+        case 4: renderRotators(out); return true;
+        case 5: renderAlpacaTotals(out); return true;
+        case 6: renderBoot(out); return true;
+        default: break;
+    }
+    int endpoint = index - FIRST_ENDPOINT_BLOCK;
+    if(endpoint >= getAlpacaEndpointCount()) return renderTaskHistogram(endpoint - getAlpacaEndpointCount(), out);
+    if(endpoint == 0) {
+        family(out, ENDPOINT_METRIC, "histogram", "Alpaca handler time per endpoint (_count = requests)");
+    }
+    char labels[48];
+    snprintf(labels, sizeof(labels), "endpoint=\"%s\"", getAlpacaEndpointName(endpoint));
+    histogram(out, ENDPOINT_METRIC, labels, getAlpacaEndpointLatency(endpoint));
+    return true;
+}
+
+// ============================================================================
+// RESPONSE
+// ============================================================================
+
+class MetricsResponse : public AsyncAbstractResponse {
+public:
+    explicit MetricsResponse(bool chunked);
+    ~MetricsResponse() override;
+
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
+
+    bool _sourceValid() const override { return true; }
+
+    size_t _fillBuffer(uint8_t *data, size_t len) override {
+        size_t written = 0;
+        while(written < len) {
+            if(sent == length) {
+                if(!nextBlock()) break;
+                continue;
+            }
+            size_t n = length - sent;
+            if(n > len - written) n = len - written;
+            memcpy(data + written, buffer + sent, n);
+            sent += n;
+            written += n;
+        }
+        return written;
+    }
+
+private:
+    bool nextBlock() {
+        TextBlock out(buffer, sizeof(buffer));
+        if(!renderBlock(block, out)) return false;
+        if(out.overflow) {
+            truncatedBlocks++;
+            out.len = snprintf(buffer, sizeof(buffer), "# block %d truncated\n", block);
+        }
+        block++;
+        length = out.len;
+        sent = 0;
+        return true;
+    }
+
+    int block = 0;
+    size_t length = 0;
+    size_t sent = 0;
+    char buffer[METRICS_BLOCK_SIZE];
+};
+
+// One response in static storage; a scrape overlapping another uses the heap.
+// The content type does not fit the String inline buffer: the slot keeps its
+// String between scrapes and lends it to the response.
+#define METRICS_CONTENT_TYPE "text/plain; version=0.0.4"
+static uint8_t slot[sizeof(MetricsResponse)] __attribute__((aligned(8)));
+static bool slotUsed = false;
+static String slotContentType;
+static portMUX_TYPE slotMux = portMUX_INITIALIZER_UNLOCKED;
+
+MetricsResponse::MetricsResponse(bool chunked) {
+    _code = 200;
+    if(this == (void *)slot) {
+        if(slotContentType != METRICS_CONTENT_TYPE) slotContentType = METRICS_CONTENT_TYPE;
+        _contentType = std::move(slotContentType);
+    } else {
+        _contentType = METRICS_CONTENT_TYPE;
+    }
+    _contentLength = 0;
+    _sendContentLength = false;
+    _chunked = chunked;   // HTTP/1.0: the end of the body is the closed connection
+}
+
+MetricsResponse::~MetricsResponse() {
+    if(this == (void *)slot) slotContentType = std::move(_contentType);
+}
+
+void *MetricsResponse::operator new(size_t size) {
+    portENTER_CRITICAL(&slotMux);
+    if(!slotUsed) {
+        slotUsed = true;
+        portEXIT_CRITICAL(&slotMux);
+        return slot;
+    }
+    poolMisses++;
+    portEXIT_CRITICAL(&slotMux);
+    return ::operator new(size);
+}
+
+void MetricsResponse::operator delete(void *ptr) {
+    if(ptr == slot) {
+        portENTER_CRITICAL(&slotMux);
+        slotUsed = false;
+        portEXIT_CRITICAL(&slotMux);
+        return;
+    }
+    ::operator delete(ptr);
+}
+
+void setupMetricsEndpoint(AsyncWebServer &server) {
+    server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request) {
+        scrapes++;
+        request->send(new MetricsResponse(request->version() != 0));
+    });
+}
@@ -0,0 +1,339 @@
+#include "move_sequence.h"
+#include "servo_control.h"
+#include "angle_math.h"
+#include "event_log.h"
+#include "task_monitor.h"
+#include <esp_timer.h>
+
+#define SEQUENCE_TASK_STACK 3072
+#define SEQUENCE_TASK_PRIORITY 2        // below the bus tasks, above panel and telemetry
+#define SEQUENCE_TASK_BUDGET_US 1000    // queues moves only, never waits for the bus
+#define SEQUENCE_POLL_MS 5              // arrival check while a sequence runs
+
+struct Sequence {
+    SequenceStep steps[SEQUENCE_MAX_STEPS];
+    int count = 0;
+    int step = 0;
+    SequenceState state = SEQUENCE_IDLE;
+    int savedSpeed = 0;
+    int64_t startUs = 0;
+    int64_t endUs = 0;
+    int64_t moveIssuedUs = 0;
+    int64_t deadlineUs = 0;             // end of the current dwell
+    int64_t scheduledUs = 0;            // start the issued step was due, 0 = first step or recorded
+    esp_timer_handle_t timer = nullptr;
+
+    uint32_t jitterCount = 0;
+    uint64_t jitterSumUs = 0;
+    uint32_t jitterLastUs = 0;
+    uint32_t jitterMaxUs = 0;
+    uint32_t timerLateCount = 0;
+    uint64_t timerLateSumUs = 0;
+    uint32_t timerLateLastUs = 0;
+    uint32_t timerLateMaxUs = 0;
+};
+
+static Sequence sequences[MAX_ROTATORS];
+static portMUX_TYPE sequenceMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t sequenceTask = nullptr;
+
+static inline bool running(SequenceState state) {
+    return state == SEQUENCE_MOVING || state == SEQUENCE_DWELLING;
+}
+
+static void issueStep(int dev, const SequenceStep &step) {
+    if(step.speed) setActiveSpeed(dev, step.speed);
+    requestMoveTo(dev, step.targetSteps);
+}
+
+// ============================================================================
+// PARSER
+// ============================================================================
+
+bool parseSequence(const char *text, int32_t stepsPerRev, SequenceStep *steps, int &count, const char *&error) {
+    count = 0;
+    const char *p = text;
+    while(*p) {
+        if(count >= SEQUENCE_MAX_STEPS) {
+            error = "Too many steps";
+            return false;
+        }
+        char *end;
+        double degrees = strtod(p, &end);
+        if(end == p || *end != ',') {
+            error = "Expected angle,dwellMs[,speed]";
+            return false;
+        }
+        if(degrees < 0.0 || degrees > 359.99) {
+            error = "Position out of range";
+            return false;
+        }
+        p = end + 1;
+        long dwell = strtol(p, &end, 10);
+        if(end == p || dwell < 0 || dwell > SEQUENCE_MAX_DWELL_MS) {
+            error = "Invalid dwell";
+            return false;
+        }
+        p = end;
+        long speed = 0;
+        if(*p == ',') {
+            speed = strtol(p + 1, &end, 10);
+            if(end == p + 1 || speed < 0 || speed > INT16_MAX) {
+                error = "Invalid speed";
+                return false;
+            }
+            p = end;
+        }
+        if(*p != ';' && *p != '\0') {
+            error = "Expected ';' between steps";
+            return false;
+        }
+        if(*p == ';') p++;
+
+        SequenceStep &s = steps[count++];
+        s.targetSteps = degreesToSteps(degrees, stepsPerRev);
+        s.dwellMs = (uint32_t)dwell;
+        s.speed = (int16_t)speed;
+    }
+    if(count == 0) {
+        error = "Empty sequence";
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// TIMING
+// ============================================================================
+
+// esp_timer one-shot at arrival + dwell: starts the next step
+static void onDwellEnd(void *arg) {
+    int dev = (int)(intptr_t)arg;
+    Sequence &q = sequences[dev];
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&sequenceMux);
+    if(q.state != SEQUENCE_DWELLING || q.step + 1 >= q.count) {
+        portEXIT_CRITICAL(&sequenceMux);
+        return;
+    }
+    uint32_t late = now > q.deadlineUs ? (uint32_t)(now - q.deadlineUs) : 0;
+    q.timerLateCount++;
+    q.timerLateSumUs += late;
+    q.timerLateLastUs = late;
+    if(late > q.timerLateMaxUs) q.timerLateMaxUs = late;
+    q.step++;
+    q.state = SEQUENCE_MOVING;
+    q.moveIssuedUs = now;
+    q.scheduledUs = q.deadlineUs;   // jitter is taken when the bus task writes the move
+    SequenceStep step = q.steps[q.step];
+    portEXIT_CRITICAL(&sequenceMux);
+
+    issueStep(dev, step);
+
+    // An abort between the check above and the move: halt again
+    portENTER_CRITICAL(&sequenceMux);
+    bool aborted = q.state == SEQUENCE_ABORTED;
+    portEXIT_CRITICAL(&sequenceMux);
+    if(aborted) requestHalt(dev);
+}
+
+static void finish(int dev, SequenceState state) {
+    Sequence &q = sequences[dev];
+    portENTER_CRITICAL(&sequenceMux);
+    q.state = state;
+    q.endUs = esp_timer_get_time();
+    int speed = q.savedSpeed;
+    portEXIT_CRITICAL(&sequenceMux);
+    setActiveSpeed(dev, speed);
+}
+
+// Arrival detection and timeouts for all rotators
+static bool serviceSequence(int dev) {
+    Sequence &q = sequences[dev];
+    portENTER_CRITICAL(&sequenceMux);
+    SequenceState state = q.state;
+    int step = q.step;
+    int count = q.count;
+    int64_t issuedUs = q.moveIssuedUs;
+    int64_t deadlineUs = q.deadlineUs;
+    int64_t scheduledUs = q.scheduledUs;
+    uint32_t dwellMs = q.steps[step].dwellMs;
+    portEXIT_CRITICAL(&sequenceMux);
+
+    int64_t now = esp_timer_get_time();
+    bool last = step + 1 >= count;
+
+    // Step start jitter: the write of the move against the schedule
+    int64_t sentUs = scheduledUs ? getLastMoveSentUs(dev) : 0;
+    if(state == SEQUENCE_MOVING && sentUs >= issuedUs) {
+        uint32_t late = sentUs > scheduledUs ? (uint32_t)(sentUs - scheduledUs) : 0;
+        portENTER_CRITICAL(&sequenceMux);
+        if(q.step == step && q.scheduledUs == scheduledUs) {
+            q.scheduledUs = 0;
+            q.jitterCount++;
+            q.jitterSumUs += late;
+            q.jitterLastUs = late;
+            if(late > q.jitterMaxUs) q.jitterMaxUs = late;
+        }
+        portEXIT_CRITICAL(&sequenceMux);
+    }
+
+    if(state == SEQUENCE_MOVING) {
+        int64_t readUs;
+        if(isMotionSettled(dev, &readUs) && readUs > issuedUs) {
+            // Dwell counts from the read that saw the rotator arrive
+            int64_t deadline = readUs + (int64_t)dwellMs * 1000;
+            portENTER_CRITICAL(&sequenceMux);
+            bool current = q.state == SEQUENCE_MOVING && q.step == step;
+            if(current) {
+                q.state = SEQUENCE_DWELLING;
+                q.deadlineUs = deadline;
+            }
+            portEXIT_CRITICAL(&sequenceMux);
+            if(current && !last) {
+                int64_t wait = deadline - esp_timer_get_time();
+                esp_timer_start_once(q.timer, wait > 0 ? wait : 1);
+            }
+        } else if(now - issuedUs > (int64_t)SEQUENCE_MOVE_TIMEOUT_MS * 1000) {
+            LOG_W(LOG_TAG_SERVO, "Rotator %d: sequence step %d did not settle, stopped", dev, step);
+            requestHalt(dev);
+            finish(dev, SEQUENCE_FAILED);
+            return false;
+        }
+        return true;
+    }
+    if(state == SEQUENCE_DWELLING && last && now >= deadlineUs) {
+        finish(dev, SEQUENCE_DONE);
+        LOG_I(LOG_TAG_SERVO, "Rotator %d: sequence of %d steps done", dev, count);
+        return false;
+    }
+    return running(state);
+}
+
+static void moveSequenceTask(void *param) {
+    int slot = taskMonitorAdd("sequence", TASK_CORE_MOTION, SEQUENCE_TASK_BUDGET_US, SEQUENCE_TASK_STACK);
+    for(;;) {
+        taskWorkBegin(slot);
+        bool any = false;
+        for(int dev = 0; dev < getRotatorCount(); dev++) {
+            any |= serviceSequence(dev);
+        }
+        taskWorkEnd(slot);
+        // Idle: sleep until startSequence() wakes the task
+        ulTaskNotifyTake(pdTRUE, any ? pdMS_TO_TICKS(SEQUENCE_POLL_MS) : portMAX_DELAY);
+    }
+}
+
+// ============================================================================
+// CONTROL
+// ============================================================================
+
+bool startSequence(int dev, const SequenceStep *steps, int count) {
+    if(dev < 0 || dev >= getRotatorCount() || count < 1 || count > SEQUENCE_MAX_STEPS) return false;
+    Sequence &q = sequences[dev];
+    if(!q.timer) {
+        esp_timer_create_args_t args = {};
+        args.callback = onDwellEnd;
+        args.arg = (void *)(intptr_t)dev;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "sequence";
+        if(esp_timer_create(&args, &q.timer) != ESP_OK) return false;
+    }
+    if(!sequenceTask) {
+        xTaskCreatePinnedToCore(moveSequenceTask, "sequence", SEQUENCE_TASK_STACK, nullptr, SEQUENCE_TASK_PRIORITY,
+                                &sequenceTask, TASK_CORE_MOTION);
+    }
+
+    int speed = getActiveSpeed(dev);
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&sequenceMux);
+    if(running(q.state)) {
+        portEXIT_CRITICAL(&sequenceMux);
+        return false;
+    }
+    memcpy(q.steps, steps, count * sizeof(SequenceStep));
+    q.count = count;
+    q.step = 0;
+    q.state = SEQUENCE_MOVING;
+    q.savedSpeed = speed;
+    q.startUs = now;
+    q.endUs = 0;
+    q.moveIssuedUs = now;
+    q.deadlineUs = 0;
+    q.scheduledUs = 0;
+    q.jitterCount = 0;
+    q.jitterSumUs = 0;
+    q.jitterLastUs = 0;
+    q.jitterMaxUs = 0;
+    q.timerLateCount = 0;
+    q.timerLateSumUs = 0;
+    q.timerLateLastUs = 0;
+    q.timerLateMaxUs = 0;
+    portEXIT_CRITICAL(&sequenceMux);
+
+    issueStep(dev, steps[0]);
+    xTaskNotifyGive(sequenceTask);
+    LOG_I(LOG_TAG_SERVO, "Rotator %d: sequence of %d steps started", dev, count);
+    return true;
+}
+
+void abortSequence(int dev) {
+    if(dev < 0 || dev >= getRotatorCount()) return;
+    Sequence &q = sequences[dev];
+    portENTER_CRITICAL(&sequenceMux);
+    bool active = running(q.state);
+    portEXIT_CRITICAL(&sequenceMux);
+    if(!active) return;
+
+    if(q.timer) esp_timer_stop(q.timer);
+    finish(dev, SEQUENCE_ABORTED);
+    requestHalt(dev);
+    LOG_I(LOG_TAG_SERVO, "Rotator %d: sequence aborted", dev);
+}
+
+bool isSequenceRunning(int dev) {
+    if(dev < 0 || dev >= getRotatorCount()) return false;
+    portENTER_CRITICAL(&sequenceMux);
+    bool active = running(sequences[dev].state);
+    portEXIT_CRITICAL(&sequenceMux);
+    return active;
+}
+
+SequenceStatus getSequenceStatus(int dev) {
+    SequenceStatus s;
+    if(dev < 0 || dev >= getRotatorCount()) return s;
+    Sequence &q = sequences[dev];
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&sequenceMux);
+    s.state = q.state;
+    s.step = q.step;
+    s.steps = q.count;
+    if(q.state != SEQUENCE_IDLE) {
+        s.elapsedMs = (uint32_t)(((running(q.state) ? now : q.endUs) - q.startUs) / 1000);
+    }
+    if(q.state == SEQUENCE_DWELLING && q.deadlineUs > now) {
+        s.dwellRemainingMs = (uint32_t)((q.deadlineUs - now) / 1000);
+    }
+    s.jitterCount = q.jitterCount;
+    s.jitterLastUs = q.jitterLastUs;
+    s.jitterMeanUs = q.jitterCount ? (uint32_t)(q.jitterSumUs / q.jitterCount) : 0;
+    s.jitterMaxUs = q.jitterMaxUs;
+    s.timerLateLastUs = q.timerLateLastUs;
+    s.timerLateMeanUs = q.timerLateCount ? (uint32_t)(q.timerLateSumUs / q.timerLateCount) : 0;
+    s.timerLateMaxUs = q.timerLateMaxUs;
+    portEXIT_CRITICAL(&sequenceMux);
+    return s;
+}
+
+const char *sequenceStateName(SequenceState state) {
+    switch(state) {
+        case SEQUENCE_MOVING: return "moving";
+        case SEQUENCE_DWELLING: return "dwelling";
+        case SEQUENCE_DONE: return "done";
+        case SEQUENCE_ABORTED: return "aborted";
+        case SEQUENCE_FAILED: return "failed";
+        default: return "idle";
+    }
+}
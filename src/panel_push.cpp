@@ -0,0 +1,191 @@
+#include "panel_push.h"
+#include "servo_control.h"
+#include "angle_math.h"
+#include "wifi_manager.h"
+#include "json_writer.h"
+#include "event_log.h"
+#include "task_monitor.h"
+
+#define PANEL_TASK_STACK 3072
+#define PANEL_TASK_PRIORITY 1
+#define PANEL_TASK_BUDGET_US 5000
+#define PANEL_MESSAGE_SIZE 384
+#define PANEL_COMMAND_SIZE 48
+
+// Last state sent per rotator, the reference for the delta
+struct PanelState {
+    int32_t centiDegrees;
+    bool moving;
+    int speed;
+    bool reverse;
+};
+
+static AsyncWebSocket ws("/setup/v1/rotator/0/ws");
+static PanelState lastSent[MAX_ROTATORS];
+static uint32_t lastIP = 0;
+static volatile bool fullStateDue = true;   // set on connect, cleared by the producer
+static char message[PANEL_MESSAGE_SIZE];    // producer task only
+static PanelPushStats stats;
+static TaskHandle_t pushTask = nullptr;
+
+// ============================================================================
+// PRODUCER
+// ============================================================================
+
+static PanelState readState(int dev) {
+    PanelState s;
+    s.centiDegrees = (stepsToMilliDegrees(getLastServoSteps(dev), getStepsPerRev(dev)) + 5) / 10 % 36000;
+    s.moving = isServoMoving(dev);   // Same rule as IsMoving: queued, unread or not settled
+    s.speed = getActiveSpeed(dev);
+    s.reverse = getReverseDirection(dev);
+    return s;
+}
+
+// Builds the delta (or full state) into message; returns false if nothing changed
+static bool buildMessage(bool full) {
+    JsonWriter json(message, sizeof(message));
+    bool changed = false;
+    json.beginObject();
+
+    IPAddress address = WiFi.status() == WL_CONNECTED ? WiFi.localIP() : WiFi.softAPIP();
+    uint32_t ip = (uint32_t)address;
+    if(full || ip != lastIP) {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", address[0], address[1], address[2], address[3]);
+        json.key("ip").string(text);
+        lastIP = ip;
+        changed = true;
+    }
+
+    json.key("rot").beginArray();
+    for(int dev = 0; dev < getRotatorCount(); dev++) {
+        PanelState now = readState(dev);
+        PanelState &last = lastSent[dev];
+        bool p = full || now.centiDegrees != last.centiDegrees;
+        bool m = full || now.moving != last.moving;
+        bool s = full || now.speed != last.speed;
+        bool r = full || now.reverse != last.reverse;
+        if(!(p || m || s || r)) continue;
+
+        json.beginObject().key("d").integer(dev);
+        if(p) json.key("p").number(now.centiDegrees / 100.0, 2);
+        if(m) json.key("m").boolean(now.moving);
+        if(s) json.key("s").integer(now.speed);
+        if(r) json.key("r").boolean(now.reverse);
+        json.endObject();
+        last = now;
+        changed = true;
+    }
+    json.endArray().endObject();
+    return changed && !json.overflow();
+}
+
+static void pushState() {
+    ws.cleanupClients(PANEL_MAX_CLIENTS);
+    if(ws.count() == 0) {
+        fullStateDue = true;
+        return;
+    }
+
+    bool full = fullStateDue;
+    fullStateDue = false;
+    if(!buildMessage(full)) return;
+
+    // One shared message buffer for all panels
+    size_t len = strlen(message);
+    ws.textAll(message, len);
+    stats.messages++;
+    stats.bytes += len;
+    if(full) stats.fullStates++;
+}
+
+static void panelPushTask(void *param) {
+    int slot = taskMonitorAdd("panel", TASK_CORE_NETWORK, PANEL_TASK_BUDGET_US, PANEL_TASK_STACK);
+    int64_t dueUs = esp_timer_get_time();
+    for(;;) {
+        taskDelayUntil(dueUs, PANEL_PUSH_INTERVAL_MS * 1000);
+        taskWorkBegin(slot, dueUs);
+        pushState();
+        taskWorkEnd(slot);
+    }
+}
+
+// ============================================================================
+// SOCKET EVENTS
+// ============================================================================
+
+static void handleCommand(const uint8_t *data, size_t len) {
+    char text[PANEL_COMMAND_SIZE];
+    if(len >= sizeof(text)) return;
+    memcpy(text, data, len);
+    text[len] = '\0';
+
+    int cmdI = 0;
+    double cmdP = 0;
+    int dev = 0;
+    if(sscanf(text, "%d,%lf,%d", &cmdI, &cmdP, &dev) < 1) return;
+    stats.commands++;
+    if(handlePanelCommand(dev, cmdI, cmdP)) stats.refusedMoves++;   // the next state push shows it did not move
+}
+
+static void onEvent(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type,
+                    void *arg, uint8_t *data, size_t len) {
+    switch(type) {
+        case WS_EVT_CONNECT:
+            if(server->count() > PANEL_MAX_CLIENTS) {
+                stats.rejected++;
+                client->close(1013, "too many panels");
+                return;
+            }
+            fullStateDue = true;
+            LOG_I(LOG_TAG_WIFI, "Panel connected (%u open)", (unsigned)server->count());
+            break;
+        case WS_EVT_DISCONNECT:
+            LOG_I(LOG_TAG_WIFI, "Panel disconnected");
+            break;
+        case WS_EVT_DATA: {
+            // Commands are short: only single-frame text messages
+            AwsFrameInfo *info = (AwsFrameInfo *)arg;
+            if(info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT) {
+                handleCommand(data, len);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+void setupPanelPush(AsyncWebServer &server) {
+    ws.onEvent(onEvent);
+    server.addHandler(&ws);
+
+    server.on("/setup/v1/rotator/0/panelstats", HTTP_GET, [](AsyncWebServerRequest *request) {
+        PanelPushStats s = getPanelPushStats();
+        String json = "{\"clients\":" + String(s.clients) + ",";
+        json += "\"messages\":" + String(s.messages) + ",";
+        json += "\"bytes\":" + String(s.bytes) + ",";
+        json += "\"fullStates\":" + String(s.fullStates) + ",";
+        json += "\"commands\":" + String(s.commands) + ",";
+        json += "\"refusedMoves\":" + String(s.refusedMoves) + ",";
+        json += "\"rejected\":" + String(s.rejected) + ",";
+        json += "\"intervalMs\":" + String(PANEL_PUSH_INTERVAL_MS) + ",";
+        json += "\"freeHeap\":" + String(ESP.getFreeHeap()) + "}";
+        request->send(200, "application/json", json);
+    });
+
+    if(!pushTask) {
+        xTaskCreatePinnedToCore(panelPushTask, "panel", PANEL_TASK_STACK, nullptr, PANEL_TASK_PRIORITY,
+                                &pushTask, TASK_CORE_NETWORK);
+    }
+}
+
+PanelPushStats getPanelPushStats() {
+    PanelPushStats s = stats;
+    s.clients = ws.count();
+    return s;
+}
@@ -0,0 +1,216 @@
+#include "position_journal.h"
+#include <Preferences.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <stdlib.h>
+#include <string.h>
+#include "servo_control.h"
+#include "event_log.h"
+#include "task_monitor.h"
+
+#define JOURNAL_TASK_STACK 3072
+#define JOURNAL_TASK_PRIORITY 1          // below the bus tasks: reads polled state only
+#define JOURNAL_TASK_BUDGET_US 30000     // an NVS write erases a page now and then
+#define JOURNAL_SHUTDOWN_WAIT_MS 200     // shutdown handler: wait for a write in progress
+#define JOURNAL_RESIDUAL_TOLERANCE 2     // steps, the settle tolerance of servo_control
+#define JOURNAL_VERSION 1
+
+// NVS "journal"/"pos"; no checksum of its own, NVS checks every entry
+struct JournalBlob {
+    uint8_t version;
+    uint8_t count;
+    uint8_t reserved[2];
+    JournalEntry entries[MAX_ROTATORS];
+};
+
+static JournalBlob written;              // last written or loaded, zero = none
+static JournalBlob candidate;            // settled state waiting for its write
+static int64_t candidateSinceUs = 0;
+static PositionJournalStats stats;
+static SemaphoreHandle_t journalLock = nullptr;
+static TaskHandle_t journalTask = nullptr;
+static portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ============================================================================
+// STORAGE
+// ============================================================================
+
+static void writeBlob(const JournalBlob &blob, bool shutdown) {
+    int64_t start = esp_timer_get_time();
+    Preferences prefs;
+    prefs.begin("journal", false);
+    prefs.putBytes("pos", &blob, sizeof(blob));
+    prefs.end();
+    written = blob;
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&statsMux);
+    stats.writes++;
+    if(shutdown) stats.shutdownWrites++;
+    stats.dirty = false;
+    stats.lastWriteUs = now;
+    stats.lastWriteDurationUs = (uint32_t)(now - start);
+    portEXIT_CRITICAL(&statsMux);
+}
+
+// Current state of all rotators; true when every one of them is settled
+static bool collect(JournalBlob &blob) {
+    memset(&blob, 0, sizeof(blob));   // padding too: compared and stored as bytes
+    blob.version = JOURNAL_VERSION;
+    blob.count = getRotatorCount();
+    bool settled = true;
+    for(int dev = 0; dev < blob.count; dev++) {
+        if(!getJournalEntry(dev, blob.entries[dev])) settled = false;
+    }
+    return settled;
+}
+
+int loadPositionJournal(JournalEntry *entries, int max) {
+    if(!journalLock) journalLock = xSemaphoreCreateMutex();
+    int64_t start = esp_timer_get_time();
+    JournalBlob blob;
+    memset(&blob, 0, sizeof(blob));
+    Preferences prefs;
+    prefs.begin("journal", true);
+    if(prefs.getBytesLength("pos") == sizeof(blob)) {
+        prefs.getBytes("pos", &blob, sizeof(blob));
+    }
+    prefs.end();
+    if(blob.version != JOURNAL_VERSION || blob.count > MAX_ROTATORS) memset(&blob, 0, sizeof(blob));
+    written = blob;
+    stats.loadUs = (uint32_t)(esp_timer_get_time() - start);
+
+    int n = blob.count < max ? blob.count : max;
+    for(int i = 0; i < n; i++) entries[i] = blob.entries[i];
+
+    esp_reset_reason_t reason = esp_reset_reason();
+    if(reason == ESP_RST_BROWNOUT) {
+        LOG_W(LOG_TAG_SERVO, "Reset by brownout: moves after the last journal write (up to %d ms) are lost",
+              JOURNAL_MIN_INTERVAL_MS);
+    }
+    LOG_I(LOG_TAG_SERVO, "Position journal: %d entries in %lu us, reset reason %s", blob.count,
+          (unsigned long)stats.loadUs, getResetReasonName());
+    return n;
+}
+
+// ============================================================================
+// RESTORE
+// ============================================================================
+
+PositionRestoreState checkJournalEntry(const JournalEntry &saved, uint8_t bus, uint8_t id,
+                                       bool feedback, int32_t residual) {
+    if(saved.bus != bus || saved.id != id) return RESTORE_OTHER_SERVO;
+    // In flight: only esp_restart() leaves the servo powered and on its way to
+    // the target. After a power cycle the move stopped somewhere on the way and
+    // the servo reports no distance left, so the entry cannot be checked.
+    if((saved.flags & JOURNAL_IN_FLIGHT) && esp_reset_reason() != ESP_RST_SW) return RESTORE_RESIDUAL;
+    if(!feedback) return RESTORE_UNVERIFIED;
+    // Settled entry: the servo still holds its position. In flight: it went
+    // on towards the target and has at most the distance left it had then.
+    int32_t span = saved.spanSteps < 0 ? -saved.spanSteps : saved.spanSteps;
+    if(abs(residual) > span + JOURNAL_RESIDUAL_TOLERANCE) return RESTORE_RESIDUAL;
+    return RESTORE_OK;
+}
+
+const char *restoreStateName(PositionRestoreState state) {
+    switch(state) {
+        case RESTORE_OK: return "restored";
+        case RESTORE_UNVERIFIED: return "unverified";
+        case RESTORE_OTHER_SERVO: return "other servo";
+        case RESTORE_RESIDUAL: return "residual";
+        default: return "none";
+    }
+}
+
+const char *getResetReasonName() {
+    switch(esp_reset_reason()) {
+        case ESP_RST_POWERON: return "power-on";
+        case ESP_RST_EXT: return "external";
+        case ESP_RST_SW: return "restart";
+        case ESP_RST_PANIC: return "panic";
+        case ESP_RST_INT_WDT:
+        case ESP_RST_TASK_WDT:
+        case ESP_RST_WDT: return "watchdog";
+        case ESP_RST_DEEPSLEEP: return "deep sleep";
+        case ESP_RST_BROWNOUT: return "brownout";
+        default: return "unknown";
+    }
+}
+
+// ============================================================================
+// BATCHED WRITES
+// ============================================================================
+
+// A settled state is written once it held for JOURNAL_QUIET_MS, at most one
+// write per JOURNAL_MIN_INTERVAL_MS; states replaced before that are folded
+static void journalCheck() {
+    JournalBlob now;
+    bool settled = collect(now);
+    int64_t t = esp_timer_get_time();
+
+    xSemaphoreTake(journalLock, portMAX_DELAY);
+    bool dirty = memcmp(&now, &written, sizeof(now)) != 0;
+    portENTER_CRITICAL(&statsMux);
+    stats.dirty = dirty;
+    portEXIT_CRITICAL(&statsMux);
+
+    if(settled && memcmp(&now, &candidate, sizeof(now)) != 0) {
+        if(candidateSinceUs && memcmp(&candidate, &written, sizeof(candidate)) != 0) {
+            portENTER_CRITICAL(&statsMux);
+            stats.folded++;
+            portEXIT_CRITICAL(&statsMux);
+        }
+        candidate = now;
+        candidateSinceUs = t;
+    }
+    bool due = candidateSinceUs && t - candidateSinceUs >= (int64_t)JOURNAL_QUIET_MS * 1000
+            && (!stats.lastWriteUs || t - stats.lastWriteUs >= (int64_t)JOURNAL_MIN_INTERVAL_MS * 1000);
+    if(due && memcmp(&candidate, &written, sizeof(candidate)) != 0) writeBlob(candidate, false);
+    xSemaphoreGive(journalLock);
+}
+
+static void flush(bool shutdown) {
+    // Before the servo boot task restored the rotators there is nothing newer than the journal
+    if(!journalLock || !isServoReady()) return;
+    if(xSemaphoreTake(journalLock, pdMS_TO_TICKS(JOURNAL_SHUTDOWN_WAIT_MS)) != pdTRUE) return;
+    JournalBlob now;
+    collect(now);
+    if(memcmp(&now, &written, sizeof(now)) != 0) writeBlob(now, shutdown);
+    xSemaphoreGive(journalLock);
+}
+
+void flushPositionJournal() {
+    flush(false);
+}
+
+static void journalShutdown() {
+    flush(true);
+}
+
+static void journalTaskLoop(void *param) {
+    int slot = taskMonitorAdd("journal", -1, JOURNAL_TASK_BUDGET_US, JOURNAL_TASK_STACK);
+    int64_t dueUs = esp_timer_get_time();
+    for(;;) {
+        taskDelayUntil(dueUs, JOURNAL_CHECK_MS * 1000);
+        taskWorkBegin(slot, dueUs);
+        journalCheck();
+        taskWorkEnd(slot);
+    }
+}
+
+void startPositionJournal() {
+    if(journalTask) return;
+    if(!journalLock) journalLock = xSemaphoreCreateMutex();
+    esp_register_shutdown_handler(journalShutdown);
+    xTaskCreate(journalTaskLoop, "journal", JOURNAL_TASK_STACK, nullptr, JOURNAL_TASK_PRIORITY, &journalTask);
+}
+
+PositionJournalStats getPositionJournalStats() {
+    portENTER_CRITICAL(&statsMux);
+    PositionJournalStats s = stats;
+    portEXIT_CRITICAL(&statsMux);
+    return s;
+}
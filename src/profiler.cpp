@@ -0,0 +1,180 @@
+#include "profiler.h"
+
+static const char *stageNames[STAGE_COUNT] = {
+    "motion", "moves", "feedback", "display", "dns", "discovery",
+};
+
+static ProfileStageStats stageStats[STAGE_COUNT];
+static ProfileCapture captures[PROFILER_WORST];
+static int captureCount = 0;
+static uint32_t migrated = 0;               // frames dropped: task moved to the other core
+static uint32_t thresholdUs = PROFILER_DEFAULT_THRESHOLD_US;
+static volatile bool onDisplay = false;
+static uint32_t cpuMHz = 0;
+static portMUX_TYPE profileMux = portMUX_INITIALIZER_UNLOCKED;
+
+float profileCyclesToUs(uint32_t cycles) {
+    if(!cpuMHz) cpuMHz = ESP.getCpuFreqMHz();
+    return (float)cycles / cpuMHz;
+}
+
+// ============================================================================
+// FOLDING
+// ============================================================================
+
+#if PROFILER_ENABLED
+
+// Keeps the PROFILER_WORST slowest captures, slowest first
+static void capture(const ProfileFrame &frame, uint32_t total, const char *task) {
+    int pos = captureCount;
+    while(pos > 0 && captures[pos - 1].totalCycles < total) pos--;
+    if(pos >= PROFILER_WORST) return;
+    int last = captureCount < PROFILER_WORST ? captureCount : PROFILER_WORST - 1;
+    for(int i = last; i > pos; i--) captures[i] = captures[i - 1];
+    if(captureCount < PROFILER_WORST) captureCount++;
+
+    ProfileCapture &c = captures[pos];
+    c.timeUs = esp_timer_get_time();
+    c.task = task;
+    c.totalCycles = total;
+    memcpy(c.cycles, frame.cycles, sizeof(c.cycles));
+    c.stages = frame.stages;
+}
+
+void profileEnd(ProfileFrame &frame, const char *task) {
+    uint32_t total = frame.mark - frame.start;
+    if(xPortGetCoreID() != frame.core) {
+        portENTER_CRITICAL(&profileMux);
+        migrated++;
+        portEXIT_CRITICAL(&profileMux);
+        return;
+    }
+    if(!cpuMHz) cpuMHz = ESP.getCpuFreqMHz();
+    float usPerCycle = 1.0f / cpuMHz;
+
+    portENTER_CRITICAL(&profileMux);
+    for(int s = 0; s < STAGE_COUNT; s++) {
+        if(!(frame.stages & (1 << s))) continue;
+        ProfileStageStats &st = stageStats[s];
+        uint32_t c = frame.cycles[s];
+        st.count++;
+        st.avgCycles = st.avgCycles ? st.avgCycles - st.avgCycles / 8 + c / 8 : c;
+        if(c > st.maxCycles) st.maxCycles = c;
+        histogramObserve(st.histogram, (uint32_t)(c * usPerCycle));
+    }
+    if(total * usPerCycle >= thresholdUs) capture(frame, total, task);
+    portEXIT_CRITICAL(&profileMux);
+}
+
+#endif
+
+// ============================================================================
+// STATISTICS & SETTINGS
+// ============================================================================
+
+const char *getProfileStageName(int stage) {
+    return stage >= 0 && stage < STAGE_COUNT ? stageNames[stage] : "?";
+}
+
+ProfileStageStats getProfileStageStats(int stage) {
+    ProfileStageStats s;
+    if(stage < 0 || stage >= STAGE_COUNT) return s;
+    portENTER_CRITICAL(&profileMux);
+    s = stageStats[stage];
+    portEXIT_CRITICAL(&profileMux);
+    return s;
+}
+
+int getProfileCaptures(ProfileCapture *out, int max) {
+    portENTER_CRITICAL(&profileMux);
+    int n = captureCount < max ? captureCount : max;
+    for(int i = 0; i < n; i++) out[i] = captures[i];
+    portEXIT_CRITICAL(&profileMux);
+    return n;
+}
+
+void resetProfiler() {
+    portENTER_CRITICAL(&profileMux);
+    for(int s = 0; s < STAGE_COUNT; s++) stageStats[s] = ProfileStageStats();
+    captureCount = 0;
+    migrated = 0;
+    portEXIT_CRITICAL(&profileMux);
+}
+
+void setProfileThresholdUs(uint32_t us) {
+    portENTER_CRITICAL(&profileMux);
+    thresholdUs = us;
+    portEXIT_CRITICAL(&profileMux);
+}
+
+uint32_t getProfileThresholdUs() {
+    return thresholdUs;
+}
+
+void setProfileOnDisplay(bool on) {
+    onDisplay = on;
+}
+
+bool isProfileOnDisplay() {
+    return onDisplay;
+}
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+void setupProfileEndpoint(AsyncWebServer &server) {
+    // Stage timing: ?reset=1 clears, thresholdUs sets the capture threshold, oled=1 shows it on the display
+    server.on("/setup/v1/rotator/0/profile", HTTP_GET, [](AsyncWebServerRequest *request) {
+        if (request->hasArg("reset")) resetProfiler();
+        if (request->hasArg("thresholdUs")) setProfileThresholdUs(request->arg("thresholdUs").toInt());
+        if (request->hasArg("oled")) setProfileOnDisplay(request->arg("oled").toInt() != 0);
+
+        String json = "{\"enabled\":" + String(PROFILER_ENABLED ? "true" : "false") + ",";
+        json += "\"cpuMHz\":" + String(ESP.getCpuFreqMHz()) + ",";
+        json += "\"thresholdUs\":" + String(getProfileThresholdUs()) + ",";
+        json += "\"oled\":" + String(isProfileOnDisplay() ? "true" : "false") + ",";
+        json += "\"migrated\":" + String(migrated) + ",";
+        json += "\"bucketsUs\":[";
+        for (int i = 0; i < METRICS_BUCKETS; i++) {
+            if (i > 0) json += ",";
+            json += String(metricsBucketsUs[i]);
+        }
+        json += "],\"stages\":[";
+        for (int s = 0; s < STAGE_COUNT; s++) {
+            ProfileStageStats st = getProfileStageStats(s);
+            if (s > 0) json += ",";
+            json += "{\"name\":\"" + String(getProfileStageName(s)) + "\",";
+            json += "\"count\":" + String(st.count) + ",";
+            json += "\"avgUs\":" + String(profileCyclesToUs(st.avgCycles), 1) + ",";
+            json += "\"maxUs\":" + String(profileCyclesToUs(st.maxCycles), 1) + ",";
+            json += "\"histogram\":[";
+            for (int i = 0; i <= METRICS_BUCKETS; i++) {
+                if (i > 0) json += ",";
+                json += String(st.histogram.counts[i]);
+            }
+            json += "]}";
+        }
+        json += "],\"worst\":[";
+        ProfileCapture worst[PROFILER_WORST];
+        int n = getProfileCaptures(worst, PROFILER_WORST);
+        int64_t now = esp_timer_get_time();
+        for (int i = 0; i < n; i++) {
+            const ProfileCapture &c = worst[i];
+            if (i > 0) json += ",";
+            json += "{\"task\":\"" + String(c.task) + "\",";
+            json += "\"ageMs\":" + String((uint32_t)((now - c.timeUs) / 1000)) + ",";
+            json += "\"totalUs\":" + String(profileCyclesToUs(c.totalCycles), 1) + ",\"stagesUs\":{";
+            bool first = true;
+            for (int s = 0; s < STAGE_COUNT; s++) {
+                if (!(c.stages & (1 << s))) continue;
+                if (!first) json += ",";
+                first = false;
+                json += "\"" + String(getProfileStageName(s)) + "\":" + String(profileCyclesToUs(c.cycles[s]), 1);
+            }
+            json += "}}";
+        }
+        json += "]}";
+        request->send(200, "application/json", json);
+    });
+}
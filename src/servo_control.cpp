@@ -1,384 +1,1539 @@
 #include <SMS_STS.h>
+#include <Preferences.h>
 #include "servo_control.h"
+#include "angle_math.h"
+#include "telemetry_log.h"
+#include "telemetry_stream.h"
+#include "event_log.h"
+#include "task_monitor.h"
+#include "profiler.h"
+#include "boot_status.h"
+#include "position_journal.h"
 
-// Hardware configuration
+// Hardware configuration: servo bus 0 on Serial1, optional bus 1 on Serial2
 #define S_RXD 18
 #define S_TXD 19
+#ifndef SERVO_BUS2_ENABLED
+#define SERVO_BUS2_ENABLED 0   // build flag -DSERVO_BUS2_ENABLED=1 enables the second bus
+#endif
+#ifndef S2_RXD
+#define S2_RXD 16
+#endif
+#ifndef S2_TXD
+#define S2_TXD 17
+#endif
 
-// Motor ID - automatically detected on startup
-static int MOTOR_ID = 0;  // Default to 0, will be updated by scanForMotor()
-
-// Servo parameters from ST3215
-#define SERVO_STEPS 4096.0         // 0-4095 = 4096 Steps
-#define SERVO_ANGLE_RANGE 360.0    // Full rotation
+// Servo parameters from ST3215 (step/gear constants: see angle_math.h)
 #define SERVO_INIT_ACC 100
 #define SERVO_MAX_SPEED 4000
 #define SERVO_INIT_SPEED 2000
 
-// Gear ratio: 1:2 (180° gear = 360° motor = 1 full rotation)
-#define GEAR_RATIO 2.0
-
-// SMS_STS servo object
-SMS_STS st;
-
-// State variables
-s16 activeServoSpeed = 400;
-s16 currentTargetPosition = 0;
-s16 virtualZeroOffset = 0;
-bool reverseDirection = false;  // Reverse rotation direction
-s16 absolutePosition = 0;  // Absolute accumulated position for display
-s16 lastPosRead = 0;  // Last posRead value for delta calculation
-
-// Feedback variables
-s16 loadRead = 0;
-s16 speedRead = 0;
-byte voltageRead = 0;
-int currentRead = 0;
-s16 posRead = 0;
-s16 modeRead = 0;
-s16 temperRead = 0;
-
-// Motor block detection
-int feedbackRetries = 0;
-const int MAX_FEEDBACK_RETRIES = 10;
-bool motorBlocked = false;
-int consecutiveErrors = 0;
-const int ERROR_LOG_THRESHOLD = 100;
+// Bus scan range and timing
+#define SERVO_BAUD 1000000     // scan and default bus baud rate
+#define SERVO_POWER_UP_MS 200  // servo boot time after power-on, before the scan
+#define MAX_SCAN_ID 10
+#define SYNC_READ_TIMEOUT 3    // ms per missing reply (a reply takes ~0.2 ms at 1 MBaud)
+#define SERVO_IO_TIMEOUT 100   // ms, default for acknowledged single-servo commands
+
+// Fixed device numbering: build flag -DROTATOR_MAP=0x003,0x001,0x101 makes
+// Alpaca device n the n-th entry, (bus << 8) | servo ID - here ID 3 and ID 1
+// on bus 0, ID 1 on bus 1. Without it the scan numbers rotators in bus and ID order.
+#ifdef ROTATOR_MAP
+static constexpr uint16_t rotatorMap[] = {ROTATOR_MAP};
+#define ROTATOR_MAP_COUNT ((int)(sizeof(rotatorMap) / sizeof(rotatorMap[0])))
+static constexpr bool rotatorMapValid(int i = 0) {
+    return i == ROTATOR_MAP_COUNT
+        || ((rotatorMap[i] >> 8) < (SERVO_BUS2_ENABLED ? 2 : 1) && (rotatorMap[i] & 0xff) < 0xfe
+            && rotatorMapValid(i + 1));
+}
+static constexpr bool rotatorMapUnique(int i = 0, int j = 1) {
+    return i >= ROTATOR_MAP_COUNT - 1 ? true
+         : j == ROTATOR_MAP_COUNT ? rotatorMapUnique(i + 1, i + 2)
+         : rotatorMap[i] != rotatorMap[j] && rotatorMapUnique(i, j + 1);
+}
+static_assert(ROTATOR_MAP_COUNT <= MAX_ROTATORS, "ROTATOR_MAP: more entries than MAX_ROTATORS");
+static_assert(rotatorMapValid(), "ROTATOR_MAP: bus not enabled or servo ID out of range");
+static_assert(rotatorMapUnique(), "ROTATOR_MAP: the same bus and servo ID for two devices");
+#endif
+
+// EEPROM profile for motor mode, read and written as one register block
+#define PROFILE_FIRST SMS_STS_MIN_ANGLE_LIMIT_L
+#define PROFILE_LENGTH (SMS_STS_MODE - PROFILE_FIRST + 1)
+#define EEPROM_SETTLE_MS 50          // after the lock write, before the read-back
+#define UNCONDITIONAL_WRITES 10      // former setup: 6 register writes, 2 unlock/lock pairs
+#define UNCONDITIONAL_DELAY_MS 400   // former setup: fixed delays per rotator
+
+// Link health (see LinkHealth)
+#define LINK_OFFLINE_AFTER 5    // consecutive missed replies
+#define LINK_PROBE_MIN_MS 100   // first PING after going offline, doubled per miss
+#define LINK_PROBE_MAX_MS 5000
+
+// Bus task
+#define BUS_TASK_STACK 4096
+#define BUS_TASK_PRIORITY 3
+
+// One-shot boot task: scan and EEPROM setup run beside WiFi association
+#define SERVO_INIT_TASK_STACK 4096
+#define SERVO_INIT_TASK_PRIORITY 2
+#define BUS_TASK_BUDGET_US 5000     // one iteration: motion requests, moves and due polls
+#define BUS_IDLE_WAIT 1000     // ms, longest sleep between scheduler checks
+
+// Poll tiers (adaptive scheduling, rates in PollSchedule)
+#define MOTION_SPEED_THRESHOLD 10   // |speed| above this counts as moving
+#define SETTLE_TOLERANCE_STEPS 2    // remaining distance that counts as arrived
+#define BLOCK_MOTION_ADDR SMS_STS_PRESENT_POSITION_L   // position, speed, load
+#define BLOCK_MOTION_LEN (SMS_STS_PRESENT_LOAD_H - SMS_STS_PRESENT_POSITION_L + 1)
+#define BLOCK_SLOW_ADDR SMS_STS_PRESENT_VOLTAGE        // voltage, temperature, current
+#define BLOCK_SLOW_LEN (SMS_STS_PRESENT_CURRENT_H - SMS_STS_PRESENT_VOLTAGE + 1)
+#define BLOCK_FULL_ADDR SMS_STS_PRESENT_POSITION_L
+#define BLOCK_FULL_LEN (SMS_STS_PRESENT_CURRENT_H - SMS_STS_PRESENT_POSITION_L + 1)
+#define OCCUPANCY_WINDOW_US 1000000
+
+// Scheduling state of one poll tier on one bus
+struct PollTierState {
+    int64_t lastUs = 0;       // Last completed read
+    int64_t dueUs = 0;        // Next scheduled read
+    PollTierStats stats;
+};
+
+// One half-duplex servo bus: own UART, transport instance, lock and task
+struct ServoBus {
+    const char *name;
+    HardwareSerial *serial;
+    int rxPin;
+    int txPin;
+    bool enabled;
+    uint32_t baud = SERVO_BAUD;
+    SMS_STS st;
+    SemaphoreHandle_t lock = nullptr;     // Serializes transactions on this bus
+    TaskHandle_t task = nullptr;
+    u8 devs[MAX_ROTATORS];                // Rotator numbers on this bus
+    int devCount = 0;
+    uint32_t transactions = 0;
+    uint32_t errors = 0;                  // Missing or invalid replies
+    uint32_t samples = 0;
+
+    // Adaptive polling
+    PollTierState tiers[POLL_TIER_COUNT];
+    int64_t lastMotionUs = 0;             // Last move sent or speed seen on this bus
+    uint32_t busyUs = 0;                  // Bus time in the current occupancy window
+    int64_t windowStartUs = 0;
+    float occupancyPercent = 0;
+};
+
+static ServoBus buses[MAX_SERVO_BUSES] = {
+    {"bus0", &Serial1, S_RXD, S_TXD, true},
+    {"bus1", &Serial2, S2_RXD, S2_TXD, SERVO_BUS2_ENABLED != 0},
+};
+
+// Benchmark: when set, bus tasks share one lock (= one bus worth of bandwidth)
+static SemaphoreHandle_t serializeLock = nullptr;
+static volatile bool busesSerialized = false;
+static BusBenchResult benchResult;
+
+static PollSchedule pollSchedule;
+static volatile uint16_t streamPollMs = 0;   // set while a telemetry stream client is connected
+
+enum MotionKind : uint8_t { MOTION_NONE = 0, MOTION_TO, MOTION_BY, MOTION_HALT };
+
+// Per-rotator state
+struct Rotator {
+    u8 bus = 0;                      // Servo bus index
+    u8 id = 0;                       // Servo bus ID, automatically detected on startup
+    uint16_t model = 0;              // Model register, kept in the link cache; 0 = unknown
+    int32_t stepsPerRev = GEAR_STEPS_PER_REV;
+
+    // Position and motion state
+    s16 activeServoSpeed = 400;
+    int32_t currentTargetPosition = 0;
+    bool reverseDirection = false;   // Reverse rotation direction
+    int32_t absolutePosition = 0;    // Absolute accumulated position in steps
+
+    // Pending move (flushed by the bus task as one SyncWritePosEx)
+    bool movePending = false;
+    int32_t pendingMotorDelta = 0;
+    int32_t pendingLogicalDelta = 0;
+
+    // Deferred motion request (resolved by the bus task, see requestMoveTo)
+    MotionKind motionKind = MOTION_NONE;
+    int32_t motionSteps = 0;
+    int64_t motionQueuedUs = 0;
+    MotionKind applyingKind = MOTION_NONE;   // taken from the queue, move not pending yet
+    int32_t applyingSteps = 0;
+    int32_t unreadLogicalDelta = 0;  // flushed since the last position read: posRead does not include it yet
+    int64_t moveSentUs = 0;          // Last move written to the servo
+    int32_t lastMoveSteps = 0;       // Motor steps of that move
+    int64_t feedbackUs = 0;          // Start of the last successful position read
+
+    // Feedback variables
+    s16 loadRead = 0;
+    s16 speedRead = 0;
+    byte voltageRead = 0;
+    int currentRead = 0;
+    s16 posRead = 0;
+    s16 modeRead = 0;
+    s16 temperRead = 0;
+
+    // Link health
+    LinkHealth link;
+    int64_t probeDueUs = 0;
+
+    ServoConfigResult config;   // last EEPROM profile check
+    PositionRestore restore;    // journal entry applied at boot
+};
+
+static Rotator rotators[MAX_ROTATORS];
+static int rotatorCount = 1;
+static volatile bool servoReady = false;   // set once by the init task, rotators are hidden before
+static portMUX_TYPE pendingMux = portMUX_INITIALIZER_UNLOCKED;
+static MotionStats motionStats;
+
+static inline bool validDevice(int dev) {
+    return servoReady && dev >= 0 && dev < rotatorCount;
+}
+
+static inline bool offline(const Rotator &r) {
+    return r.link.state == LINK_OFFLINE;
+}
+
+static inline ServoBus &busOf(int dev) {
+    return buses[rotators[dev].bus];
+}
+
+static inline void lockBus(ServoBus &bus) {
+    xSemaphoreTakeRecursive(bus.lock, portMAX_DELAY);
+}
+
+static inline void unlockBus(ServoBus &bus) {
+    xSemaphoreGiveRecursive(bus.lock);
+}
 
 // ============================================================================
 // INITIALIZATION
 // ============================================================================
 
-int scanForMotor() {
-    Serial.println("\n=== Scanning for motor on bus ===");
-    for(int id = 0; id <= 10; id++) {
+// Bus layout of the last boot (NVS "rotators"/"link"): a warm boot checks
+// each cached servo with one short read instead of scanning all IDs
+#define LINK_CACHE_VERSION 1
+struct LinkCache {
+    uint8_t version;
+    uint8_t count;
+    uint32_t baud[MAX_SERVO_BUSES];   // 0: bus disabled
+    struct {
+        uint8_t bus;
+        uint8_t id;
+        uint16_t model;
+    } rotators[MAX_ROTATORS];
+};
+static LinkCache linkCache;           // as loaded at boot, zero = none
+static ServoLinkResult linkResult;
+
+static bool linkCacheValid() {
+    if(linkCache.version != LINK_CACHE_VERSION || linkCache.count == 0 || linkCache.count > MAX_ROTATORS) return false;
+#ifdef ROTATOR_MAP
+    // A layout from before the map was set numbers the rotators differently
+    if(linkCache.count != ROTATOR_MAP_COUNT) return false;
+    for(int dev = 0; dev < ROTATOR_MAP_COUNT; dev++) {
+        if(linkCache.rotators[dev].bus != rotatorMap[dev] >> 8 || linkCache.rotators[dev].id != (rotatorMap[dev] & 0xff)) {
+            return false;
+        }
+    }
+#endif
+    return true;
+}
+
+// Model, ID and baud registers in one read: answers like a PING and also
+// catches a different servo that took over the ID
+static bool restoreFromLinkCache() {
+    if(!linkCacheValid()) return false;
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) buses[b].devCount = 0;
+    for(int dev = 0; dev < linkCache.count; dev++) {
+        uint8_t b = linkCache.rotators[dev].bus;
+        u8 id = linkCache.rotators[dev].id;
+        if(b >= MAX_SERVO_BUSES || !buses[b].enabled) return false;
+        ServoBus &bus = buses[b];
+        u8 reg[SMS_STS_BAUD_RATE - SMS_STS_MODEL_L + 1];
+        bus.st.IOTimeOut = SYNC_READ_TIMEOUT;
+        bool ok = bus.st.Read(id, SMS_STS_MODEL_L, reg, sizeof(reg)) == sizeof(reg);
+        bus.st.IOTimeOut = SERVO_IO_TIMEOUT;
+        bus.transactions++;
+        uint16_t model = reg[0] | reg[1] << 8;
+        uint16_t cachedModel = linkCache.rotators[dev].model;   // 0: unknown at the scan, any model fits
+        if(!ok || reg[SMS_STS_ID - SMS_STS_MODEL_L] != id || (cachedModel && model != cachedModel)) {
+            LOG_W(LOG_TAG_SERVO, "Link cache: %s ID %d not answering as before, scanning", bus.name, id);
+            return false;
+        }
+        rotators[dev].bus = b;
+        rotators[dev].id = id;
+        rotators[dev].model = model;
+        bus.devs[bus.devCount++] = dev;
+    }
+    rotatorCount = linkCache.count;
+    return true;
+}
+
+// Read-compare-write: NVS is only written when the layout changed
+static void saveLinkCache() {
+    LinkCache cache;
+    memset(&cache, 0, sizeof(cache));   // padding too: compared and stored as bytes
+    cache.version = LINK_CACHE_VERSION;
+    cache.count = rotatorCount;
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) cache.baud[b] = buses[b].enabled ? buses[b].baud : 0;
+    for(int dev = 0; dev < rotatorCount; dev++) {
+        cache.rotators[dev].bus = rotators[dev].bus;
+        cache.rotators[dev].id = rotators[dev].id;
+        cache.rotators[dev].model = rotators[dev].model;
+    }
+    if(memcmp(&cache, &linkCache, sizeof(cache)) == 0) return;
+    Preferences prefs;
+    prefs.begin("rotators", false);
+    prefs.putBytes("link", &cache, sizeof(cache));
+    prefs.end();
+    linkCache = cache;
+}
+
+ServoLinkResult getServoLinkResult() {
+    return linkResult;
+}
+
+void forgetServoLinkCache() {
+    Preferences prefs;
+    prefs.begin("rotators", false);
+    prefs.remove("link");
+    prefs.end();
+}
+
+// Model register of a servo that just answered a PING; one retry, then 0
+// (unknown) so a failed read is never cached or reported as a model
+static uint16_t readModel(ServoBus &bus, u8 id) {
+    for(int attempt = 0; attempt < 2; attempt++) {
+        int model = bus.st.readWord(id, SMS_STS_MODEL_L);
+        if(model >= 0) return (uint16_t)model;
+    }
+    LOG_W(LOG_TAG_SERVO, "%s ID %d: model register not readable", bus.name, id);
+    return 0;
+}
+
+static int scanBus(int busIndex, int found) {
+    ServoBus &bus = buses[busIndex];
+    Serial.print("\n=== Scanning for motors on ");
+    Serial.print(bus.name);
+    Serial.println(" ===");
+    for(int id = 0; id <= MAX_SCAN_ID && found < MAX_ROTATORS; id++) {
         Serial.print("Trying ID ");
         Serial.print(id);
         Serial.print("... ");
-        
-        int result = st.FeedBack(id);
-        if(result != -1) {
-            s16 pos = st.ReadPos(-1);
-            s16 mode = st.ReadMode(id);
-            Serial.println("FOUND!");
-            Serial.print("  Position: ");
-            Serial.println(pos);
-            Serial.print("  Mode: ");
+
+        if(bus.st.Ping(id) != -1) {
+            s16 mode = bus.st.ReadMode(id);
+            Serial.print("FOUND! Mode: ");
             Serial.println(mode);
-            
-            // Automatically set the motor ID
-            MOTOR_ID = id;
-            Serial.print("\n>>> Motor-ID automatically set to: ");
-            Serial.print(MOTOR_ID);
-            Serial.println(" <<<\n");
-            return id;
+
+            // Automatically assign the next rotator/device number
+            rotators[found].bus = busIndex;
+            rotators[found].id = id;
+            rotators[found].model = readModel(bus, id);
+            bus.devs[bus.devCount++] = found;
+            Serial.print(">>> Rotator ");
+            Serial.print(found);
+            Serial.print(" = ");
+            Serial.print(bus.name);
+            Serial.print(" Motor-ID ");
+            Serial.print(id);
+            Serial.println(" <<<");
+            found++;
+            continue;
         }
         Serial.println("no response");
         delay(50);
     }
-    Serial.println("=== No motor found ===");
-    Serial.println("WARNING: Using default MOTOR_ID = 0\n");
-    MOTOR_ID = 0;  // Fallback to 0
-    return -1;
+    return found;
 }
 
-void initServo() {
-    Serial1.begin(1000000, SERIAL_8N1, S_RXD, S_TXD);
-    st.pSerial = &Serial1;
-    delay(200);
-    
-    while(!Serial1) {}
-
-    // Scan for motor to automatically detect ID
-    Serial.println("Checking motor connection...");
-    int foundID = scanForMotor();
-    if(foundID == -1) {
-        Serial.println("WARNING: No motor found! Check connections.");
-        Serial.println("Continuing with default MOTOR_ID = 0");
-    }
-    delay(500);
-
-    // Set angle limits for full range
-    Serial.println("Setting angle limits...");
-    st.unLockEprom(MOTOR_ID);
-    delay(50);
-    
-    // Register 9: Minimum Angle Limitation (0)
-    st.writeByte(MOTOR_ID, 9, 0);
-    st.writeByte(MOTOR_ID, 10, 0);
-    delay(50);
-    
-    // Register 11: Maximum Angle Limitation (4095)
-    st.writeByte(MOTOR_ID, 11, 4095 & 0xFF);
-    st.writeByte(MOTOR_ID, 12, (4095 >> 8) & 0xFF);
-    delay(50);
-    
-    st.LockEprom(MOTOR_ID);
-    delay(100);
-    
-    // Verify
-    s16 minAngle = st.readWord(MOTOR_ID, 9);
-    s16 maxAngle = st.readWord(MOTOR_ID, 11);
-    Serial.print("Min Angle: ");
-    Serial.print(minAngle);
-    Serial.print(", Max Angle: ");
-    Serial.println(maxAngle);
-    
-    // Set Motor-Mode (3) - ONLY MODE SUPPORTED
-    Serial.println("Setting Motor-Mode (3) - locked permanently...");
-    setMode(3);
-    delay(100);
-    
-    // Verify mode
-    modeRead = st.ReadMode(MOTOR_ID);
-    Serial.print("Current Mode: ");
-    Serial.println(modeRead);
-    
-    if(modeRead != 3) {
-        Serial.println("WARNING: Mode is not 3! Retrying...");
-        setMode(3);
-        delay(100);
-    }
-    
-    // Read current motor position and set as initial position
+#ifdef ROTATOR_MAP
+// Every entry becomes its device whether it answers or not, so the numbering
+// never shifts; a missing servo goes offline through link health as at runtime
+static int mapConfiguredMotors() {
+    for(int dev = 0; dev < ROTATOR_MAP_COUNT; dev++) {
+        uint8_t b = rotatorMap[dev] >> 8;
+        u8 id = rotatorMap[dev] & 0xff;
+        ServoBus &bus = buses[b];
+        int model = bus.st.readWord(id, SMS_STS_MODEL_L);
+        bus.transactions++;
+        rotators[dev].bus = b;
+        rotators[dev].id = id;
+        rotators[dev].model = model < 0 ? 0 : (uint16_t)model;
+        bus.devs[bus.devCount++] = dev;
+        if(model < 0) {
+            LOG_W(LOG_TAG_SERVO, "Rotator %d: %s ID %d from ROTATOR_MAP not answering", dev, bus.name, id);
+        } else {
+            LOG_I(LOG_TAG_SERVO, "Rotator %d: %s ID %d from ROTATOR_MAP", dev, bus.name, id);
+        }
+    }
+    rotatorCount = ROTATOR_MAP_COUNT;
+    return rotatorCount;
+}
+#endif
+
+int scanForMotors() {
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) {
+        buses[b].devCount = 0;
+        if(!buses[b].enabled) continue;
+        if(buses[b].baud != SERVO_BAUD) {
+            buses[b].baud = SERVO_BAUD;
+            buses[b].serial->updateBaudRate(SERVO_BAUD);
+        }
+    }
+#ifdef ROTATOR_MAP
+    return mapConfiguredMotors();
+#else
+    int found = 0;
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) {
+        if(buses[b].enabled) found = scanBus(b, found);
+    }
+    if(found == 0) {
+        Serial.println("=== No motor found ===");
+        Serial.println("WARNING: Using default MOTOR_ID = 0\n");
+        rotators[0].bus = 0;
+        rotators[0].id = 0;  // Fallback to 0
+        buses[0].devs[0] = 0;
+        buses[0].devCount = 1;
+        rotatorCount = 1;
+        return 0;
+    }
+    rotatorCount = found;
+    Serial.print("=== ");
+    Serial.print(found);
+    Serial.println(" rotator(s) found ===\n");
+    return found;
+#endif
+}
+
+static bool applyMotorProfile(int dev);
+
+// Journaled position of the last boot, checked against the remaining distance
+// the first feedback read reports; rotators without a usable entry stay at 0
+static void restorePositions() {
+    JournalEntry saved[MAX_ROTATORS];
+    int n = loadPositionJournal(saved, MAX_ROTATORS);
+    for(int dev = 0; dev < rotatorCount && dev < n; dev++) {
+        Rotator &r = rotators[dev];
+        PositionRestore &res = r.restore;
+        bool feedback = r.feedbackUs != 0;
+        res.residual = feedback ? r.posRead : 0;
+        res.inFlight = (saved[dev].flags & JOURNAL_IN_FLIGHT) != 0;
+        res.state = checkJournalEntry(saved[dev], r.bus, r.id, feedback, res.residual);
+        if(res.state != RESTORE_OK && res.state != RESTORE_UNVERIFIED) {
+            LOG_W(LOG_TAG_SERVO, "Rotator %d: journal not used (%s, residual %d%s), position set to 0", dev,
+                  restoreStateName(res.state), (int)res.residual, res.inFlight ? ", written mid-move" : "");
+            continue;
+        }
+        r.absolutePosition = saved[dev].position;
+        r.currentTargetPosition = saved[dev].motorTarget;
+        res.position = r.absolutePosition;
+        LOG_I(LOG_TAG_SERVO, "Rotator %d: position %ld steps from the journal (%s, residual %d)", dev,
+              (long)res.position, restoreStateName(res.state), (int)res.residual);
+    }
+}
+
+// Everything that waits for the servos: until it is done, getRotatorCount() is 0
+// and all per-rotator calls are no-ops, so nothing else touches the bus
+static void servoInitTask(void *param) {
+    // Warm boot: the servos of the last boot answer right away. Otherwise give
+    // them their power-up time, check again and scan for motors to detect the IDs
+    int64_t linkStart = esp_timer_get_time();
+    linkResult.cached = restoreFromLinkCache();
+    if(!linkResult.cached && linkCacheValid()) {
+        delay(SERVO_POWER_UP_MS);
+        linkResult.cached = restoreFromLinkCache();
+    }
+    if(!linkResult.cached) {
+        if(!linkCacheValid()) delay(SERVO_POWER_UP_MS);
+        Serial.println("Checking motor connection...");
+        if(scanForMotors() == 0) {
+            Serial.println("WARNING: No motor found! Check connections.");
+            Serial.println("Continuing with default MOTOR_ID = 0");
+        } else {
+            saveLinkCache();
+        }
+    } else {
+        saveLinkCache();   // writes only if a model unknown at the scan was read now
+    }
+    linkResult.linkUs = (uint32_t)(esp_timer_get_time() - linkStart);
+    LOG_I(LOG_TAG_SERVO, "Servo link: %d rotator(s) %s after %lu us", rotatorCount,
+          linkResult.cached ? "from cache" : "by scan", (unsigned long)linkResult.linkUs);
+
+    // Per-rotator gear ratio (motor revolutions per rotator revolution), default 1:2, see setGearRatio
+    Preferences prefs;
+    prefs.begin("rotators", true);
+    for(int dev = 0; dev < rotatorCount; dev++) {
+        char key[8];
+        snprintf(key, sizeof(key), "gear%d", dev);
+        uint8_t ratio = prefs.getUChar(key, GEAR_RATIO);
+        rotators[dev].stepsPerRev = SERVO_STEPS_PER_REV * (ratio > 0 && ratio <= GEAR_RATIO_MAX ? ratio : GEAR_RATIO);
+    }
+    if(prefs.getBytesLength("poll") == sizeof(pollSchedule)) {
+        prefs.getBytes("poll", &pollSchedule, sizeof(pollSchedule));
+    }
+    prefs.end();
+
+    for(int dev = 0; dev < rotatorCount; dev++) {
+        u8 motorID = rotators[dev].id;
+        Serial.print("Configuring rotator ");
+        Serial.print(dev);
+        Serial.print(" (");
+        Serial.print(busOf(dev).name);
+        Serial.print(" ID ");
+        Serial.print(motorID);
+        Serial.println(")");
+
+        // Motor mode (3) without angle limits - ONLY MODE SUPPORTED; EEPROM only written where it differs
+        if(!applyMotorProfile(dev)) {
+            Serial.println("WARNING: EEPROM profile not confirmed! Retrying...");
+            applyMotorProfile(dev);
+        }
+        const ServoConfigResult &cfg = rotators[dev].config;
+        if(cfg.bytesChanged == 0) {
+            LOG_I(LOG_TAG_SERVO, "Rotator %d: EEPROM profile matches, nothing written (%lu us)", dev,
+                  (unsigned long)cfg.durationUs);
+        } else {
+            LOG_I(LOG_TAG_SERVO, "Rotator %d: EEPROM %d bytes changed in %d writes (%lu us)", dev,
+                  cfg.bytesChanged, cfg.writes, (unsigned long)cfg.durationUs);
+        }
+        LOG_I(LOG_TAG_SERVO, "Rotator %d: setup %lu ms and %d EEPROM writes shorter than unconditional", dev,
+              (unsigned long)cfg.savedMs, cfg.writesAvoided);
+        Serial.print("Current Mode: ");
+        Serial.println(rotators[dev].modeRead);
+
+        rotators[dev].currentTargetPosition = 0;
+        rotators[dev].absolutePosition = 0;
+    }
+
+    // Read current motor positions, then continue from the journaled ones
     getFeedback();
-    currentTargetPosition = 0;
-    absolutePosition = 0;
-    lastPosRead = 0;
-    Serial.println("Motor-Mode (3) initialized - position set to 0°");
+    restorePositions();
+    Serial.println("Motor-Mode (3) initialized");
+
+    servoReady = true;
+    startServoBusTasks();
+    startPositionJournal();
+    bootStageDone(BOOT_SERVO);
+    vTaskDelete(nullptr);
+}
+
+void initServo() {
+    Preferences prefs;
+    prefs.begin("rotators", true);
+    if(prefs.getBytesLength("link") == sizeof(linkCache)) {
+        prefs.getBytes("link", &linkCache, sizeof(linkCache));
+    }
+    prefs.end();
+
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) {
+        ServoBus &bus = buses[b];
+        if(!bus.enabled) continue;
+        if(linkCacheValid() && linkCache.baud[b]) bus.baud = linkCache.baud[b];
+        bus.serial->begin(bus.baud, SERIAL_8N1, bus.rxPin, bus.txPin);
+        bus.st.pSerial = bus.serial;
+        bus.st.IOTimeOut = SERVO_IO_TIMEOUT;
+        bus.lock = xSemaphoreCreateRecursiveMutex();
+    }
+    serializeLock = xSemaphoreCreateMutex();
+    xTaskCreatePinnedToCore(servoInitTask, "servoinit", SERVO_INIT_TASK_STACK, nullptr,
+                            SERVO_INIT_TASK_PRIORITY, nullptr, TASK_CORE_MOTION);
+}
+
+bool isServoReady() {
+    return servoReady;
+}
+
+int getRotatorCount() {
+    return servoReady ? rotatorCount : 0;
 }
 
 // ============================================================================
 // MODE CONTROL
 // ============================================================================
 
-void setMode(int mode) {
+void setMode(int dev, int mode) {
+    if(!validDevice(dev)) return;
+
     // This driver ONLY supports Motor-Mode (Mode 3)
     if(mode != 3) {
         Serial.println("ERROR: Only Motor-Mode (3) is supported!");
         Serial.println("Forcing Mode 3...");
         mode = 3;
     }
-    
-    st.unLockEprom(MOTOR_ID);
-    st.writeByte(MOTOR_ID, SMS_STS_MODE, 3);
-    st.writeWord(MOTOR_ID, 11, 0);  // Max angle = 0 for motor mode
-    st.LockEprom(MOTOR_ID);
-    delay(50);
-    
-    Serial.println("Motor-Mode (3) set and locked");
+    if(applyMotorProfile(dev)) {
+        Serial.println("Motor-Mode (3) set and locked");
+    }
+}
+
+// Motor mode: no angle limits (min = max = 0), mode 3
+struct EepromSetting {
+    u8 addr;
+    u8 value;
+};
+static const EepromSetting motorProfile[] = {
+    {SMS_STS_MIN_ANGLE_LIMIT_L, 0}, {SMS_STS_MIN_ANGLE_LIMIT_H, 0},
+    {SMS_STS_MAX_ANGLE_LIMIT_L, 0}, {SMS_STS_MAX_ANGLE_LIMIT_H, 0},
+    {SMS_STS_MODE, 3},
+};
+#define PROFILE_SETTINGS (sizeof(motorProfile) / sizeof(motorProfile[0]))
+
+static int profileMismatches(const u8 *block) {
+    int n = 0;
+    for(size_t i = 0; i < PROFILE_SETTINGS; i++) {
+        if(block[motorProfile[i].addr - PROFILE_FIRST] != motorProfile[i].value) n++;
+    }
+    return n;
+}
+
+// Read-compare-write: the profile block is read in one transaction, only the
+// differing registers are written (adjacent ones in one command) and the
+// EEPROM is unlocked only when something differs. Each EEPROM write costs the
+// servo a flash cycle. False when the block cannot be read or still differs.
+static bool applyMotorProfile(int dev) {
+    Rotator &r = rotators[dev];
+    ServoBus &bus = busOf(dev);
+    ServoConfigResult result;
+    int64_t start = esp_timer_get_time();
+    u8 block[PROFILE_LENGTH];
+
+    lockBus(bus);
+    bool ok = bus.st.Read(r.id, PROFILE_FIRST, block, PROFILE_LENGTH) == PROFILE_LENGTH;
+    if(ok && profileMismatches(block) > 0) {
+        bus.st.unLockEprom(r.id);
+        result.writes++;
+        for(size_t i = 0; i < PROFILE_SETTINGS;) {
+            if(block[motorProfile[i].addr - PROFILE_FIRST] == motorProfile[i].value) {
+                i++;
+                continue;
+            }
+            u8 addr = motorProfile[i].addr;
+            u8 data[PROFILE_SETTINGS];
+            u8 len = 0;
+            while(i < PROFILE_SETTINGS && motorProfile[i].addr == addr + len &&
+                  block[motorProfile[i].addr - PROFILE_FIRST] != motorProfile[i].value) {
+                data[len++] = motorProfile[i++].value;
+            }
+            bus.st.genWrite(r.id, addr, data, len);
+            result.writes++;
+            result.bytesChanged += len;
+        }
+        bus.st.LockEprom(r.id);
+        result.writes++;
+        unlockBus(bus);
+        delay(EEPROM_SETTLE_MS);
+        lockBus(bus);
+        ok = bus.st.Read(r.id, PROFILE_FIRST, block, PROFILE_LENGTH) == PROFILE_LENGTH;
+    }
+    unlockBus(bus);
+
+    result.verified = ok && profileMismatches(block) == 0;
+    if(ok) r.modeRead = block[SMS_STS_MODE - PROFILE_FIRST];
+    result.durationUs = (uint32_t)(esp_timer_get_time() - start);
+    result.writesAvoided = UNCONDITIONAL_WRITES > result.writes ? UNCONDITIONAL_WRITES - result.writes : 0;
+    uint32_t ms = result.durationUs / 1000;
+    result.savedMs = UNCONDITIONAL_DELAY_MS > ms ? UNCONDITIONAL_DELAY_MS - ms : 0;
+    r.config = result;
+    return result.verified;
+}
+
+ServoConfigResult getServoConfigResult(int dev) {
+    return validDevice(dev) ? rotators[dev].config : ServoConfigResult();
 }
 
 // ============================================================================
 // FEEDBACK & STATUS
 // ============================================================================
 
-void getFeedback() {
-    int result = st.FeedBack(MOTOR_ID);
-    
-    if(result != -1) {
-        posRead = st.ReadPos(-1);
-        speedRead = st.ReadSpeed(-1);
-        loadRead = st.ReadLoad(-1);
-        voltageRead = st.ReadVoltage(-1);
-        currentRead = st.ReadCurrent(-1);
-        temperRead = st.ReadTemper(-1);
-        modeRead = st.ReadMode(MOTOR_ID);
-        
-        feedbackRetries = 0;
-        consecutiveErrors = 0;
-        motorBlocked = false;
-        
+static void feedbackFailed(int dev) {
+    Rotator &r = rotators[dev];
+    r.link.consecutiveErrors++;
+    busOf(dev).errors++;
+    if(offline(r)) return;
+
+    int64_t now = esp_timer_get_time();
+    if(r.link.consecutiveErrors < LINK_OFFLINE_AFTER) {
+        if(r.link.state == LINK_ONLINE) r.link.changedUs = now;
+        r.link.state = LINK_DEGRADED;
+        return;
+    }
+    r.link.state = LINK_OFFLINE;
+    r.link.changedUs = now;
+    r.link.outages++;
+    r.link.probeIntervalMs = LINK_PROBE_MIN_MS;
+    r.probeDueUs = now + LINK_PROBE_MIN_MS * 1000;
+    LOG_E(LOG_TAG_SERVO, "Rotator %d (%s ID %d): no reply %lu times, offline. Check motor power, RX/TX wiring, motor ID",
+          dev, busOf(dev).name, r.id, (unsigned long)r.link.consecutiveErrors);
+}
+
+static void feedbackOk(Rotator &r) {
+    r.link.consecutiveErrors = 0;
+    if(r.link.state == LINK_ONLINE) return;
+    r.link.state = LINK_ONLINE;
+    r.link.changedUs = esp_timer_get_time();
+    r.link.probeIntervalMs = 0;
+}
+
+// Bus task: one short PING per offline rotator whose probe is due. Returns the
+// time of the next probe; restores answering rotators (the caller reads them).
+static int64_t probeOffline(ServoBus &bus, int64_t now, bool &restored) {
+    int64_t next = INT64_MAX;
+    for(int i = 0; i < bus.devCount; i++) {
+        int dev = bus.devs[i];
+        Rotator &r = rotators[dev];
+        if(!offline(r)) continue;
+        if(now < r.probeDueUs) {
+            if(r.probeDueUs < next) next = r.probeDueUs;
+            continue;
+        }
+
+        bus.st.IOTimeOut = SYNC_READ_TIMEOUT;
+        bool answered = bus.st.Ping(r.id) != -1;
+        bus.st.IOTimeOut = SERVO_IO_TIMEOUT;
+        bus.transactions++;
+        r.link.probes++;
+
+        if(answered) {
+            uint32_t downMs = (uint32_t)((now - r.link.changedUs) / 1000);
+            feedbackOk(r);
+            restored = true;
+            LOG_I(LOG_TAG_SERVO, "Rotator %d (%s ID %d): answering again after %lu ms", dev, bus.name, r.id,
+                  (unsigned long)downMs);
+            continue;
+        }
+        r.link.probeIntervalMs = r.link.probeIntervalMs * 2 > LINK_PROBE_MAX_MS ? LINK_PROBE_MAX_MS : r.link.probeIntervalMs * 2;
+        r.probeDueUs = now + (int64_t)r.link.probeIntervalMs * 1000;
+        if(r.probeDueUs < next) next = r.probeDueUs;
+    }
+    return next;
+}
+
+static void recordTelemetry(int dev, uint8_t status) {
+    Rotator &r = rotators[dev];
+    TelemetrySample sample;
+    sample.timeUs = esp_timer_get_time();
+    portENTER_CRITICAL(&pendingMux);   // same position as getMotionState
+    sample.position = r.absolutePosition - r.unreadLogicalDelta - r.posRead;
+    portEXIT_CRITICAL(&pendingMux);
+    sample.speed = r.speedRead;
+    sample.load = r.loadRead;
+    sample.current = r.currentRead;
+    sample.voltage = r.voltageRead;
+    sample.temperature = r.temperRead;
+    sample.status = status;
+    if(abs(r.speedRead) > 10) sample.status |= TELEMETRY_STATUS_MOVING;
+    if(offline(r)) sample.status |= TELEMETRY_STATUS_BLOCKED;
+    if(abs(r.loadRead) > 800) sample.status |= TELEMETRY_STATUS_HIGH_LOAD;
+    sample.dev = dev;
+    telemetryRecord(sample);
+    telemetryStreamRecord(sample);
+}
+
+// Interval statistics of a tier, updated after each completed read
+static void markTier(ServoBus &bus, int tier, int64_t now) {
+    PollTierState &t = bus.tiers[tier];
+    if(t.lastUs != 0) {
+        uint32_t interval = (uint32_t)(now - t.lastUs);
+        PollTierStats &st = t.stats;
+        st.lastIntervalUs = interval;
+        st.avgIntervalUs = st.avgIntervalUs ? st.avgIntervalUs - st.avgIntervalUs / 8 + interval / 8 : interval;
+        if(interval > st.maxIntervalUs) st.maxIntervalUs = interval;
+    }
+    t.stats.count++;
+    t.lastUs = now;
+}
+
+static inline bool busMoving(const ServoBus &bus, int64_t now) {
+    return bus.lastMotionUs != 0 && now - bus.lastMotionUs < (int64_t)pollSchedule.lingerMs * 1000;
+}
+
+// One SYNC_READ transaction of registers [addr, addr+len) for all rotators on
+// this bus that are not offline: the request goes out once, the servos answer
+// back-to-back. Only the fields inside the range are decoded. A missing servo
+// only costs SYNC_READ_TIMEOUT until it is offline, then nothing.
+static void readBlock(ServoBus &bus, u8 addr, u8 len) {
+    u8 ids[MAX_ROTATORS];
+    int devs[MAX_ROTATORS];
+    int n = 0;
+    for(int i = 0; i < bus.devCount; i++) {
+        if(offline(rotators[bus.devs[i]])) continue;
+        devs[n] = bus.devs[i];
+        ids[n++] = rotators[bus.devs[i]].id;
+    }
+    bool hasMotion = addr <= SMS_STS_PRESENT_POSITION_L;
+    bool hasSlow = addr + len > SMS_STS_PRESENT_VOLTAGE;
+    int64_t start = esp_timer_get_time();
+
+    // All offline: no transaction, the schedule moves on (probes run separately)
+    if(n == 0) {
+        if(hasMotion) bus.tiers[POLL_TIER_POSITION].lastUs = start;
+        if(hasSlow) bus.tiers[POLL_TIER_SLOW].lastUs = start;
+        return;
+    }
+
+    bus.st.IOTimeOut = SYNC_READ_TIMEOUT;
+    bus.st.SyncFeedBackTx(ids, n, addr, len);
+    for(int i = 0; i < n; i++) {
+        int dev = devs[i];
+        Rotator &r = rotators[dev];
+        if(bus.st.SyncFeedBackRx(r.id) == -1) {
+            feedbackFailed(dev);
+            if(hasMotion) recordTelemetry(dev, TELEMETRY_STATUS_COMM_ERROR);
+            continue;
+        }
+        if(hasMotion) {
+            s16 pos = bus.st.ReadPos(-1);
+            portENTER_CRITICAL(&pendingMux);
+            r.posRead = pos;
+            r.unreadLogicalDelta = 0;   // the remaining distance now covers every flushed move
+            r.feedbackUs = start;
+            portEXIT_CRITICAL(&pendingMux);
+            r.speedRead = bus.st.ReadSpeed(-1);
+            r.loadRead = bus.st.ReadLoad(-1);
+        }
+        if(hasSlow) {
+            r.voltageRead = bus.st.ReadVoltage(-1);
+            r.currentRead = bus.st.ReadCurrent(-1);
+            r.temperRead = bus.st.ReadTemper(-1);
+        }
+
+        feedbackOk(r);
+        if(!hasMotion) continue;
+
+        bus.samples++;
+        recordTelemetry(dev, 0);
+        if(abs(r.speedRead) > MOTION_SPEED_THRESHOLD) {
+            bus.lastMotionUs = start;
+        }
+
         // Check for motor blockage via high load
-        if(abs(loadRead) > 800) {
-            Serial.print("Warning: High load (");
-            Serial.print(loadRead);
-            Serial.println("). Motor may be blocked!");
+        if(abs(r.loadRead) > 800) {
+            LOG_W(LOG_TAG_SERVO, "Rotator %d high load (%d). Motor may be blocked!", dev, r.loadRead);
         }
-    } else {
-        feedbackRetries++;
-        consecutiveErrors++;
-        
-        if(feedbackRetries >= MAX_FEEDBACK_RETRIES) {
-            motorBlocked = true;
-            // Only log error every ERROR_LOG_THRESHOLD times to avoid spam
-            if(consecutiveErrors % ERROR_LOG_THRESHOLD == 1) {
-                Serial.println("\n=== MOTOR COMMUNICATION ERROR ===");
-                Serial.print("FeedBack failed ");
-                Serial.print(consecutiveErrors);
-                Serial.println(" times");
-                Serial.print("Trying MOTOR_ID = ");
-                Serial.println(MOTOR_ID);
-                Serial.println("Check: 1) Motor power, 2) RX/TX wiring, 3) Motor ID");
-                Serial.println("================================\n");
-            }
+    }
+    bus.st.IOTimeOut = SERVO_IO_TIMEOUT;
+    bus.transactions++;
+
+    int64_t now = esp_timer_get_time();
+    bus.busyUs += (uint32_t)(now - start);
+    if(hasMotion) markTier(bus, POLL_TIER_POSITION, now);
+    if(hasSlow) markTier(bus, POLL_TIER_SLOW, now);
+}
+
+// Mode register is not part of the feedback block: one read per rotator
+static void readModes(ServoBus &bus) {
+    int64_t start = esp_timer_get_time();
+    for(int i = 0; i < bus.devCount; i++) {
+        Rotator &r = rotators[bus.devs[i]];
+        if(offline(r)) continue;
+        int mode = bus.st.ReadMode(r.id);
+        if(mode != -1) {
+            r.modeRead = mode;
         }
+        bus.transactions++;
     }
+    int64_t now = esp_timer_get_time();
+    bus.busyUs += (uint32_t)(now - start);
+    markTier(bus, POLL_TIER_MODE, now);
 }
 
-bool isServoMoving() {
-    getFeedback();
-    return (abs(speedRead) > 10); // Consider moving if speed > 10
+// On-demand read of the complete feedback block (handlers, init)
+static void pollBus(ServoBus &bus) {
+    if(bus.devCount == 0) return;
+    lockBus(bus);
+    readBlock(bus, BLOCK_FULL_ADDR, BLOCK_FULL_LEN);
+    unlockBus(bus);
 }
 
-bool isMotorBlocked() {
-    return motorBlocked;
+// Scheduled reads of the bus task. Returns the time of the next due read.
+static int64_t pollBusScheduled(ServoBus &bus) {
+    if(bus.devCount == 0) return esp_timer_get_time() + (int64_t)BUS_IDLE_WAIT * 1000;
+
+    lockBus(bus);
+    int64_t now = esp_timer_get_time();
+    PollTierState &pos = bus.tiers[POLL_TIER_POSITION];
+    PollTierState &slow = bus.tiers[POLL_TIER_SLOW];
+    PollTierState &mode = bus.tiers[POLL_TIER_MODE];
+    bool flatOut = benchResult.running;  // Benchmark measures raw bus throughput
+
+    // A rotator that answers a probe gets every tier read right away
+    bool restored = false;
+    int64_t probeDue = probeOffline(bus, now, restored);
+    if(restored) {
+        pos.dueUs = slow.dueUs = mode.dueUs = 0;
+    }
+
+    // Both tiers due: one transaction for both blocks; otherwise each reads only its own
+    bool posDue = flatOut || now >= pos.dueUs;
+    bool slowDue = now >= slow.dueUs;
+    if(posDue && slowDue) {
+        readBlock(bus, BLOCK_FULL_ADDR, BLOCK_FULL_LEN);
+    } else if(slowDue) {
+        readBlock(bus, BLOCK_SLOW_ADDR, BLOCK_SLOW_LEN);
+    } else if(posDue) {
+        readBlock(bus, BLOCK_MOTION_ADDR, BLOCK_MOTION_LEN);
+    }
+    if(now >= mode.dueUs) {
+        readModes(bus);
+    }
+
+    // On-demand reads in between count as fresh, so the schedule is relative to the last read
+    uint32_t posMs = busMoving(bus, esp_timer_get_time()) ? pollSchedule.motionMs : pollSchedule.idleMs;
+    if(streamPollMs && streamPollMs < posMs) posMs = streamPollMs;
+    pos.dueUs = pos.lastUs + (int64_t)posMs * 1000;
+    slow.dueUs = slow.lastUs + (int64_t)pollSchedule.slowMs * 1000;
+    mode.dueUs = mode.lastUs + (int64_t)pollSchedule.modeMs * 1000;
+
+    now = esp_timer_get_time();
+    if(now - bus.windowStartUs >= OCCUPANCY_WINDOW_US) {
+        bus.occupancyPercent = bus.windowStartUs ? bus.busyUs * 100.0f / (now - bus.windowStartUs) : 0;
+        bus.busyUs = 0;
+        bus.windowStartUs = now;
+    }
+    unlockBus(bus);
+
+    int64_t next = pos.dueUs;
+    if(slow.dueUs < next) next = slow.dueUs;
+    if(mode.dueUs < next) next = mode.dueUs;
+    if(probeDue < next) next = probeDue;
+    return flatOut ? now : next;
+}
+
+PollSchedule getPollSchedule() {
+    return pollSchedule;
+}
+
+void setPollSchedule(const PollSchedule &schedule) {
+    pollSchedule.motionMs = constrain(schedule.motionMs, 1, 1000);
+    pollSchedule.idleMs = constrain(schedule.idleMs, pollSchedule.motionMs, 60000);
+    pollSchedule.slowMs = constrain(schedule.slowMs, 100, 600000);
+    pollSchedule.modeMs = constrain(schedule.modeMs, 100, 600000);
+    pollSchedule.lingerMs = constrain(schedule.lingerMs, 0, 60000);
+
+    Preferences prefs;
+    prefs.begin("rotators", false);
+    prefs.putBytes("poll", &pollSchedule, sizeof(pollSchedule));
+    prefs.end();
+
+    // Restart the achieved-interval statistics and apply the new rates now
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) {
+        if(!buses[b].enabled || !buses[b].lock) continue;   // disabled bus: no lock was created
+        lockBus(buses[b]);
+        for(int t = 0; t < POLL_TIER_COUNT; t++) {
+            buses[b].tiers[t].stats = PollTierStats();
+            buses[b].tiers[t].dueUs = 0;
+        }
+        unlockBus(buses[b]);
+        if(buses[b].task) xTaskNotifyGive(buses[b].task);
+    }
+}
+
+BusPollStats getBusPollStats(int bus) {
+    BusPollStats result;
+    if(bus < 0 || bus >= MAX_SERVO_BUSES) return result;
+    ServoBus &b = buses[bus];
+    result.enabled = b.enabled;
+    result.rotators = b.devCount;
+    if(!b.enabled || !b.lock) return result;
+    lockBus(b);
+    result.moving = busMoving(b, esp_timer_get_time());
+    result.occupancyPercent = b.occupancyPercent;
+    result.transactions = b.transactions;
+    result.errors = b.errors;
+    for(int t = 0; t < POLL_TIER_COUNT; t++) {
+        result.tiers[t] = b.tiers[t].stats;
+    }
+    unlockBus(b);
+    return result;
+}
+
+void setStreamPollInterval(uint16_t ms) {
+    streamPollMs = ms;
+}
+
+void getFeedback() {
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) {
+        if(buses[b].enabled) {
+            pollBus(buses[b]);
+        }
+    }
+}
+
+static inline bool isMove(MotionKind kind) {
+    return kind == MOTION_TO || kind == MOTION_BY;
+}
+
+// Target a queued request leads to, seen from the current position
+static int32_t resolveMotion(MotionKind kind, int32_t steps, int32_t position, int32_t target) {
+    switch(kind) {
+        case MOTION_TO: return steps;
+        case MOTION_BY: return position + steps;
+        case MOTION_HALT: return position;
+        default: return target;
+    }
+}
+
+// Position, target and motion from the polled state and the motion queue.
+// A request counts as moving from the moment it is queued, through the bus
+// task applying and flushing it, until a read taken after the write shows
+// the rotator stopped at the target. No bus access.
+struct MotionState {
+    int32_t position;   // not wrapped
+    int32_t target;
+    bool moving;
+    int64_t readUs;     // esp_timer time of the position read
+};
+
+static MotionState getMotionState(const Rotator &r) {
+    MotionState m;
+    portENTER_CRITICAL(&pendingMux);
+    m.position = r.absolutePosition - r.unreadLogicalDelta - r.posRead;
+    m.target = r.absolutePosition + (r.movePending ? r.pendingLogicalDelta : 0);
+    m.target = resolveMotion(r.applyingKind, r.applyingSteps, m.position, m.target);
+    m.target = resolveMotion(r.motionKind, r.motionSteps, m.position, m.target);
+    bool queued = r.movePending || isMove(r.applyingKind) || isMove(r.motionKind);
+    bool unread = r.unreadLogicalDelta != 0 || (r.moveSentUs && r.feedbackUs <= r.moveSentUs);
+    m.readUs = r.feedbackUs;
+    portEXIT_CRITICAL(&pendingMux);
+    m.moving = !offline(r) && (queued || unread || abs(r.speedRead) > MOTION_SPEED_THRESHOLD
+                               || (r.moveSentUs && abs(r.posRead) > SETTLE_TOLERANCE_STEPS));
+    return m;
+}
+
+bool isServoMoving(int dev) {
+    if(!validDevice(dev)) return false;
+    return getMotionState(rotators[dev]).moving;
+}
+
+bool isMotorBlocked(int dev) {
+    return validDevice(dev) && offline(rotators[dev]);
+}
+
+bool isFeedbackStale(int dev) {
+    return isMotorBlocked(dev);
 }
 
-int getServoLoad() { return loadRead; }
-int getServoSpeed() { return speedRead; }
-int getServoVoltage() { return voltageRead; }
-int getServoCurrent() { return currentRead; }
-int getServoTemperature() { return temperRead; }
-int getServoMode() { return modeRead; }
-int getMotorID() { return MOTOR_ID; }
+// Copied without the bus lock like the other polled values: the metrics
+// response calls this from async_tcp and must not wait for a bus transaction
+LinkHealth getLinkHealth(int dev) {
+    return validDevice(dev) ? rotators[dev].link : LinkHealth();
+}
 
-void setReverseDirection(bool reverse) { reverseDirection = reverse; }
-bool getReverseDirection() { return reverseDirection; }
+const char *linkStateName(LinkState state) {
+    switch(state) {
+        case LINK_ONLINE: return "online";
+        case LINK_DEGRADED: return "degraded";
+        case LINK_OFFLINE: return "offline";
+    }
+    return "?";
+}
+
+int getServoLoad(int dev) { return validDevice(dev) ? rotators[dev].loadRead : 0; }
+int getServoSpeed(int dev) { return validDevice(dev) ? rotators[dev].speedRead : 0; }
+int getServoVoltage(int dev) { return validDevice(dev) ? rotators[dev].voltageRead : 0; }
+int getServoCurrent(int dev) { return validDevice(dev) ? rotators[dev].currentRead : 0; }
+int getServoTemperature(int dev) { return validDevice(dev) ? rotators[dev].temperRead : 0; }
+int getServoMode(int dev) { return validDevice(dev) ? rotators[dev].modeRead : 0; }
+int getMotorID(int dev) { return validDevice(dev) ? rotators[dev].id : -1; }
+int getServoModel(int dev) { return validDevice(dev) ? rotators[dev].model : 0; }
+int getServoBus(int dev) { return validDevice(dev) ? rotators[dev].bus : -1; }
+int32_t getStepsPerRev(int dev) { return validDevice(dev) ? rotators[dev].stepsPerRev : GEAR_STEPS_PER_REV; }
+int getGearRatio(int dev) { return getStepsPerRev(dev) / SERVO_STEPS_PER_REV; }
+
+// Positions are kept in motor steps: the same count means a different
+// rotator angle afterwards, which is why a moving rotator is refused
+bool setGearRatio(int dev, int ratio) {
+    if(!validDevice(dev) || ratio < 1 || ratio > GEAR_RATIO_MAX || isServoMoving(dev)) return false;
+    rotators[dev].stepsPerRev = SERVO_STEPS_PER_REV * ratio;
+    char key[8];
+    snprintf(key, sizeof(key), "gear%d", dev);
+    Preferences prefs;
+    prefs.begin("rotators", false);
+    prefs.putUChar(key, (uint8_t)ratio);
+    prefs.end();
+    LOG_I(LOG_TAG_SERVO, "Rotator %d gear ratio 1:%d", dev, ratio);
+    return true;
+}
+
+void setReverseDirection(int dev, bool reverse) {
+    if(validDevice(dev)) rotators[dev].reverseDirection = reverse;
+}
+
+bool getReverseDirection(int dev) {
+    return validDevice(dev) && rotators[dev].reverseDirection;
+}
 
 // ============================================================================
 // MOVEMENT FUNCTIONS
 // ============================================================================
 
-void gotoPosition(int targetPosition, int currentPos) {
+static void queueMove(int dev, int32_t motorDelta, int32_t logicalDelta) {
+    // Latest request per rotator wins; the bus task sends all pending moves
+    // of its bus together so simultaneous moves start on the same bus frame.
+    portENTER_CRITICAL(&pendingMux);
+    Rotator &r = rotators[dev];
+    r.pendingMotorDelta = motorDelta;
+    r.pendingLogicalDelta = logicalDelta;
+    r.movePending = true;
+    portEXIT_CRITICAL(&pendingMux);
+    if(busOf(dev).task) {
+        xTaskNotifyGive(busOf(dev).task);
+    }
+}
+
+static void flushPendingMoves(ServoBus &bus) {
+    u8 ids[MAX_ROTATORS];
+    s16 positions[MAX_ROTATORS];
+    u16 speeds[MAX_ROTATORS];
+    u8 accs[MAX_ROTATORS];
+    u8 moved[MAX_ROTATORS];
+    int n = 0;
+
+    portENTER_CRITICAL(&pendingMux);
+    for(int i = 0; i < bus.devCount; i++) {
+        Rotator &r = rotators[bus.devs[i]];
+        if(!r.movePending) continue;
+        if(offline(r)) {
+            r.movePending = false;   // would only wait for the ACK timeout
+            continue;
+        }
+        moved[n] = bus.devs[i];
+        ids[n] = r.id;
+        positions[n] = (s16)r.pendingMotorDelta;
+        speeds[n] = r.activeServoSpeed;
+        accs[n] = SERVO_INIT_ACC;
+        n++;
+        r.currentTargetPosition += r.pendingMotorDelta;
+        r.absolutePosition += r.pendingLogicalDelta;  // Always use logical delta for position tracking
+        r.unreadLogicalDelta += r.pendingLogicalDelta;
+        r.lastMoveSteps = r.pendingMotorDelta;
+        r.movePending = false;
+    }
+    portEXIT_CRITICAL(&pendingMux);
+
+    if(n == 0) return;
+    lockBus(bus);
+    if(n == 1) {
+        bus.st.WritePosEx(ids[0], positions[0], speeds[0], accs[0]);
+    } else {
+        bus.st.SyncWritePosEx(ids, n, positions, speeds, accs);
+    }
+    bus.transactions++;
+
+    // Switch to the motion rate right away, first read one motion interval later
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&pendingMux);
+    for(int i = 0; i < n; i++) {
+        rotators[moved[i]].moveSentUs = now;
+    }
+    portEXIT_CRITICAL(&pendingMux);
+    bus.lastMotionUs = now;
+    bus.tiers[POLL_TIER_POSITION].dueUs = now + (int64_t)pollSchedule.motionMs * 1000;
+    unlockBus(bus);
+}
+
+// ============================================================================
+// DEFERRED MOTION REQUESTS
+// ============================================================================
+
+static void postMotion(int dev, MotionKind kind, int32_t steps) {
+    if(!validDevice(dev)) return;
+    Rotator &r = rotators[dev];
+    portENTER_CRITICAL(&pendingMux);
+    if(r.motionKind != MOTION_NONE) {
+        motionStats.merged++;
+    } else {
+        r.motionQueuedUs = esp_timer_get_time();
+    }
+    if(kind == MOTION_BY && (r.motionKind == MOTION_BY || r.motionKind == MOTION_TO)) {
+        r.motionSteps += steps;    // Relative to the queued move
+    } else {
+        r.motionKind = kind;       // A new move supersedes a queued halt as it would a running one
+        r.motionSteps = steps;
+    }
+    motionStats.requests++;
+    portEXIT_CRITICAL(&pendingMux);
+    if(busOf(dev).task) {
+        xTaskNotifyGive(busOf(dev).task);
+    }
+}
+
+void requestMoveTo(int dev, int32_t targetSteps) { postMotion(dev, MOTION_TO, targetSteps); }
+void requestMoveBy(int dev, int32_t deltaSteps) { postMotion(dev, MOTION_BY, deltaSteps); }
+void requestHalt(int dev) { postMotion(dev, MOTION_HALT, 0); }
+
+// Bus task: turn queued requests into moves against fresh feedback
+static void applyMotionRequests(ServoBus &bus) {
+    for(int i = 0; i < bus.devCount; i++) {
+        int dev = bus.devs[i];
+        Rotator &r = rotators[dev];
+
+        // Until the move is pending it stays visible to getMotionState() as being applied
+        portENTER_CRITICAL(&pendingMux);
+        MotionKind kind = r.motionKind;
+        int32_t steps = r.motionSteps;
+        int64_t queuedUs = r.motionQueuedUs;
+        r.motionKind = MOTION_NONE;
+        r.applyingKind = kind;
+        r.applyingSteps = steps;
+        portEXIT_CRITICAL(&pendingMux);
+
+        if(kind != MOTION_NONE && offline(r)) {
+            LOG_W(LOG_TAG_SERVO, "Rotator %d offline: motion request dropped", dev);
+            kind = MOTION_NONE;
+        }
+        switch(kind) {
+            case MOTION_NONE: break;
+            case MOTION_TO: moveServoToSteps(dev, steps); break;
+            case MOTION_BY: moveServoToSteps(dev, getServoSteps(dev) + steps); break;
+            case MOTION_HALT: stopServo(dev); break;
+        }
+        portENTER_CRITICAL(&pendingMux);
+        r.applyingKind = MOTION_NONE;
+        portEXIT_CRITICAL(&pendingMux);
+        if(kind == MOTION_NONE) continue;
+
+        uint32_t delay = (uint32_t)(esp_timer_get_time() - queuedUs);
+        motionStats.applied++;
+        motionStats.lastDelayUs = delay;
+        if(delay > motionStats.maxDelayUs) motionStats.maxDelayUs = delay;
+    }
+}
+
+MotionStats getMotionStats() {
+    return motionStats;
+}
+
+void resetMotionStats() {
+    motionStats = MotionStats();
+}
+
+// ============================================================================
+// BUS TASKS
+// ============================================================================
+
+static void servoBusTask(void *param) {
+    ServoBus &bus = *static_cast<ServoBus *>(param);
+    int slot = taskMonitorAdd(bus.name, TASK_CORE_MOTION, BUS_TASK_BUDGET_US, BUS_TASK_STACK);
+    int64_t next = 0;
+    for(;;) {
+        taskWorkBegin(slot, next);   // late when woken after the poll that was due
+        bool serialized = busesSerialized;
+        if(serialized) xSemaphoreTake(serializeLock, portMAX_DELAY);
+        ProfileFrame frame;
+        profileBegin(frame);
+        applyMotionRequests(bus);
+        profileMark(frame, STAGE_BUS_MOTION);
+        flushPendingMoves(bus);
+        profileMark(frame, STAGE_BUS_MOVES);
+        next = pollBusScheduled(bus);
+        profileMark(frame, STAGE_BUS_FEEDBACK);
+        profileEnd(frame, bus.name);
+        if(serialized) xSemaphoreGive(serializeLock);
+        taskWorkEnd(slot);
+
+        // Benchmark: transactions back to back, limited by the UART and not
+        // by the tick; only tasks of the same priority (the other bus) get in
+        if(benchResult.running) {
+            taskYIELD();
+            continue;
+        }
+
+        // Sleep until the next tier is due, or wake early when a move is queued
+        int64_t waitMs = (next - esp_timer_get_time() + 999) / 1000;
+        if(waitMs < 1) waitMs = 1;
+        if(waitMs > BUS_IDLE_WAIT) waitMs = BUS_IDLE_WAIT;
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+    }
+}
+
+void startServoBusTasks() {
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) {
+        ServoBus &bus = buses[b];
+        if(!bus.enabled || bus.devCount == 0 || bus.task) continue;
+        xTaskCreatePinnedToCore(servoBusTask, bus.name, BUS_TASK_STACK, &bus,
+                                BUS_TASK_PRIORITY, &bus.task, TASK_CORE_MOTION);
+        LOG_I(LOG_TAG_SERVO, "Servo bus task started: %s", bus.name);
+    }
+}
+
+static uint32_t totalSamples() {
+    uint32_t n = 0;
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) n += buses[b].samples;
+    return n;
+}
+
+static void busBenchTask(void *param) {
+    uint32_t durationMs = (uint32_t)(uintptr_t)param;
+    float rate[2];
+
+    // Phase 0: bus tasks take turns (one bus worth of bandwidth)
+    // Phase 1: bus tasks run in parallel on their own UARTs
+    for(int phase = 0; phase < 2; phase++) {
+        busesSerialized = (phase == 0);
+        vTaskDelay(pdMS_TO_TICKS(50));  // let the bus tasks pick up the mode
+        uint32_t startSamples = totalSamples();
+        uint32_t start = millis();
+        vTaskDelay(pdMS_TO_TICKS(durationMs));
+        rate[phase] = (totalSamples() - startSamples) * 1000.0f / (millis() - start);
+    }
+    busesSerialized = false;
+
+    benchResult.oneBusSamplesPerSec = rate[0];
+    benchResult.parallelSamplesPerSec = rate[1];
+    benchResult.running = false;
+
+    LOG_I(LOG_TAG_SERVO, "Bus benchmark: shared %.1f samples/s, parallel %.1f samples/s", rate[0], rate[1]);
+    vTaskDelete(nullptr);
+}
+
+bool startBusBenchmark(uint32_t durationMs) {
+    if(benchResult.running) return false;
+    benchResult.running = true;
+    benchResult.durationMs = durationMs;
+    // Above the bus tasks: they do not block while the benchmark runs
+    xTaskCreatePinnedToCore(busBenchTask, "busbench", 2048, (void *)(uintptr_t)durationMs,
+                            BUS_TASK_PRIORITY + 1, nullptr, TASK_CORE_MOTION);
+    return true;
+}
+
+BusBenchResult getBusBenchmarkResult() {
+    BusBenchResult result = benchResult;
+    result.activeBuses = 0;
+    for(int b = 0; b < MAX_SERVO_BUSES; b++) {
+        if(buses[b].task) result.activeBuses++;
+    }
+    return result;
+}
+
+void gotoPosition(int dev, int targetPosition, int currentPos) {
+    if(!validDevice(dev)) return;
+    Rotator &r = rotators[dev];
+
     // Calculate relative movement
-    s16 relativeDelta = targetPosition - currentTargetPosition;
-    
-    Serial.print("Goto: target=");
-    Serial.print(targetPosition);
-    Serial.print(" current=");
-    Serial.print(currentTargetPosition);
-    Serial.print(" delta=");
-    Serial.println(relativeDelta);
-    
-    st.WritePosEx(MOTOR_ID, relativeDelta, activeServoSpeed, SERVO_INIT_ACC);
-    
-    currentTargetPosition = targetPosition;
-    absolutePosition += relativeDelta;  // Update absolute position
-}
-
-void moveServoToAngle(double angleDeg) {
-    // Get current angle
-    double currentAngle = getServoAngle();
-    
-    // Wrap target angle to 0-359.99
-    while(angleDeg >= 360.0) angleDeg -= 360.0;
-    while(angleDeg < 0.0) angleDeg += 360.0;
-    
-    // Calculate shortest path delta in degrees
-    double deltaDeg = angleDeg - currentAngle;
-    
-    // Normalize delta to shortest path (-180 to +180)
-    while(deltaDeg > 180.0) deltaDeg -= 360.0;
-    while(deltaDeg < -180.0) deltaDeg += 360.0;
-    
-    // Convert delta degrees to motor steps
-    double motorDegrees = deltaDeg * GEAR_RATIO;
-    s16 logicalDelta = (s16)((motorDegrees / SERVO_ANGLE_RANGE) * SERVO_STEPS);
-    
+    int32_t relativeDelta = targetPosition - r.currentTargetPosition;
+
+    LOG_I(LOG_TAG_SERVO, "Rotator %d goto: target=%d current=%ld delta=%ld",
+          dev, targetPosition, (long)r.currentTargetPosition, (long)relativeDelta);
+
+    queueMove(dev, relativeDelta, relativeDelta);
+}
+
+void moveServoToSteps(int dev, int32_t targetSteps) {
+    if(!validDevice(dev)) return;
+    Rotator &r = rotators[dev];
+
+    // Get current position
+    int32_t currentSteps = getServoSteps(dev);
+
+    // Shortest path delta (-180° to +180°), constant time
+    int32_t logicalDelta = shortestStepDelta(currentSteps, targetSteps, r.stepsPerRev);
+
     // Reverse: Invert movement direction for motor command only
-    s16 motorDelta = reverseDirection ? -logicalDelta : logicalDelta;
-    
-    Serial.print("Move to ");
-    Serial.print(angleDeg);
-    Serial.print("° from ");
-    Serial.print(currentAngle);
-    Serial.print("°");
-    if(reverseDirection) Serial.print(" [REV]");
-    Serial.print(" → delta: ");
-    Serial.print(deltaDeg);
-    Serial.print("° (");
-    Serial.print(motorDelta);
-    Serial.println(" steps)");
-    
-    st.WritePosEx(MOTOR_ID, motorDelta, activeServoSpeed, SERVO_INIT_ACC);
-    currentTargetPosition += motorDelta;
-    absolutePosition += logicalDelta;  // Always use logical delta for position tracking
-}
-
-void moveServoByAngle(double deltaDeg) {
+    int32_t motorDelta = r.reverseDirection ? -logicalDelta : logicalDelta;
+
+    LOG_I(LOG_TAG_SERVO, "Rotator %d: move to %ld from %ld steps%s → delta: %ld steps",
+          dev, (long)wrapSteps(targetSteps, r.stepsPerRev), (long)currentSteps,
+          r.reverseDirection ? " [REV]" : "", (long)motorDelta);
+
+    queueMove(dev, motorDelta, logicalDelta);
+}
+
+void moveServoToAngle(int dev, double angleDeg) {
+    // JSON boundary: degrees -> steps
+    moveServoToSteps(dev, degreesToSteps(angleDeg, getStepsPerRev(dev)));
+}
+
+void moveServoByAngle(int dev, double deltaDeg) {
     // Calculate target from current position
-    double currentAngle = getServoAngle();
-    double targetAngle = currentAngle + deltaDeg;
-    moveServoToAngle(targetAngle);
-    // absolutePosition is already updated in moveServoToAngle
+    moveServoToSteps(dev, getServoSteps(dev) + degreesToSteps(deltaDeg, getStepsPerRev(dev)));
+    // absolutePosition is updated when the move is flushed
 }
 
-double getServoAngle() {
+int32_t getServoSteps(int dev) {
+    if(!validDevice(dev)) return 0;
+
     // Get live position during movement
-    getFeedback();
-    
+    pollBus(busOf(dev));
+
     // In Motor-Mode 3, posRead shows remaining distance to target
-    // Calculate actual position: absolutePosition - posRead
-    s16 currentPos = absolutePosition - posRead;
-    
-    // Convert to gear degrees
-    double motorDegrees = (currentPos / SERVO_STEPS) * SERVO_ANGLE_RANGE;
-    double gearDegrees = motorDegrees / GEAR_RATIO;
-    
-    // Wrap to 0-360° range
-    while(gearDegrees >= 360.0) gearDegrees -= 360.0;
-    while(gearDegrees < 0.0) gearDegrees += 360.0;
-    
-    return gearDegrees;
+    // Calculate actual position: absolutePosition - posRead, wrapped to one revolution
+    Rotator &r = rotators[dev];
+    return wrapSteps(getMotionState(r).position, r.stepsPerRev);
+}
+
+bool isMotionSettled(int dev, int64_t *readUs) {
+    if(!validDevice(dev)) return false;
+    Rotator &r = rotators[dev];
+    ServoBus &bus = busOf(dev);
+
+    // Under the bus lock no read or flush is half done
+    lockBus(bus);
+    portENTER_CRITICAL(&pendingMux);
+    bool queued = r.motionKind != MOTION_NONE || r.applyingKind != MOTION_NONE || r.movePending;
+    portEXIT_CRITICAL(&pendingMux);
+    bool settled = !queued && r.feedbackUs > r.moveSentUs
+                && abs(r.speedRead) <= MOTION_SPEED_THRESHOLD && abs(r.posRead) <= SETTLE_TOLERANCE_STEPS;
+    if(readUs) *readUs = r.feedbackUs;
+    unlockBus(bus);
+    return settled;
+}
+
+bool getJournalEntry(int dev, JournalEntry &entry) {
+    if(!validDevice(dev)) return false;
+    Rotator &r = rotators[dev];
+
+    // Both accumulators change together under pendingMux when a move is flushed
+    portENTER_CRITICAL(&pendingMux);
+    bool queued = r.motionKind != MOTION_NONE || r.applyingKind != MOTION_NONE || r.movePending;
+    entry.position = r.absolutePosition;
+    entry.motorTarget = r.currentTargetPosition;
+    portEXIT_CRITICAL(&pendingMux);
+
+    bool fresh = r.feedbackUs > r.moveSentUs;
+    bool settled = offline(r) || (!queued && fresh && abs(r.speedRead) <= MOTION_SPEED_THRESHOLD
+                                  && abs(r.posRead) <= SETTLE_TOLERANCE_STEPS);
+    entry.bus = r.bus;
+    entry.id = r.id;
+    entry.flags = settled ? 0 : JOURNAL_IN_FLIGHT;
+    entry.reserved = 0;
+    // No read since the move was sent: the whole move may still be ahead
+    entry.spanSteps = settled ? 0 : fresh ? abs(r.posRead) : abs(r.lastMoveSteps);
+    return settled;
+}
+
+PositionRestore getPositionRestore(int dev) {
+    return validDevice(dev) ? rotators[dev].restore : PositionRestore();
+}
+
+int64_t getLastMoveSentUs(int dev) {
+    if(!validDevice(dev)) return 0;
+    portENTER_CRITICAL(&pendingMux);
+    int64_t sentUs = rotators[dev].moveSentUs;
+    portEXIT_CRITICAL(&pendingMux);
+    return sentUs;
+}
+
+int64_t getLastFeedbackUs(int dev) {
+    return validDevice(dev) ? rotators[dev].feedbackUs : 0;
+}
+
+int32_t getLastServoSteps(int dev) {
+    if(!validDevice(dev)) return 0;
+    Rotator &r = rotators[dev];
+    return wrapSteps(getMotionState(r).position, r.stepsPerRev);
+}
+
+double getServoAngle(int dev) {
+    return stepsToDegrees(getServoSteps(dev), getStepsPerRev(dev));
+}
+
+bool getRotatorSnapshot(int dev, RotatorSnapshot &snapshot) {
+    if(!validDevice(dev)) return false;
+    Rotator &r = rotators[dev];
+
+    // Polled state only: the bus task reads every motion interval while
+    // moving, so a handler never waits for the bus lock or a transaction
+    MotionState m = getMotionState(r);
+    snapshot.stale = offline(r);
+    snapshot.timeUs = m.readUs;
+    snapshot.moving = m.moving;
+    snapshot.steps = wrapSteps(m.position, r.stepsPerRev);
+    snapshot.targetSteps = wrapSteps(m.target, r.stepsPerRev);
+    snapshot.stepsPerRev = r.stepsPerRev;
+    return true;
 }
 
 // ============================================================================
 // ZERO POINT & CALIBRATION
 // ============================================================================
 
-void setCurrentTargetPosition(int steps) {
+// Sets the position without moving. Under pendingMux like flushPendingMoves,
+// which changes the same fields; the flushed delta not yet read back
+// belongs to the old position and is dropped with it.
+static void setLogicalPosition(Rotator &r, int32_t steps) {
+    portENTER_CRITICAL(&pendingMux);
+    r.currentTargetPosition = steps;
+    r.absolutePosition = steps;
+    r.unreadLogicalDelta = 0;
+    portEXIT_CRITICAL(&pendingMux);
+}
+
+void setCurrentTargetPosition(int dev, int32_t steps) {
+    if(!validDevice(dev)) return;
+
     // Update current position without moving (used by Sync)
-    currentTargetPosition = steps;
-    absolutePosition = steps;  // Also update absolutePosition for display
-    Serial.print("Position synced to ");
-    Serial.print(steps);
-    Serial.println(" steps");
+    setLogicalPosition(rotators[dev], steps);
+    LOG_I(LOG_TAG_SERVO, "Rotator %d position synced to %ld steps", dev, (long)steps);
 }
 
-void setZeroPointMode3() {
+void setZeroPointMode3(int dev) {
+    if(!validDevice(dev)) return;
+
     // In Motor-Mode (3): Do NOT switch modes!
     // Simply set virtual position to 0
-    Serial.println("Setting zero point in motor mode (virtual)...");
-    currentTargetPosition = 0;
-    absolutePosition = 0;
-    Serial.println("Virtual zero point set successfully");
+    setLogicalPosition(rotators[dev], 0);
+    LOG_I(LOG_TAG_SERVO, "Rotator %d virtual zero point set", dev);
 }
 
-void setZeroPointExact() {
-    Serial.println("Setting current position as zero point...");
-    currentTargetPosition = 0;
-    absolutePosition = 0;
-    Serial.println("Current position set to 0° (zero point)");
+void setZeroPointExact(int dev) {
+    if(!validDevice(dev)) return;
+
+    setLogicalPosition(rotators[dev], 0);
+    LOG_I(LOG_TAG_SERVO, "Rotator %d current position set to 0° (zero point)", dev);
 }
 
-void resetServoAngleZero() {
-    setZeroPointExact();
+void resetServoAngleZero(int dev) {
+    setZeroPointExact(dev);
 }
 
 // ============================================================================
 // CONTROL FUNCTIONS
 // ============================================================================
 
-void stopServo() {
+void stopServo(int dev) {
+    if(!validDevice(dev)) return;
+    Rotator &r = rotators[dev];
+    ServoBus &bus = busOf(dev);
+
+    // Drop a move that has not been sent yet
+    portENTER_CRITICAL(&pendingMux);
+    r.movePending = false;
+    portEXIT_CRITICAL(&pendingMux);
+    if(offline(r)) return;   // nothing would answer
+
+    // Hold the bus so the bus task cannot poll between feedback and stop
+    lockBus(bus);
+
     // Get current feedback before stopping
-    getFeedback();
-    
+    pollBus(bus);
+
     // Correct absolutePosition to actual current position
     // posRead shows remaining distance to target
     // So actual position = target - remaining = absolutePosition - posRead
-    absolutePosition = absolutePosition - posRead;
-    
-    st.EnableTorque(MOTOR_ID, 0);
+    r.absolutePosition = r.absolutePosition - r.posRead;
+
+    bus.st.EnableTorque(r.id, 0);
     delay(10);
-    st.EnableTorque(MOTOR_ID, 1);
+    bus.st.EnableTorque(r.id, 1);
+    unlockBus(bus);
 }
 
-void servoTorque(bool enable) {
-    st.EnableTorque(MOTOR_ID, enable ? 1 : 0);
+void servoTorque(int dev, bool enable) {
+    if(!validDevice(dev)) return;
+    if(offline(rotators[dev])) return;
+    ServoBus &bus = busOf(dev);
+    lockBus(bus);
+    bus.st.EnableTorque(rotators[dev].id, enable ? 1 : 0);
+    unlockBus(bus);
 }
 
-void setActiveSpeed(int speed) {
+void setActiveSpeed(int dev, int speed) {
+    if(!validDevice(dev)) return;
+
     // Clamp speed between reasonable limits
     // Minimum: 100 (very slow but still moves)
     // Maximum: SERVO_MAX_SPEED (4000)
@@ -388,16 +1543,15 @@ void setActiveSpeed(int speed) {
     if(speed > SERVO_MAX_SPEED) {
         speed = SERVO_MAX_SPEED;
     }
-    activeServoSpeed = speed;
-    
-    Serial.print("Speed set to: ");
-    Serial.println(activeServoSpeed);
+    rotators[dev].activeServoSpeed = speed;
+
+    LOG_I(LOG_TAG_SERVO, "Rotator %d speed set to: %d", dev, rotators[dev].activeServoSpeed);
 }
 
-int getActiveSpeed() {
-    return activeServoSpeed;
+int getActiveSpeed(int dev) {
+    return validDevice(dev) ? rotators[dev].activeServoSpeed : 0;
 }
 
-int getCurrentTargetPosition() {
-    return currentTargetPosition;
-}
\ No newline at end of file
+int32_t getCurrentTargetPosition(int dev) {
+    return validDevice(dev) ? rotators[dev].currentTargetPosition : 0;
+}
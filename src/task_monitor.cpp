@@ -0,0 +1,131 @@
+#include "task_monitor.h"
+#include "event_log.h"
+
+struct TaskSlot {
+    TaskHandle_t handle = nullptr;
+    TaskStats stats;
+    int64_t startUs = 0;             // owning task only
+};
+
+static TaskSlot slots[TASK_MONITOR_SLOTS];
+static int slotCount = 0;
+static portMUX_TYPE taskMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ============================================================================
+// REGISTRATION & WORK BRACKETS
+// ============================================================================
+
+int taskMonitorAdd(const char *name, int core, uint32_t budgetUs, uint32_t stackSize) {
+    portENTER_CRITICAL(&taskMux);
+    int slot = slotCount < TASK_MONITOR_SLOTS ? slotCount++ : -1;
+    if(slot >= 0) {
+        TaskSlot &s = slots[slot];
+        s.handle = xTaskGetCurrentTaskHandle();
+        s.stats.name = name;
+        s.stats.core = core;
+        s.stats.priority = (uint8_t)uxTaskPriorityGet(nullptr);
+        s.stats.budgetUs = budgetUs;
+        s.stats.stackSize = stackSize;
+    }
+    portEXIT_CRITICAL(&taskMux);
+    if(slot < 0) LOG_W(LOG_TAG_SYSTEM, "Task monitor full, %s not tracked", name);
+    return slot;
+}
+
+void taskWorkBegin(int slot, int64_t dueUs) {
+    if(slot < 0) return;
+    int64_t now = esp_timer_get_time();
+    slots[slot].startUs = now;
+    if(dueUs <= 0 || now <= dueUs) return;
+    uint32_t late = (uint32_t)(now - dueUs);
+    portENTER_CRITICAL(&taskMux);
+    if(late > slots[slot].stats.lateMaxUs) slots[slot].stats.lateMaxUs = late;
+    portEXIT_CRITICAL(&taskMux);
+}
+
+void taskWorkEnd(int slot) {
+    if(slot < 0) return;
+    uint32_t us = (uint32_t)(esp_timer_get_time() - slots[slot].startUs);
+    portENTER_CRITICAL(&taskMux);
+    TaskStats &s = slots[slot].stats;
+    s.runs++;
+    s.totalUs += us;
+    s.lastUs = us;
+    if(us > s.maxUs) s.maxUs = us;
+    if(s.budgetUs && us > s.budgetUs) s.overBudget++;
+    histogramObserve(s.work, us);
+    portEXIT_CRITICAL(&taskMux);
+}
+
+void taskDelayUntil(int64_t &dueUs, uint32_t periodUs) {
+    int64_t now = esp_timer_get_time();
+    dueUs += periodUs;
+    if(dueUs < now) dueUs = now + periodUs;
+    TickType_t ticks = pdMS_TO_TICKS((dueUs - now) / 1000);
+    vTaskDelay(ticks ? ticks : 1);
+}
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+int getTaskCount() {
+    return slotCount;
+}
+
+bool getTaskStats(int slot, TaskStats &stats) {
+    if(slot < 0 || slot >= slotCount) return false;
+    portENTER_CRITICAL(&taskMux);
+    stats = slots[slot].stats;
+    TaskHandle_t handle = slots[slot].handle;
+    portEXIT_CRITICAL(&taskMux);
+    stats.stackFree = uxTaskGetStackHighWaterMark(handle);   // bytes on ESP-IDF
+    return true;
+}
+
+void resetTaskStats() {
+    portENTER_CRITICAL(&taskMux);
+    for(int i = 0; i < slotCount; i++) {
+        TaskStats &s = slots[i].stats;
+        s.runs = 0;
+        s.totalUs = 0;
+        s.lastUs = 0;
+        s.maxUs = 0;
+        s.overBudget = 0;
+        s.lateMaxUs = 0;
+        s.work = LatencyHistogram();
+    }
+    portEXIT_CRITICAL(&taskMux);
+}
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+void setupTaskEndpoint(AsyncWebServer &server) {
+    // Per task: work time against its budget, wake-up lateness, stack high-water mark
+    server.on("/setup/v1/rotator/0/tasks", HTTP_GET, [](AsyncWebServerRequest *request) {
+        if (request->hasArg("reset")) resetTaskStats();
+        String json = "{\"tasks\":[";
+        for (int i = 0; i < getTaskCount(); i++) {
+            TaskStats s;
+            if (!getTaskStats(i, s)) continue;
+            uint32_t n = s.runs ? s.runs : 1;
+            if (i > 0) json += ",";
+            json += "{\"name\":\"" + String(s.name) + "\",";
+            json += "\"core\":" + String(s.core) + ",";
+            json += "\"priority\":" + String(s.priority) + ",";
+            json += "\"runs\":" + String(s.runs) + ",";
+            json += "\"lastUs\":" + String(s.lastUs) + ",";
+            json += "\"avgUs\":" + String((double)s.totalUs / n, 1) + ",";
+            json += "\"maxUs\":" + String(s.maxUs) + ",";
+            json += "\"budgetUs\":" + String(s.budgetUs) + ",";
+            json += "\"overBudget\":" + String(s.overBudget) + ",";
+            json += "\"lateMaxUs\":" + String(s.lateMaxUs) + ",";
+            json += "\"stackSize\":" + String(s.stackSize) + ",";
+            json += "\"stackFree\":" + String(s.stackFree) + "}";
+        }
+        json += "],\"freeHeap\":" + String(ESP.getFreeHeap()) + "}";
+        request->send(200, "application/json", json);
+    });
+}
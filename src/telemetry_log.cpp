@@ -0,0 +1,283 @@
+#include "telemetry_log.h"
+#include "servo_control.h"
+#include <memory>
+
+static_assert(sizeof(TelemetrySample) == 22, "TelemetrySample layout");
+static_assert(sizeof(TelemetryAggregate) == 48, "TelemetryAggregate layout");
+static_assert(sizeof(TelemetrySample) * TELEMETRY_FULL_SAMPLES
+              + sizeof(TelemetryAggregate) * (TELEMETRY_TIER1_SAMPLES + TELEMETRY_TIER2_SAMPLES)
+              <= TELEMETRY_MEMORY_BUDGET, "telemetry buffers exceed memory budget");
+
+// Ring buffers (static, fixed budget)
+static TelemetrySample fullTier[TELEMETRY_FULL_SAMPLES];
+static TelemetryAggregate tier1[TELEMETRY_TIER1_SAMPLES];
+static TelemetryAggregate tier2[TELEMETRY_TIER2_SAMPLES];
+
+// Total records ever written per tier (ring index = written % capacity)
+static uint32_t written[3] = {0, 0, 0};
+static const uint32_t capacity[3] = {TELEMETRY_FULL_SAMPLES, TELEMETRY_TIER1_SAMPLES, TELEMETRY_TIER2_SAMPLES};
+
+// Per-rotator decimation and open buckets
+struct Accumulator {
+    bool open = false;
+    TelemetryAggregate agg;
+    int64_t positionSum = 0;
+    int32_t speedSum = 0;
+    int32_t loadSum = 0;
+    int32_t currentSum = 0;
+    uint32_t voltageSum = 0;
+    uint32_t temperatureSum = 0;
+};
+
+static uint64_t lastFullUs[MAX_ROTATORS] = {0};
+static Accumulator bucket1[MAX_ROTATORS];
+static Accumulator bucket2[MAX_ROTATORS];
+
+static portMUX_TYPE telemetryMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ============================================================================
+// AGGREGATION
+// ============================================================================
+
+// By value: fields of packed structs cannot be bound to references
+template<typename T>
+static inline T lower(T a, T b) { return a < b ? a : b; }
+template<typename T>
+static inline T upper(T a, T b) { return a > b ? a : b; }
+
+static void bucketStart(Accumulator &a, uint64_t startUs, uint8_t dev) {
+    a = Accumulator();
+    a.open = true;
+    a.agg.startUs = startUs;
+    a.agg.dev = dev;
+    a.agg.status = 0;
+    a.agg.count = 0;
+}
+
+// Merge count samples with the given min/max/mean into an open bucket
+static void bucketAdd(Accumulator &a, const TelemetryAggregate &s) {
+    TelemetryAggregate &g = a.agg;
+    if (g.count == 0) {
+        uint64_t startUs = g.startUs;
+        g = s;
+        g.startUs = startUs;
+    } else {
+        g.positionMin = lower(g.positionMin, s.positionMin);
+        g.positionMax = upper(g.positionMax, s.positionMax);
+        g.speedMin = lower(g.speedMin, s.speedMin);
+        g.speedMax = upper(g.speedMax, s.speedMax);
+        g.loadMin = lower(g.loadMin, s.loadMin);
+        g.loadMax = upper(g.loadMax, s.loadMax);
+        g.currentMin = lower(g.currentMin, s.currentMin);
+        g.currentMax = upper(g.currentMax, s.currentMax);
+        g.voltageMin = lower(g.voltageMin, s.voltageMin);
+        g.voltageMax = upper(g.voltageMax, s.voltageMax);
+        g.temperatureMin = lower(g.temperatureMin, s.temperatureMin);
+        g.temperatureMax = upper(g.temperatureMax, s.temperatureMax);
+        g.status |= s.status;
+        g.count += s.count;
+    }
+    a.positionSum += (int64_t)s.positionMean * s.count;
+    a.speedSum += (int32_t)s.speedMean * s.count;
+    a.loadSum += (int32_t)s.loadMean * s.count;
+    a.currentSum += (int32_t)s.currentMean * s.count;
+    a.voltageSum += (uint32_t)s.voltageMean * s.count;
+    a.temperatureSum += (uint32_t)s.temperatureMean * s.count;
+}
+
+static TelemetryAggregate bucketClose(Accumulator &a) {
+    TelemetryAggregate g = a.agg;
+    if (g.count > 0) {
+        g.positionMean = (int32_t)(a.positionSum / g.count);
+        g.speedMean = (int16_t)(a.speedSum / g.count);
+        g.loadMean = (int16_t)(a.loadSum / g.count);
+        g.currentMean = (int16_t)(a.currentSum / g.count);
+        g.voltageMean = (uint8_t)(a.voltageSum / g.count);
+        g.temperatureMean = (uint8_t)(a.temperatureSum / g.count);
+    }
+    a.open = false;
+    return g;
+}
+
+static TelemetryAggregate singleSample(const TelemetrySample &s) {
+    TelemetryAggregate g;
+    g.startUs = s.timeUs;
+    g.count = 1;
+    g.dev = s.dev;
+    g.status = s.status;
+    g.positionMin = g.positionMax = g.positionMean = s.position;
+    g.speedMin = g.speedMax = g.speedMean = s.speed;
+    g.loadMin = g.loadMax = g.loadMean = s.load;
+    g.currentMin = g.currentMax = g.currentMean = s.current;
+    g.voltageMin = g.voltageMax = g.voltageMean = s.voltage;
+    g.temperatureMin = g.temperatureMax = g.temperatureMean = s.temperature;
+    return g;
+}
+
+// Feed one record into a tier's open bucket, pushing it to the ring when the period is over
+static bool bucketFeed(Accumulator &a, const TelemetryAggregate &s, uint64_t periodUs,
+                       TelemetryAggregate *ring, int tier, TelemetryAggregate &closed) {
+    bool didClose = false;
+    if (a.open && s.startUs - a.agg.startUs >= periodUs) {
+        closed = bucketClose(a);
+        ring[written[tier] % capacity[tier]] = closed;
+        written[tier]++;
+        didClose = true;
+    }
+    if (!a.open) {
+        bucketStart(a, s.startUs, s.dev);
+    }
+    bucketAdd(a, s);
+    return didClose;
+}
+
+void telemetryRecord(const TelemetrySample &sample) {
+    if (sample.dev >= MAX_ROTATORS) return;
+
+    // Decimate to the full-rate tier period
+    if (lastFullUs[sample.dev] != 0 &&
+        sample.timeUs - lastFullUs[sample.dev] < (uint64_t)TELEMETRY_FULL_PERIOD_MS * 1000) {
+        return;
+    }
+    lastFullUs[sample.dev] = sample.timeUs;
+
+    portENTER_CRITICAL(&telemetryMux);
+    fullTier[written[0] % capacity[0]] = sample;
+    written[0]++;
+
+    TelemetryAggregate closed;
+    if (bucketFeed(bucket1[sample.dev], singleSample(sample), (uint64_t)TELEMETRY_TIER1_PERIOD_MS * 1000,
+                   tier1, 1, closed)) {
+        TelemetryAggregate unused;
+        bucketFeed(bucket2[sample.dev], closed, (uint64_t)TELEMETRY_TIER2_PERIOD_MS * 1000,
+                   tier2, 2, unused);
+    }
+    portEXIT_CRITICAL(&telemetryMux);
+}
+
+uint32_t telemetryCount(int tier) {
+    if (tier < 0 || tier > 2) return 0;
+    return written[tier] < capacity[tier] ? written[tier] : capacity[tier];
+}
+
+// ============================================================================
+// HTTP EXPORT
+// ============================================================================
+
+struct ExportCursor {
+    int tier;
+    bool csv;
+    int dev;                // -1 = all rotators
+    uint32_t next;          // next record sequence number
+    uint32_t end;           // snapshot end (records written later are not streamed)
+    bool headerSent;
+};
+
+// Copy record seq of a tier; returns false when it was overwritten or not yet written
+static bool readRecord(int tier, uint32_t &seq, void *out) {
+    bool ok = false;
+    portENTER_CRITICAL(&telemetryMux);
+    uint32_t total = written[tier];
+    if (total > capacity[tier] && seq < total - capacity[tier]) {
+        seq = total - capacity[tier];  // Skip records lost to the ring
+    }
+    if (seq < total) {
+        uint32_t i = seq % capacity[tier];
+        if (tier == 0) {
+            memcpy(out, &fullTier[i], sizeof(TelemetrySample));
+        } else {
+            memcpy(out, tier == 1 ? &tier1[i] : &tier2[i], sizeof(TelemetryAggregate));
+        }
+        ok = true;
+    }
+    portEXIT_CRITICAL(&telemetryMux);
+    return ok;
+}
+
+static int formatCsv(int tier, const void *record, char *line, size_t size) {
+    if (tier == 0) {
+        const TelemetrySample &s = *static_cast<const TelemetrySample *>(record);
+        return snprintf(line, size, "%llu,%u,%ld,%d,%d,%u,%u,%d,%u\n",
+                        (unsigned long long)s.timeUs, s.dev, (long)s.position, s.speed, s.load,
+                        s.voltage, s.temperature, s.current, s.status);
+    }
+    const TelemetryAggregate &g = *static_cast<const TelemetryAggregate *>(record);
+    return snprintf(line, size, "%llu,%u,%u,%u,%ld,%ld,%ld,%d,%d,%d,%d,%d,%d,%d,%d,%d,%u,%u,%u,%u,%u,%u\n",
+                    (unsigned long long)g.startUs, g.dev, g.count, g.status,
+                    (long)g.positionMin, (long)g.positionMax, (long)g.positionMean,
+                    g.speedMin, g.speedMax, g.speedMean,
+                    g.loadMin, g.loadMax, g.loadMean,
+                    g.currentMin, g.currentMax, g.currentMean,
+                    g.voltageMin, g.voltageMax, g.voltageMean,
+                    g.temperatureMin, g.temperatureMax, g.temperatureMean);
+}
+
+static size_t fillExport(ExportCursor &c, uint8_t *buffer, size_t maxLen) {
+    size_t len = 0;
+    if (c.csv && !c.headerSent) {
+        const char *header = c.tier == 0
+            ? "time_us,dev,position,speed,load,voltage,temperature,current,status\n"
+            : "start_us,dev,count,status,position_min,position_max,position_mean,"
+              "speed_min,speed_max,speed_mean,load_min,load_max,load_mean,"
+              "current_min,current_max,current_mean,voltage_min,voltage_max,voltage_mean,"
+              "temperature_min,temperature_max,temperature_mean\n";
+        size_t n = strlen(header);
+        if (n > maxLen) return 0;
+        memcpy(buffer, header, n);
+        len = n;
+        c.headerSent = true;
+    }
+
+    uint8_t record[sizeof(TelemetryAggregate)];
+    char line[192];
+    while (c.next < c.end) {
+        uint32_t seq = c.next;
+        if (!readRecord(c.tier, seq, record)) break;
+        uint8_t dev = c.tier == 0 ? reinterpret_cast<TelemetrySample *>(record)->dev
+                                  : reinterpret_cast<TelemetryAggregate *>(record)->dev;
+        if (c.dev >= 0 && dev != c.dev) {
+            c.next = seq + 1;
+            continue;
+        }
+        const void *data = record;
+        size_t n;
+        if (c.csv) {
+            n = formatCsv(c.tier, record, line, sizeof(line));
+            data = line;
+        } else {
+            n = c.tier == 0 ? sizeof(TelemetrySample) : sizeof(TelemetryAggregate);
+        }
+        if (len + n > maxLen) break;
+        memcpy(buffer + len, data, n);
+        len += n;
+        c.next = seq + 1;
+    }
+    return len;
+}
+
+void setupTelemetryEndpoints(AsyncWebServer &server) {
+    // GET /telemetry?tier=0|1|2&format=csv|bin[&dev=n]
+    // Streams a snapshot of the ring (records written after the request started are not included)
+    server.on("/telemetry", HTTP_GET, [](AsyncWebServerRequest *request) {
+        auto cursor = std::make_shared<ExportCursor>();
+        cursor->tier = request->hasArg("tier") ? constrain((int)request->arg("tier").toInt(), 0, 2) : 0;
+        cursor->csv = !(request->hasArg("format") && request->arg("format") == "bin");
+        cursor->dev = request->hasArg("dev") ? request->arg("dev").toInt() : -1;
+        cursor->headerSent = !cursor->csv;
+
+        portENTER_CRITICAL(&telemetryMux);
+        cursor->end = written[cursor->tier];
+        portEXIT_CRITICAL(&telemetryMux);
+        uint32_t cap = capacity[cursor->tier];
+        cursor->next = cursor->end > cap ? cursor->end - cap : 0;
+
+        const char *type = cursor->csv ? "text/csv" : "application/octet-stream";
+        AsyncWebServerResponse *response = request->beginChunkedResponse(type,
+            [cursor](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                return fillExport(*cursor, buffer, maxLen);
+            });
+        response->addHeader("X-Record-Size", String(cursor->tier == 0 ? sizeof(TelemetrySample) : sizeof(TelemetryAggregate)));
+        response->addHeader("Cache-Control", "no-store");
+        request->send(response);
+    });
+}
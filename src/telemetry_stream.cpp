@@ -0,0 +1,194 @@
+#include "telemetry_stream.h"
+#include "servo_control.h"
+#include "event_log.h"
+#include "task_monitor.h"
+#include <WiFi.h>
+
+#define STREAM_TASK_STACK 4096
+#define STREAM_TASK_PRIORITY 1
+#define STREAM_TASK_BUDGET_US 5000
+#define STREAM_INTERVAL_MS 10           // drain period of the server task
+#define STREAM_BATCH 32                 // records per write
+
+static_assert(sizeof(TelemetryStreamHeader) == 16, "TelemetryStreamHeader layout");
+static_assert(sizeof(TelemetryStreamRecord) == 22, "TelemetryStreamRecord layout");
+static_assert((TELEMETRY_STREAM_RING & (TELEMETRY_STREAM_RING - 1)) == 0, "TELEMETRY_STREAM_RING must be a power of two");
+
+// Shared ring, written by the bus tasks (seq = total records written)
+static TelemetryStreamRecord ring[TELEMETRY_STREAM_RING];
+static uint32_t written = 0;
+static portMUX_TYPE streamMux = portMUX_INITIALIZER_UNLOCKED;
+
+struct StreamClient {
+    WiFiClient client;
+    bool active = false;
+    uint32_t next = 0;                  // next seq to send
+    char line[16];                      // partial command line
+    uint8_t lineLength = 0;
+};
+
+static StreamClient clients[TELEMETRY_STREAM_CLIENTS];
+static TelemetryStreamStats stats;
+static uint8_t rateHz = TELEMETRY_STREAM_DEFAULT_HZ;
+static TaskHandle_t streamTask = nullptr;
+
+// ============================================================================
+// PRODUCER
+// ============================================================================
+
+void telemetryStreamRecord(const TelemetrySample &sample) {
+    if (!streamTask) return;
+    portENTER_CRITICAL(&streamMux);
+    TelemetryStreamRecord &r = ring[written & (TELEMETRY_STREAM_RING - 1)];
+    r.seq = written;
+    r.timeUs = sample.timeUs;
+    r.position = sample.position;
+    r.speed = sample.speed;
+    r.load = sample.load;
+    r.status = sample.status;
+    r.dev = sample.dev;
+    written++;
+    portEXIT_CRITICAL(&streamMux);
+}
+
+// ============================================================================
+// SERVER TASK
+// ============================================================================
+
+static void applyRate() {
+    bool any = false;
+    for (int i = 0; i < TELEMETRY_STREAM_CLIENTS; i++) any |= clients[i].active;
+    setStreamPollInterval(any ? 1000 / rateHz : 0);
+}
+
+static void acceptClient(WiFiServer &server) {
+    WiFiClient incoming = server.available();
+    if (!incoming) return;
+
+    for (int i = 0; i < TELEMETRY_STREAM_CLIENTS; i++) {
+        StreamClient &c = clients[i];
+        if (c.active) continue;
+        c.client = incoming;
+        c.client.setNoDelay(true);
+        c.active = true;
+        c.lineLength = 0;
+        portENTER_CRITICAL(&streamMux);
+        c.next = written;               // live from now on
+        portEXIT_CRITICAL(&streamMux);
+
+        TelemetryStreamHeader h;
+        h.magic = TELEMETRY_STREAM_MAGIC;
+        h.version = TELEMETRY_STREAM_VERSION;
+        h.recordSize = sizeof(TelemetryStreamRecord);
+        h.stepsPerRev = getStepsPerRev(0);
+        h.rotators = getRotatorCount();
+        h.rateHz = rateHz;
+        h.reserved = 0;
+        c.client.write((const uint8_t *)&h, sizeof(h));
+        LOG_I(LOG_TAG_SYSTEM, "Telemetry stream client connected (slot %d)", i);
+        applyRate();
+        return;
+    }
+    incoming.stop();  // All slots busy
+}
+
+// Optional command from the client: "rate <hz>\n"
+static void readCommands(StreamClient &c) {
+    while (c.client.available()) {
+        int ch = c.client.read();
+        if (ch < 0) break;
+        if (ch != '\n' && c.lineLength < sizeof(c.line) - 1) {
+            c.line[c.lineLength++] = (char)ch;
+            continue;
+        }
+        c.line[c.lineLength] = '\0';
+        c.lineLength = 0;
+        int hz;
+        if (sscanf(c.line, "rate %d", &hz) == 1 && hz >= 1 && hz <= 100) {
+            rateHz = hz;
+            applyRate();
+            LOG_I(LOG_TAG_SYSTEM, "Telemetry stream rate %d Hz", hz);
+        }
+    }
+}
+
+static void sendPending(StreamClient &c) {
+    TelemetryStreamRecord batch[STREAM_BATCH];
+    for (;;) {
+        int n = 0;
+        portENTER_CRITICAL(&streamMux);
+        if (written - c.next > TELEMETRY_STREAM_RING) {
+            // Overrun: the client sees the jump in seq
+            stats.dropped += written - c.next - TELEMETRY_STREAM_RING;
+            c.next = written - TELEMETRY_STREAM_RING;
+        }
+        while (n < STREAM_BATCH && c.next != written) {
+            batch[n++] = ring[c.next & (TELEMETRY_STREAM_RING - 1)];
+            c.next++;
+        }
+        portEXIT_CRITICAL(&streamMux);
+        if (n == 0) return;
+
+        size_t bytes = n * sizeof(TelemetryStreamRecord);
+        if (c.client.write((const uint8_t *)batch, bytes) != bytes) {
+            c.client.stop();
+            return;
+        }
+        stats.sent += n;
+    }
+}
+
+static void telemetryStreamTask(void *param) {
+    WiFiServer server(TELEMETRY_STREAM_PORT);
+    server.begin();
+    server.setNoDelay(true);
+    int slot = taskMonitorAdd("telstream", TASK_CORE_NETWORK, STREAM_TASK_BUDGET_US, STREAM_TASK_STACK);
+    int64_t dueUs = esp_timer_get_time();
+    for (;;) {
+        taskWorkBegin(slot, dueUs);
+        acceptClient(server);
+        for (int i = 0; i < TELEMETRY_STREAM_CLIENTS; i++) {
+            StreamClient &c = clients[i];
+            if (!c.active) continue;
+            if (!c.client.connected()) {
+                c.client.stop();
+                c.active = false;
+                LOG_I(LOG_TAG_SYSTEM, "Telemetry stream client disconnected (slot %d)", i);
+                applyRate();
+                continue;
+            }
+            readCommands(c);
+            sendPending(c);
+        }
+        taskWorkEnd(slot);
+        taskDelayUntil(dueUs, STREAM_INTERVAL_MS * 1000);
+    }
+}
+
+void setupTelemetryStream(AsyncWebServer &server) {
+    server.on("/setup/v1/rotator/0/telemetrystream", HTTP_GET, [](AsyncWebServerRequest *request) {
+        TelemetryStreamStats s = getTelemetryStreamStats();
+        String json = "{\"port\":" + String(TELEMETRY_STREAM_PORT) + ",";
+        json += "\"clients\":" + String(s.clients) + ",";
+        json += "\"rateHz\":" + String(s.rateHz) + ",";
+        json += "\"records\":" + String(s.records) + ",";
+        json += "\"sent\":" + String(s.sent) + ",";
+        json += "\"dropped\":" + String(s.dropped) + "}";
+        request->send(200, "application/json", json);
+    });
+
+    if (streamTask) return;
+    xTaskCreatePinnedToCore(telemetryStreamTask, "telstream", STREAM_TASK_STACK, nullptr, STREAM_TASK_PRIORITY,
+                            &streamTask, TASK_CORE_NETWORK);
+}
+
+TelemetryStreamStats getTelemetryStreamStats() {
+    TelemetryStreamStats s = stats;
+    s.records = written;
+    s.rateHz = rateHz;
+    s.clients = 0;
+    for (int i = 0; i < TELEMETRY_STREAM_CLIENTS; i++) {
+        if (clients[i].active) s.clients++;
+    }
+    return s;
+}
@@ -0,0 +1,304 @@
+// Generated by tools/embed_web.py from web/ - do not edit.
+#include "web_assets.h"
+
+// panel.html: 5128 bytes source, 4596 minified, 1750 gzip
+static const uint8_t web_panel_html[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x58, 0x6d, 0x73, 0xda, 0x46,
+    0x10, 0xfe, 0xee, 0x5f, 0x71, 0x55, 0xd2, 0x20, 0x26, 0x20, 0x24, 0xd9, 0x18, 0x47, 0x02, 0x3a,
+    0x69, 0x12, 0xb7, 0xe9, 0xe4, 0xc5, 0x13, 0xbb, 0xef, 0xd3, 0x99, 0x1c, 0xba, 0x03, 0xae, 0x91,
+    0x74, 0xea, 0xe9, 0x84, 0xa1, 0x94, 0xff, 0xde, 0xbd, 0x17, 0x81, 0xc0, 0x76, 0x1a, 0x27, 0x1d,
+    0x33, 0xba, 0xe3, 0xee, 0x76, 0xf7, 0xd9, 0x67, 0xf7, 0x76, 0x85, 0x87, 0x5f, 0x3d, 0x7f, 0xfb,
+    0xec, 0xea, 0xd7, 0x8b, 0x17, 0x68, 0x2e, 0xb3, 0x74, 0x3c, 0xb4, 0x4f, 0x8a, 0xc9, 0x78, 0x98,
+    0x51, 0x89, 0x51, 0x32, 0xc7, 0xa2, 0xa4, 0x72, 0xe4, 0xfc, 0x78, 0x75, 0xde, 0x3d, 0x73, 0xec,
+    0x6a, 0x8e, 0x33, 0x3a, 0x72, 0x16, 0x8c, 0x5e, 0x17, 0x5c, 0x48, 0x07, 0x25, 0x3c, 0x97, 0x34,
+    0x87, 0x53, 0xd7, 0x8c, 0xc8, 0xf9, 0x88, 0xd0, 0x05, 0x4b, 0x68, 0x57, 0x7f, 0xe9, 0xb0, 0x9c,
+    0x49, 0x86, 0xd3, 0x6e, 0x99, 0xe0, 0x94, 0x8e, 0x02, 0x50, 0x21, 0x99, 0x4c, 0xe9, 0xf8, 0x35,
+    0x7f, 0x8d, 0xd1, 0x3b, 0x2e, 0xb1, 0xe4, 0x02, 0x5d, 0xe0, 0x9c, 0xa6, 0xc3, 0x9e, 0xd9, 0x19,
+    0x96, 0x72, 0x05, 0x83, 0xc2, 0xb2, 0x9e, 0x82, 0xe6, 0xee, 0x14, 0x67, 0x2c, 0x5d, 0x45, 0x4f,
+    0x05, 0xe8, 0x89, 0x27, 0x38, 0xf9, 0x30, 0x13, 0xbc, 0xca, 0x49, 0xf4, 0x20, 0x38, 0x53, 0x7f,
+    0x71, 0xc2, 0x53, 0x2e, 0xa2, 0x07, 0x94, 0xa8, 0xbf, 0xcd, 0x84, 0x93, 0xd5, 0x3a, 0xc3, 0x4b,
+    0x63, 0x3f, 0x3a, 0x3e, 0xf5, 0x8b, 0x65, 0x9c, 0x61, 0x31, 0x63, 0x79, 0xe4, 0x23, 0x5c, 0x49,
+    0x1e, 0x17, 0x98, 0x10, 0x96, 0xcf, 0xa2, 0x50, 0x6d, 0x35, 0x14, 0x8a, 0xd9, 0xc4, 0x0d, 0x07,
+    0x9d, 0x27, 0x7e, 0x67, 0x70, 0xda, 0x8e, 0x27, 0x5c, 0x10, 0x2a, 0xba, 0x02, 0x13, 0x56, 0x95,
+    0x51, 0x10, 0xaa, 0xb3, 0x7c, 0xd9, 0x2d, 0xe7, 0x98, 0xf0, 0x6b, 0x50, 0xe5, 0xa3, 0xb3, 0x62,
+    0x89, 0x1e, 0x04, 0x41, 0xb0, 0x99, 0x87, 0x06, 0x69, 0xc9, 0xfe, 0xa6, 0x51, 0x28, 0x68, 0xb6,
+    0x67, 0x02, 0x4e, 0x06, 0x4d, 0x10, 0xb1, 0xa4, 0x4b, 0xd9, 0xc5, 0x29, 0x9b, 0xe5, 0x51, 0x02,
+    0xbc, 0x51, 0xb1, 0xf1, 0xcc, 0x48, 0xc9, 0x9a, 0xb0, 0xb2, 0x48, 0xf1, 0x2a, 0x9a, 0xa6, 0x74,
+    0x19, 0xff, 0x59, 0x95, 0x92, 0x4d, 0x57, 0x5d, 0x4b, 0xb0, 0x3d, 0x1d, 0x6b, 0xd1, 0x2e, 0x93,
+    0x34, 0x2b, 0xeb, 0x25, 0xa3, 0xbb, 0x3b, 0xe1, 0x52, 0xf2, 0x4c, 0x83, 0xdd, 0x78, 0x25, 0x4d,
+    0x24, 0xe3, 0xf9, 0xbe, 0xca, 0x5b, 0x64, 0xef, 0xb0, 0xb2, 0xaf, 0x12, 0x7c, 0x8d, 0x67, 0xb8,
+    0x50, 0xe3, 0x26, 0xc5, 0x13, 0x9a, 0xae, 0xb7, 0x9c, 0x9e, 0x69, 0x17, 0xfd, 0x78, 0x47, 0x41,
+    0xe0, 0x05, 0x40, 0x02, 0x20, 0xc8, 0x70, 0x9a, 0x76, 0xcd, 0xf1, 0xdd, 0xae, 0xef, 0x9d, 0xf5,
+    0x15, 0x47, 0x36, 0x6e, 0x84, 0x90, 0x9a, 0x9a, 0x50, 0x6b, 0x52, 0xa6, 0x6e, 0xa1, 0x88, 0x57,
+    0xb2, 0xa8, 0x20, 0x1b, 0x18, 0x4d, 0xc9, 0xba, 0x69, 0xeb, 0x58, 0x29, 0x6b, 0xe6, 0x05, 0x3d,
+    0xc6, 0x83, 0x80, 0x6c, 0x63, 0x60, 0x43, 0xd7, 0x8c, 0x66, 0xff, 0x36, 0x13, 0xf6, 0x4c, 0x14,
+    0x00, 0x8a, 0x92, 0xa7, 0x8c, 0xa0, 0x07, 0x67, 0x03, 0x7f, 0xe2, 0x4f, 0xe2, 0x0c, 0x78, 0x30,
+    0xe9, 0x14, 0xf8, 0xbb, 0x48, 0xd6, 0xd4, 0x9c, 0x00, 0x25, 0x2c, 0x07, 0x6c, 0xbf, 0xcb, 0x55,
+    0x41, 0x47, 0xad, 0xbc, 0xca, 0x26, 0x54, 0xb4, 0xfe, 0x58, 0x5b, 0x11, 0x9d, 0x66, 0x73, 0xca,
+    0x66, 0x73, 0x19, 0x85, 0xca, 0xb9, 0x43, 0xa2, 0xb6, 0x48, 0x41, 0x93, 0xf6, 0x7e, 0x1f, 0xec,
+    0xc9, 0x76, 0x45, 0x13, 0x64, 0xa1, 0xd1, 0x63, 0x8a, 0xe9, 0xf1, 0x61, 0xfa, 0xf6, 0xfb, 0x9d,
+    0xe0, 0x78, 0xd0, 0x19, 0xf4, 0xdb, 0xfb, 0xd7, 0xe2, 0x36, 0x42, 0x27, 0x15, 0xc0, 0xcf, 0xeb,
+    0x38, 0x2a, 0x2b, 0x35, 0x8e, 0x53, 0x30, 0xd3, 0x60, 0x0d, 0x52, 0x36, 0xa9, 0x44, 0x09, 0xda,
+    0x0a, 0xce, 0x0c, 0x53, 0x0d, 0xb6, 0x4f, 0xc2, 0x93, 0xc1, 0x64, 0x50, 0x9b, 0x9b, 0x4e, 0xa7,
+    0x07, 0xf0, 0x4f, 0xf7, 0x3c, 0xf6, 0xbd, 0x27, 0x3a, 0xf8, 0x3b, 0x4a, 0x07, 0xbe, 0x4a, 0x56,
+    0x03, 0xa6, 0x5b, 0x4a, 0x5e, 0x7c, 0x31, 0xa2, 0xc9, 0x00, 0x30, 0x85, 0xff, 0x0f, 0xa2, 0x68,
+    0xce, 0x17, 0x54, 0xac, 0x9b, 0xea, 0xa7, 0xd3, 0x93, 0x27, 0x27, 0x64, 0xe3, 0x11, 0xb6, 0x60,
+    0x44, 0xed, 0x19, 0xe5, 0x80, 0xbc, 0x19, 0x9f, 0x7e, 0xbf, 0xbf, 0x4d, 0x6b, 0x5d, 0x04, 0xe2,
+    0x6d, 0x06, 0x7d, 0xbd, 0xbd, 0x9b, 0x5d, 0x5d, 0xf2, 0xd6, 0x37, 0x53, 0xb1, 0x99, 0x22, 0xba,
+    0xa0, 0x58, 0x55, 0x41, 0x7f, 0x57, 0x4f, 0x6a, 0xff, 0x48, 0x02, 0x3a, 0xb7, 0xf7, 0x23, 0x65,
+    0x39, 0xdd, 0xbf, 0xf2, 0xf6, 0x5c, 0x92, 0x24, 0x07, 0x5e, 0x83, 0xda, 0x8f, 0xdf, 0x7d, 0xed,
+    0x92, 0x22, 0x63, 0xd8, 0x33, 0x45, 0x79, 0xd8, 0x33, 0xcd, 0x41, 0x15, 0x59, 0x68, 0x14, 0xe1,
+    0xf8, 0xa0, 0x82, 0xc3, 0xca, 0x10, 0x68, 0x41, 0x49, 0x8a, 0xcb, 0x72, 0xe4, 0xd4, 0x55, 0xcd,
+    0x41, 0x5a, 0x7c, 0xe4, 0x28, 0x3c, 0x5d, 0xc2, 0x84, 0xf1, 0x3e, 0x02, 0x64, 0x55, 0x96, 0x43,
+    0x4f, 0xd0, 0x25, 0x62, 0x7c, 0xc1, 0x4b, 0xa6, 0xd6, 0x11, 0xcb, 0xd1, 0x23, 0x42, 0x67, 0xf1,
+    0xb0, 0x67, 0x36, 0x9a, 0x3a, 0x9b, 0x65, 0xc0, 0x41, 0x8c, 0xa8, 0x46, 0x24, 0x64, 0x05, 0x2d,
+    0xa6, 0xe0, 0xa5, 0x33, 0xf6, 0x3d, 0x7f, 0xd8, 0x83, 0xe3, 0x63, 0xfb, 0x54, 0x92, 0xd6, 0xf8,
+    0x67, 0xd6, 0x41, 0x5b, 0xf5, 0x6e, 0xd6, 0x43, 0xc0, 0xad, 0xaf, 0x3d, 0xd2, 0xd7, 0xde, 0x31,
+    0xd7, 0xde, 0x40, 0x02, 0x28, 0x2f, 0xd5, 0x96, 0x83, 0x20, 0xab, 0x46, 0x4e, 0x17, 0xba, 0x10,
+    0x4c, 0xf1, 0x72, 0xe4, 0xe8, 0x59, 0x29, 0x69, 0x31, 0x72, 0x7c, 0x2f, 0x70, 0xd0, 0x02, 0xa7,
+    0x15, 0x08, 0xfb, 0xa0, 0xcc, 0x24, 0x5c, 0xed, 0xa7, 0xf9, 0xe6, 0x20, 0x9e, 0x27, 0x29, 0x4b,
+    0x3e, 0x8c, 0x9c, 0x19, 0x97, 0xfc, 0x0a, 0x30, 0x50, 0xe9, 0xb6, 0x9d, 0xf1, 0x77, 0xf0, 0x6d,
+    0xd8, 0x33, 0x87, 0x9a, 0xbe, 0xde, 0xc5, 0xbc, 0xf5, 0xa2, 0xe6, 0x7a, 0x1b, 0x90, 0xc3, 0x6b,
+    0xe0, 0x8c, 0xdf, 0x51, 0x48, 0xf8, 0x92, 0x46, 0x5b, 0xf2, 0x9b, 0x4e, 0x26, 0x73, 0x9a, 0x7c,
+    0x80, 0x36, 0x68, 0xdc, 0x14, 0xe6, 0xe8, 0xb3, 0xed, 0x22, 0x80, 0x9d, 0xe3, 0x7c, 0x06, 0x07,
+    0x25, 0x9f, 0xcd, 0x52, 0x6a, 0x75, 0x01, 0xe0, 0xda, 0xa0, 0xb9, 0x04, 0xba, 0x0d, 0xdb, 0x92,
+    0x18, 0x18, 0x58, 0x37, 0x5c, 0x68, 0x34, 0x0f, 0x67, 0xec, 0x2a, 0x0a, 0x91, 0xe7, 0xa1, 0xc7,
+    0x30, 0xea, 0xdc, 0x68, 0xdf, 0x94, 0xb0, 0x17, 0xf2, 0x56, 0x65, 0xcd, 0xfb, 0x66, 0xd8, 0x43,
+    0xdb, 0x74, 0xf3, 0x3c, 0xef, 0x4e, 0x89, 0x3b, 0xe2, 0xa2, 0x0b, 0x55, 0x23, 0x38, 0x49, 0x46,
+    0xdc, 0xa0, 0x13, 0x42, 0x60, 0x2e, 0x61, 0x63, 0x17, 0x98, 0xff, 0x88, 0xa9, 0x11, 0x3b, 0x05,
+    0x31, 0xdf, 0x26, 0xfc, 0xbd, 0x04, 0x03, 0x10, 0x7c, 0xf2, 0x59, 0x92, 0x7d, 0x90, 0x0c, 0xce,
+    0x0e, 0x45, 0xef, 0x49, 0x42, 0x43, 0x6b, 0x06, 0x55, 0xf2, 0x8a, 0x3f, 0xcd, 0x21, 0xe6, 0xf0,
+    0x0a, 0xe5, 0x83, 0x76, 0x78, 0xde, 0x0f, 0x58, 0x53, 0x05, 0x04, 0x19, 0x54, 0xd4, 0xa1, 0xfe,
+    0x08, 0xc0, 0x4f, 0x0f, 0xf9, 0xe5, 0x2a, 0x4f, 0xd0, 0xb3, 0x4a, 0x08, 0xb8, 0x19, 0xbb, 0xd0,
+    0xe3, 0xf2, 0x0b, 0x9c, 0xb6, 0x41, 0x38, 0x03, 0xa8, 0xbf, 0x51, 0xc1, 0x3f, 0x89, 0x47, 0x73,
+    0xa7, 0x2e, 0x0b, 0x4a, 0xc9, 0xee, 0x86, 0x7d, 0x92, 0x9d, 0x01, 0x98, 0x79, 0x7c, 0xcf, 0x30,
+    0x2b, 0x68, 0xdd, 0xcf, 0xa3, 0xef, 0x0b, 0x2a, 0xc8, 0x73, 0x5b, 0x68, 0xef, 0xe7, 0x5f, 0x18,
+    0xec, 0xaa, 0xc4, 0xae, 0x17, 0xf7, 0x7d, 0x65, 0xf2, 0xed, 0x9b, 0x7b, 0x3a, 0x1e, 0xfa, 0x1f,
+    0x51, 0x76, 0x7e, 0xfe, 0x11, 0x4a, 0x1a, 0x6d, 0xd4, 0x14, 0x39, 0x56, 0x00, 0x87, 0x5d, 0xaf,
+    0xfe, 0x58, 0x89, 0x32, 0x11, 0xac, 0x90, 0xe3, 0x05, 0x16, 0xe8, 0xba, 0x8c, 0x8f, 0xd4, 0x08,
+    0xbf, 0x7b, 0xd0, 0x08, 0x15, 0xea, 0x17, 0xd3, 0xcb, 0x5c, 0xba, 0x39, 0xbd, 0x46, 0x3f, 0xbe,
+    0x7b, 0x75, 0x49, 0xb1, 0x48, 0xe6, 0x17, 0x58, 0xe0, 0xac, 0x74, 0x53, 0x9e, 0x60, 0x95, 0x08,
+    0xd0, 0xff, 0xd5, 0x6a, 0xdb, 0x53, 0xd5, 0xbc, 0x05, 0x82, 0xad, 0x76, 0x1b, 0xfd, 0xf3, 0x0f,
+    0xbc, 0x24, 0x1c, 0x4d, 0xab, 0x5c, 0xe7, 0x0a, 0x7a, 0xe8, 0x32, 0xd2, 0x46, 0xeb, 0x23, 0x41,
+    0x65, 0x25, 0x72, 0x44, 0x78, 0x52, 0x65, 0x10, 0x13, 0x25, 0xf2, 0x22, 0xa5, 0x6a, 0xfa, 0xed,
+    0xea, 0x25, 0x51, 0x87, 0xe2, 0xa3, 0xcd, 0x4e, 0x4c, 0xf9, 0x2f, 0x3b, 0x88, 0x75, 0x10, 0x06,
+    0x34, 0x7e, 0x07, 0x4d, 0xcc, 0x50, 0x98, 0x81, 0xa8, 0x41, 0xa9, 0x65, 0x53, 0xe4, 0x5e, 0x97,
+    0xe8, 0xd1, 0x23, 0xc0, 0xef, 0x09, 0xe8, 0xea, 0xab, 0x4b, 0x68, 0xe5, 0x14, 0x8d, 0x46, 0x28,
+    0x50, 0xfb, 0xb0, 0x5a, 0xd2, 0x1c, 0xf4, 0xa3, 0xc7, 0xa8, 0xd5, 0x69, 0xc1, 0xb3, 0xd8, 0xce,
+    0x00, 0x30, 0x18, 0x35, 0xc0, 0x94, 0x71, 0xe5, 0xfd, 0x12, 0x14, 0x2b, 0x97, 0x7f, 0x79, 0xfd,
+    0xea, 0x7b, 0x29, 0x8b, 0x77, 0xf4, 0xaf, 0x8a, 0x96, 0xd0, 0xaa, 0xe2, 0xa3, 0xa5, 0xc7, 0x0b,
+    0x9a, 0xbb, 0xad, 0xef, 0x5e, 0x5c, 0xb5, 0x3a, 0xe8, 0x3d, 0x00, 0xfc, 0x46, 0xb7, 0x94, 0xab,
+    0xd1, 0xc3, 0xb5, 0xdc, 0x3c, 0xd2, 0xf3, 0x97, 0x30, 0x67, 0x76, 0xfe, 0x14, 0xe6, 0xd8, 0xce,
+    0xbf, 0x85, 0xf9, 0xc4, 0xce, 0x2f, 0x60, 0x5e, 0xd8, 0xf9, 0x73, 0x98, 0x93, 0x0d, 0x54, 0x87,
+    0x85, 0x9a, 0xd0, 0xc5, 0xe6, 0x7d, 0x07, 0x49, 0x51, 0x51, 0x6d, 0x4e, 0xe3, 0xde, 0x67, 0xa5,
+    0xd9, 0x3c, 0xc1, 0x39, 0x05, 0x18, 0x3a, 0x6f, 0x1d, 0xae, 0xf3, 0x94, 0x63, 0xe9, 0x3e, 0x74,
+    0x5b, 0x75, 0xdf, 0x6e, 0xb5, 0x3d, 0xdd, 0x98, 0x41, 0x89, 0xe2, 0x89, 0x95, 0x6f, 0xf0, 0x1b,
+    0x17, 0x56, 0x74, 0x90, 0x94, 0xe0, 0x10, 0xe9, 0x86, 0x64, 0xbf, 0x8d, 0x91, 0x2a, 0x58, 0xa0,
+    0x17, 0x7e, 0xe3, 0x0a, 0x08, 0xe8, 0x4f, 0x4a, 0xd6, 0x9c, 0x80, 0x3e, 0xa3, 0x5a, 0x56, 0x6b,
+    0x8f, 0x2f, 0x93, 0xa3, 0x28, 0x18, 0x74, 0x54, 0x48, 0xe0, 0x03, 0x4a, 0x60, 0xdc, 0x87, 0xdc,
+    0xac, 0x87, 0x58, 0x3d, 0x95, 0x81, 0x1b, 0x92, 0x7a, 0xe7, 0x86, 0xec, 0x41, 0xf7, 0xb5, 0x1e,
+    0xeb, 0xe6, 0x4d, 0x55, 0x06, 0x80, 0xab, 0x07, 0xbd, 0x1b, 0x3c, 0xb6, 0xdb, 0x71, 0x6d, 0xa4,
+    0x3e, 0xfe, 0x0d, 0x0a, 0x43, 0x14, 0xa1, 0xf0, 0xf8, 0x20, 0xd1, 0x78, 0x9e, 0x43, 0x59, 0x73,
+    0x4d, 0xb2, 0xd8, 0xe8, 0xff, 0x4c, 0x27, 0x97, 0x1c, 0xa4, 0xa4, 0xfb, 0xfe, 0xba, 0x8c, 0x7a,
+    0xbd, 0x87, 0xeb, 0x6d, 0xca, 0xcf, 0x79, 0x29, 0x37, 0xbd, 0x12, 0x48, 0x28, 0x7a, 0x8b, 0xa0,
+    0x27, 0xcc, 0x9b, 0x63, 0xcf, 0xef, 0x5d, 0x97, 0xef, 0x41, 0x33, 0xe4, 0x1b, 0xcf, 0x33, 0x5a,
+    0x96, 0x78, 0x06, 0x49, 0x88, 0x6a, 0x33, 0x2e, 0xad, 0xd1, 0x67, 0xb0, 0xfa, 0xc3, 0xe5, 0xdb,
+    0x37, 0x9e, 0x0e, 0x99, 0x4b, 0x3d, 0x82, 0x25, 0xb6, 0x01, 0xca, 0x3c, 0x56, 0xb4, 0x95, 0x57,
+    0xac, 0x00, 0x47, 0x18, 0x00, 0x13, 0xdf, 0x5f, 0xbd, 0x7e, 0x05, 0x12, 0x6a, 0x27, 0x3e, 0x82,
+    0x03, 0x60, 0x4f, 0x85, 0xeb, 0xf7, 0x3f, 0xda, 0xde, 0x94, 0x8b, 0x17, 0x38, 0x99, 0xbb, 0x5b,
+    0x1b, 0xa2, 0xbe, 0x10, 0xc2, 0x23, 0xe8, 0xab, 0x91, 0xce, 0x6f, 0x54, 0x87, 0x4b, 0xad, 0xb7,
+    0x8a, 0x96, 0x7a, 0x29, 0x15, 0xda, 0x46, 0xe3, 0x7d, 0xf3, 0xc0, 0x98, 0xf0, 0x0a, 0x4f, 0xf2,
+    0x73, 0xb6, 0xa4, 0xc4, 0x0d, 0x2d, 0xb4, 0x96, 0x68, 0x88, 0xde, 0x49, 0xba, 0x16, 0x16, 0xc0,
+    0xaf, 0xe2, 0xd8, 0x92, 0x91, 0xa4, 0xbc, 0xdc, 0xa3, 0x42, 0xa1, 0x04, 0xfe, 0xae, 0x58, 0x46,
+    0xa1, 0x4a, 0xb9, 0x36, 0x00, 0x1d, 0x14, 0xfa, 0xbe, 0x6f, 0xe4, 0x20, 0xb5, 0xea, 0xa8, 0x40,
+    0xd7, 0xb4, 0x35, 0x0a, 0x8a, 0x9d, 0x7e, 0x5d, 0xef, 0xe9, 0x7f, 0xef, 0xfc, 0x0b, 0x3a, 0xb7,
+    0x93, 0x33, 0xf4, 0x11, 0x00, 0x00,
+};
+
+// setup.html: 1238 bytes source, 1125 minified, 612 gzip
+static const uint8_t web_setup_html[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x54, 0x6b, 0x6f, 0x9b, 0x30,
+    0x14, 0xfd, 0x2b, 0x1e, 0xd1, 0x94, 0x56, 0x2a, 0xe1, 0xb1, 0x34, 0xe9, 0x80, 0x64, 0x9a, 0xba,
+    0xf5, 0x5b, 0xb5, 0xa9, 0xeb, 0x34, 0xed, 0xa3, 0xc1, 0x06, 0xae, 0x0a, 0x36, 0xb2, 0x4d, 0x1e,
+    0x8d, 0xf2, 0xdf, 0x77, 0x8d, 0x93, 0x36, 0x7d, 0x68, 0x20, 0x91, 0x70, 0xef, 0xf5, 0xb9, 0xe7,
+    0x1c, 0x5f, 0x93, 0x7d, 0xf8, 0xf6, 0xe3, 0xfa, 0xfe, 0xef, 0xcf, 0xef, 0xa4, 0x36, 0x6d, 0xb3,
+    0xcc, 0x0e, 0x4f, 0x4e, 0xd9, 0x32, 0x6b, 0xb9, 0xa1, 0xa4, 0xa8, 0xa9, 0xd2, 0xdc, 0x2c, 0xbc,
+    0xdf, 0xf7, 0x37, 0xfe, 0x95, 0x77, 0x88, 0x0a, 0xda, 0xf2, 0x85, 0xb7, 0x02, 0xbe, 0xee, 0xa4,
+    0x32, 0x1e, 0x29, 0xa4, 0x30, 0x5c, 0x60, 0xd5, 0x1a, 0x98, 0xa9, 0x17, 0x8c, 0xaf, 0xa0, 0xe0,
+    0xfe, 0xf0, 0x72, 0x01, 0x02, 0x0c, 0xd0, 0xc6, 0xd7, 0x05, 0x6d, 0xf8, 0x22, 0x42, 0x08, 0x03,
+    0xa6, 0xe1, 0xcb, 0x5b, 0x79, 0x4b, 0xc9, 0x9d, 0x34, 0xd4, 0x48, 0x45, 0x7e, 0x71, 0xd3, 0x77,
+    0x59, 0xe0, 0x32, 0x99, 0x36, 0x5b, 0xfc, 0xb1, 0x5c, 0x76, 0x25, 0x22, 0xfb, 0x25, 0x6d, 0xa1,
+    0xd9, 0x26, 0x5f, 0x15, 0xe2, 0xa4, 0x39, 0x2d, 0x1e, 0x2a, 0x25, 0x7b, 0xc1, 0x92, 0x51, 0x74,
+    0x65, 0xef, 0xb4, 0x90, 0x8d, 0x54, 0xc9, 0x88, 0x33, 0x7b, 0xef, 0x73, 0xc9, 0xb6, 0xbb, 0x96,
+    0x6e, 0x5c, 0xff, 0xe4, 0xd3, 0x2c, 0xec, 0x36, 0x69, 0x4b, 0x55, 0x05, 0x22, 0x09, 0x09, 0xed,
+    0x8d, 0x4c, 0x3b, 0xca, 0x18, 0x88, 0x2a, 0x89, 0x6d, 0xea, 0x04, 0x50, 0x55, 0xf9, 0x59, 0x3c,
+    0xbf, 0xf8, 0x1c, 0x5e, 0xcc, 0x67, 0xe7, 0x69, 0x2e, 0x15, 0xe3, 0xca, 0x57, 0x94, 0x41, 0xaf,
+    0x93, 0x28, 0xb6, 0xb5, 0x72, 0xe3, 0xeb, 0x9a, 0x32, 0xb9, 0x46, 0xa8, 0x90, 0x5c, 0x75, 0x1b,
+    0x32, 0x8a, 0xa2, 0x68, 0x5f, 0xc7, 0x8e, 0xa9, 0x86, 0x47, 0x9e, 0xc4, 0x8a, 0xb7, 0x2f, 0x5a,
+    0x60, 0x65, 0x74, 0x4a, 0x22, 0x35, 0x7c, 0x63, 0x7c, 0xda, 0x40, 0x25, 0x92, 0x02, 0x7d, 0xe3,
+    0x6a, 0x3f, 0xc9, 0x7b, 0x63, 0xa4, 0xd8, 0x31, 0xd0, 0x5d, 0x43, 0xb7, 0x49, 0xde, 0xc8, 0xe2,
+    0x21, 0x75, 0x0a, 0xa2, 0x30, 0xfc, 0x78, 0x5c, 0x6b, 0x59, 0x90, 0xf0, 0x09, 0x3d, 0x9a, 0x0d,
+    0xa4, 0x2c, 0x4f, 0x84, 0x2d, 0x7a, 0xa5, 0xd1, 0x88, 0x4e, 0x82, 0xc5, 0x7c, 0xe1, 0xd4, 0x34,
+    0x9e, 0xce, 0xf3, 0xf9, 0xd1, 0xa9, 0xb2, 0x2c, 0x5f, 0xa9, 0xb3, 0x38, 0xcf, 0x0a, 0xa2, 0x49,
+    0x64, 0x35, 0xbc, 0xa1, 0xe9, 0x22, 0x8c, 0x17, 0x52, 0x51, 0x03, 0x52, 0x24, 0x42, 0x0a, 0xee,
+    0x4c, 0x81, 0x47, 0xcb, 0xe7, 0x00, 0x8a, 0x91, 0xa3, 0xa2, 0xa4, 0x96, 0x2b, 0xae, 0x76, 0xa7,
+    0x5c, 0x2e, 0x8b, 0x59, 0xc4, 0xa6, 0x58, 0x60, 0x84, 0xcf, 0xa8, 0xa8, 0x5e, 0xa5, 0xf3, 0x39,
+    0x92, 0x8d, 0x4f, 0xd3, 0xef, 0x60, 0xb0, 0xe9, 0x25, 0x5e, 0xfb, 0x09, 0x83, 0x15, 0x30, 0x9b,
+    0x73, 0x8d, 0x8d, 0xec, 0x12, 0xeb, 0x90, 0x96, 0x0d, 0x30, 0x32, 0xc2, 0x92, 0xa3, 0x71, 0x6e,
+    0x1f, 0x4e, 0x1c, 0xdd, 0x67, 0x81, 0x9b, 0xb3, 0x2c, 0x70, 0xf3, 0x6e, 0xe7, 0x06, 0x67, 0x3f,
+    0x7e, 0x77, 0x32, 0x31, 0x9c, 0x51, 0x52, 0x2b, 0x5e, 0x2e, 0xbc, 0x40, 0xdb, 0x58, 0xb0, 0x8a,
+    0x02, 0xe5, 0x8a, 0x82, 0x30, 0x58, 0x43, 0x09, 0x78, 0x0e, 0x1a, 0xaa, 0xf5, 0xc2, 0x73, 0xca,
+    0xbd, 0xe5, 0x1f, 0xb8, 0x01, 0x0b, 0x60, 0xd0, 0x1a, 0x9d, 0x05, 0xf4, 0xff, 0x10, 0x78, 0x88,
+    0x4a, 0xa8, 0xdc, 0xd9, 0xd1, 0x6f, 0xb0, 0x8e, 0x7c, 0xae, 0x71, 0x93, 0x94, 0x6c, 0x06, 0x34,
+    0x14, 0x7f, 0x2c, 0x3b, 0xf8, 0x80, 0xa7, 0x2b, 0xc0, 0xbf, 0x28, 0x66, 0x58, 0xf6, 0x12, 0x84,
+    0x3c, 0x3b, 0xea, 0x11, 0x29, 0x8a, 0x06, 0x8a, 0x87, 0x85, 0x07, 0xe5, 0xd9, 0xd0, 0x59, 0xb5,
+    0x67, 0xe3, 0x3b, 0x8e, 0xbc, 0xc8, 0x40, 0xdb, 0xb1, 0xe9, 0xdd, 0x3e, 0x7f, 0x19, 0x9f, 0x9f,
+    0x13, 0x9c, 0xc8, 0xe1, 0x65, 0x32, 0x48, 0x18, 0x07, 0xca, 0x16, 0x8f, 0x91, 0xd9, 0xd3, 0xa2,
+    0x2c, 0x70, 0x8d, 0x90, 0x84, 0x33, 0x33, 0x18, 0xbe, 0x27, 0xff, 0x00, 0x0a, 0x79, 0xc4, 0xd2,
+    0x65, 0x04, 0x00, 0x00,
+};
+
+// wifi.html: 3433 bytes source, 3168 minified, 1386 gzip
+static const uint8_t web_wifi_html[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x57, 0xe1, 0x6e, 0xdb, 0x36,
+    0x10, 0xfe, 0x9f, 0xa7, 0xb8, 0x29, 0xdb, 0x64, 0x03, 0x96, 0x6c, 0x39, 0x71, 0xdc, 0x4a, 0xb6,
+    0x87, 0x26, 0x4d, 0xb1, 0x02, 0x5d, 0x5b, 0x2c, 0x19, 0x8a, 0xa1, 0x28, 0x56, 0x5a, 0xa4, 0x6c,
+    0x36, 0x34, 0x29, 0x50, 0x94, 0x63, 0xd7, 0xf5, 0xdb, 0xec, 0x4d, 0xf6, 0x62, 0x3b, 0x4a, 0xb2,
+    0x2d, 0x25, 0xee, 0xba, 0x3f, 0x85, 0x91, 0x44, 0x3e, 0x9e, 0xee, 0xbe, 0xfb, 0xbe, 0xbb, 0x93,
+    0x32, 0xfa, 0xe1, 0xf9, 0x9b, 0xab, 0xdb, 0x3f, 0xdf, 0x5e, 0xc3, 0xdc, 0x2c, 0xc4, 0x64, 0x54,
+    0xfd, 0x66, 0x84, 0x4e, 0x46, 0x0b, 0x66, 0x08, 0xc4, 0x73, 0xa2, 0x33, 0x66, 0xc6, 0xce, 0x1f,
+    0xb7, 0x2f, 0xbc, 0x27, 0x4e, 0x65, 0x95, 0x64, 0xc1, 0xc6, 0xce, 0x92, 0xb3, 0xfb, 0x54, 0x69,
+    0xe3, 0x40, 0xac, 0xa4, 0x61, 0x12, 0xbd, 0xee, 0x39, 0x35, 0xf3, 0x31, 0x65, 0x4b, 0x1e, 0x33,
+    0xaf, 0xf8, 0xd2, 0xe1, 0x92, 0x1b, 0x4e, 0x84, 0x97, 0xc5, 0x44, 0xb0, 0x71, 0x80, 0x21, 0x0c,
+    0x37, 0x82, 0x4d, 0xde, 0xf1, 0x17, 0x1c, 0xae, 0x94, 0x4c, 0xf8, 0x2c, 0xd7, 0xc4, 0x70, 0x25,
+    0x47, 0xdd, 0xf2, 0x64, 0x94, 0x99, 0x35, 0xfe, 0xb1, 0x58, 0x36, 0x09, 0x46, 0xf6, 0x12, 0xb2,
+    0xe0, 0x62, 0x1d, 0x3e, 0xd3, 0x18, 0x27, 0x9a, 0x92, 0xf8, 0x6e, 0xa6, 0x55, 0x2e, 0x69, 0x78,
+    0x1a, 0x3c, 0xb1, 0x9f, 0x28, 0x56, 0x42, 0xe9, 0xf0, 0x94, 0x51, 0xfb, 0xd9, 0x4e, 0x15, 0x5d,
+    0x6f, 0x16, 0x64, 0x55, 0xe6, 0x0f, 0xcf, 0x2e, 0x7a, 0xe9, 0x2a, 0x5a, 0x10, 0x3d, 0xe3, 0x32,
+    0xec, 0x01, 0xc9, 0x8d, 0x8a, 0x52, 0x42, 0x29, 0x97, 0xb3, 0xb0, 0x6f, 0x8f, 0x6a, 0x01, 0xf5,
+    0x6c, 0xda, 0xea, 0x0f, 0x3b, 0x4f, 0x7b, 0x9d, 0xe1, 0x45, 0x3b, 0x9a, 0x2a, 0x4d, 0x99, 0xf6,
+    0x34, 0xa1, 0x3c, 0xcf, 0xc2, 0xa0, 0x6f, 0x7d, 0xd5, 0xca, 0xcb, 0xe6, 0x84, 0xaa, 0x7b, 0x0c,
+    0xd5, 0x83, 0x27, 0xe9, 0x0a, 0x4e, 0x83, 0x20, 0xd8, 0xce, 0xfb, 0x25, 0xd2, 0x8c, 0x7f, 0x66,
+    0x61, 0x5f, 0xb3, 0x45, 0x23, 0x05, 0x7a, 0x06, 0x75, 0x10, 0x91, 0x61, 0x2b, 0xe3, 0x11, 0xc1,
+    0x67, 0x32, 0x8c, 0x91, 0x37, 0xa6, 0xb7, 0x89, 0xd2, 0x8b, 0x4d, 0x09, 0x38, 0xe8, 0xf5, 0x7e,
+    0x2a, 0x13, 0xf1, 0xcf, 0x36, 0x42, 0x05, 0x03, 0x2d, 0x5b, 0x41, 0xa6, 0x4c, 0x6c, 0x28, 0xcf,
+    0x52, 0x41, 0xd6, 0xe1, 0x54, 0xa8, 0xf8, 0x6e, 0x17, 0x34, 0x18, 0x14, 0x79, 0xf0, 0x77, 0x74,
+    0x40, 0x12, 0xf8, 0x81, 0xc5, 0x52, 0xf1, 0x93, 0xd0, 0x18, 0x63, 0x6f, 0xb9, 0x4c, 0x73, 0xf3,
+    0xde, 0xac, 0x53, 0x36, 0x76, 0x2d, 0x10, 0xf7, 0x43, 0xa7, 0x6e, 0x4a, 0x49, 0x96, 0xdd, 0x63,
+    0x4a, 0xf7, 0x43, 0x1d, 0xcf, 0xae, 0x9c, 0x82, 0x85, 0x2a, 0x65, 0x99, 0xd1, 0x26, 0xae, 0xa8,
+    0x0a, 0xf1, 0x10, 0x32, 0x25, 0x38, 0x85, 0x53, 0x76, 0xc6, 0x08, 0x3b, 0x7b, 0xc0, 0xe1, 0xe0,
+    0x31, 0xdd, 0x83, 0x41, 0x27, 0x38, 0x1b, 0x76, 0x86, 0x83, 0x76, 0x53, 0xc6, 0x7a, 0x15, 0xb6,
+    0x86, 0xe3, 0x84, 0x3c, 0xae, 0x25, 0x0c, 0x91, 0x9b, 0x98, 0xcd, 0x95, 0x40, 0x9f, 0xaf, 0x14,
+    0xd6, 0xf0, 0xd9, 0x54, 0x69, 0x09, 0x21, 0x8d, 0x70, 0x59, 0x3e, 0x5d, 0x70, 0x0c, 0xf8, 0x80,
+    0xee, 0x1a, 0x27, 0x15, 0x0d, 0x75, 0x85, 0xf7, 0x34, 0x5d, 0x1c, 0x48, 0xe9, 0x45, 0x71, 0xae,
+    0x33, 0x4c, 0x91, 0x2a, 0x6e, 0xb5, 0x6e, 0x74, 0xf0, 0x79, 0xff, 0x7c, 0x38, 0x1d, 0xee, 0x15,
+    0x4a, 0x92, 0x07, 0x8c, 0x5d, 0x1c, 0xd3, 0xf3, 0x71, 0xfb, 0x1c, 0x03, 0x1e, 0xce, 0xd5, 0x12,
+    0xcb, 0xab, 0x67, 0x1b, 0xc4, 0x17, 0x01, 0x3d, 0xdf, 0xfa, 0xd6, 0xe6, 0x09, 0x2e, 0xef, 0x1e,
+    0x14, 0xf7, 0x28, 0x70, 0x55, 0xa3, 0x67, 0x54, 0x5a, 0x0e, 0x4b, 0xa3, 0x95, 0x4a, 0x7f, 0xca,
+    0x62, 0x55, 0x0e, 0x70, 0x28, 0x95, 0x64, 0xb5, 0xe8, 0x15, 0x82, 0x43, 0x71, 0xdb, 0x51, 0xb7,
+    0x9c, 0xed, 0x51, 0xb7, 0xdc, 0x31, 0x76, 0x56, 0x71, 0xdf, 0xf4, 0x8f, 0x6e, 0x03, 0x34, 0x8f,
+    0xec, 0x5c, 0x00, 0x89, 0xad, 0x61, 0xec, 0x74, 0x71, 0x13, 0xe5, 0x69, 0x77, 0x19, 0x74, 0xb5,
+    0x32, 0xc4, 0x28, 0xdd, 0xed, 0x75, 0x33, 0xb2, 0x64, 0x0e, 0xe0, 0x56, 0x9a, 0x2b, 0x3a, 0x76,
+    0xde, 0xbe, 0xb9, 0xb9, 0xc5, 0x0d, 0x53, 0xcc, 0xc9, 0xe4, 0xe6, 0xe6, 0xe5, 0x73, 0x68, 0xbd,
+    0x66, 0x06, 0x55, 0xbf, 0x83, 0xd7, 0xb8, 0xb3, 0xda, 0xe1, 0xa8, 0x5b, 0x9e, 0x8d, 0x28, 0x5f,
+    0x42, 0x81, 0x65, 0xec, 0xec, 0x38, 0x48, 0x04, 0x5b, 0x45, 0x33, 0x92, 0x86, 0x38, 0xd6, 0x51,
+    0xc1, 0x82, 0xc7, 0x0d, 0x5b, 0x64, 0x4d, 0x2e, 0x76, 0x6d, 0x8f, 0x6c, 0x60, 0xa6, 0x8c, 0x09,
+    0x16, 0x1b, 0xe0, 0x98, 0x3b, 0xcb, 0x38, 0xfd, 0x4b, 0xf0, 0x0c, 0xf7, 0x61, 0x15, 0xd8, 0x06,
+    0x0c, 0x83, 0xe6, 0xec, 0x7c, 0xf7, 0x49, 0x41, 0x50, 0xdd, 0x12, 0x15, 0xd2, 0x9b, 0x1b, 0xa3,
+    0x24, 0x14, 0x7d, 0xe1, 0x94, 0x5f, 0x9c, 0x12, 0x6b, 0x4c, 0xe4, 0xa5, 0x91, 0x7b, 0xa4, 0x75,
+    0x88, 0x10, 0x9c, 0x7f, 0x97, 0xe6, 0xed, 0xf9, 0x4f, 0x07, 0x05, 0xbe, 0x1b, 0x4c, 0x3e, 0xea,
+    0x96, 0x70, 0x10, 0x2c, 0x2a, 0xd1, 0x90, 0xa3, 0x71, 0x47, 0x6d, 0x7d, 0xc5, 0x71, 0xbc, 0x93,
+    0xc0, 0xbb, 0x28, 0x35, 0xe8, 0x5b, 0x0d, 0xde, 0xfd, 0xf3, 0xf7, 0x5c, 0x30, 0x60, 0x5c, 0xc2,
+    0xbb, 0x57, 0xcf, 0x5e, 0xe3, 0x86, 0xcf, 0x00, 0x41, 0xc0, 0x2b, 0x94, 0x82, 0x81, 0xb2, 0x97,
+    0x86, 0xa7, 0x29, 0x03, 0xca, 0x19, 0x14, 0x3d, 0xb1, 0x20, 0x32, 0x67, 0x42, 0xf8, 0x55, 0xee,
+    0x62, 0x78, 0x2a, 0x92, 0x6c, 0x47, 0x3b, 0x07, 0x39, 0xad, 0x27, 0x11, 0x4e, 0xf5, 0xc0, 0x6b,
+    0x98, 0x6a, 0x2b, 0x64, 0xec, 0x5c, 0x5b, 0x6e, 0x40, 0x56, 0xad, 0x66, 0xbd, 0xf7, 0x5d, 0xf8,
+    0xb6, 0x5a, 0x3b, 0x87, 0xd6, 0xab, 0xe7, 0xdb, 0x2d, 0xa5, 0x5d, 0x8a, 0xc3, 0xf7, 0x23, 0xf1,
+    0x77, 0x87, 0xd0, 0x52, 0xa9, 0x9d, 0x08, 0x22, 0xda, 0x4e, 0x33, 0x5c, 0x39, 0xfb, 0x0e, 0x2c,
+    0x89, 0xc8, 0xf1, 0xeb, 0x0d, 0x0e, 0x07, 0x10, 0x49, 0xe1, 0x77, 0x96, 0x19, 0x82, 0x4f, 0x6a,
+    0xa4, 0xdb, 0x4e, 0xd4, 0x64, 0x44, 0x60, 0xae, 0x59, 0xf2, 0x95, 0x91, 0xb2, 0x26, 0x7c, 0xa8,
+    0x0b, 0x4c, 0x87, 0x6d, 0xb3, 0x9b, 0x66, 0x67, 0xf2, 0xb3, 0x20, 0x5a, 0x47, 0x70, 0x89, 0x16,
+    0x30, 0x0a, 0x6e, 0xac, 0xdf, 0xa8, 0x4b, 0x70, 0x0a, 0x62, 0xcd, 0x53, 0x33, 0xc1, 0xd7, 0x80,
+    0xcc, 0x00, 0x36, 0x1f, 0x8c, 0x81, 0xaa, 0x38, 0x5f, 0xe0, 0xdc, 0xf8, 0x33, 0x66, 0xae, 0x05,
+    0xb3, 0x97, 0x97, 0xeb, 0x97, 0xb4, 0xe5, 0xee, 0xc7, 0xc4, 0x6d, 0x47, 0x27, 0xd5, 0x1d, 0x68,
+    0x7a, 0x59, 0x54, 0xf1, 0xad, 0xfb, 0x4a, 0xf2, 0xed, 0x9d, 0x49, 0x2e, 0x8b, 0xad, 0x80, 0xe9,
+    0x0c, 0x76, 0x72, 0x6b, 0xda, 0x01, 0xb3, 0x32, 0x1d, 0x14, 0x39, 0x6b, 0xc3, 0xe6, 0x64, 0xea,
+    0x5b, 0x25, 0xaf, 0xca, 0xf7, 0x12, 0x0c, 0x8b, 0x67, 0x11, 0x1a, 0xf1, 0x94, 0x4c, 0x05, 0xa3,
+    0x36, 0x11, 0xcf, 0xac, 0xa5, 0x68, 0x3a, 0x5f, 0xa5, 0x24, 0xe6, 0x66, 0x5d, 0x9a, 0xe1, 0x17,
+    0xe8, 0xf9, 0x43, 0x08, 0x21, 0x88, 0x4e, 0xb6, 0x87, 0x44, 0x09, 0x17, 0xa2, 0x65, 0x81, 0xdb,
+    0xf8, 0x58, 0xa4, 0xcf, 0xa5, 0x64, 0xfa, 0xd7, 0xdb, 0xdf, 0x5e, 0xe1, 0x6d, 0xae, 0xbb, 0x2b,
+    0x06, 0xa5, 0xe9, 0xd5, 0xeb, 0x88, 0x35, 0x23, 0x86, 0x55, 0xa5, 0xb4, 0xdc, 0x52, 0x39, 0x5b,
+    0x81, 0x75, 0xf4, 0x0b, 0xa1, 0xaa, 0xfb, 0x0b, 0x43, 0x13, 0xb6, 0xeb, 0x79, 0x48, 0x73, 0xb1,
+    0x62, 0x8a, 0x0d, 0xe9, 0x79, 0xe8, 0x67, 0x73, 0x13, 0x6c, 0x68, 0x49, 0xaf, 0xe6, 0x5c, 0x50,
+    0xdb, 0x0c, 0x3d, 0x8c, 0x67, 0xa1, 0xf9, 0xa8, 0xee, 0x35, 0x89, 0xe7, 0x2d, 0x09, 0xe3, 0x09,
+    0xc2, 0xac, 0x20, 0xfd, 0x3f, 0x3c, 0x7b, 0x30, 0xd2, 0xb7, 0x64, 0x5b, 0x4b, 0x13, 0xcd, 0xc7,
+    0x1f, 0x37, 0xe5, 0xd1, 0x16, 0x5a, 0xf6, 0x52, 0xe3, 0xf5, 0x16, 0xe8, 0xe5, 0xa2, 0xfd, 0xf1,
+    0x08, 0x2a, 0x0c, 0xb9, 0xb5, 0x3f, 0x27, 0x24, 0x5b, 0xcb, 0x18, 0x0e, 0x82, 0xe1, 0xf8, 0xb7,
+    0xda, 0x7b, 0x70, 0xd3, 0xff, 0x14, 0xbd, 0xdc, 0x53, 0x16, 0xde, 0x41, 0x67, 0xd7, 0x2e, 0x10,
+    0x89, 0xeb, 0xca, 0xf7, 0x7d, 0x17, 0x65, 0xd7, 0x39, 0xc3, 0x73, 0xa3, 0xd7, 0xfb, 0x98, 0x1a,
+    0x63, 0x92, 0x7b, 0xc2, 0x0d, 0x24, 0xcc, 0x20, 0x1b, 0xee, 0xd1, 0x36, 0xc7, 0x28, 0x87, 0x1e,
+    0xfc, 0xb4, 0xbf, 0x45, 0xfb, 0x9f, 0x32, 0x85, 0x08, 0xb1, 0xc7, 0xac, 0xe2, 0x9f, 0xfc, 0x6a,
+    0xac, 0x33, 0xf8, 0xf2, 0x05, 0xde, 0x7f, 0xb0, 0x25, 0x41, 0x4c, 0x30, 0x2c, 0xb4, 0x98, 0x2d,
+    0x03, 0x5f, 0x6b, 0x35, 0x12, 0x69, 0x41, 0x41, 0x42, 0x38, 0x76, 0x97, 0x5b, 0xf8, 0x24, 0x1c,
+    0x07, 0x54, 0xac, 0x8b, 0x66, 0x69, 0x40, 0x47, 0xcc, 0x09, 0x11, 0x19, 0x2b, 0xc8, 0xd9, 0x9e,
+    0x7c, 0xbb, 0x78, 0x1f, 0xb7, 0xf3, 0xf5, 0x12, 0xed, 0xc5, 0x4a, 0xc3, 0xa6, 0x6b, 0xb9, 0xb1,
+    0xe0, 0xf1, 0x1d, 0x06, 0xb2, 0x3e, 0xed, 0x8a, 0xfc, 0xc7, 0x4e, 0x73, 0x22, 0x67, 0x0c, 0xbd,
+    0x90, 0x6e, 0xdb, 0x0e, 0xc0, 0x13, 0x68, 0x59, 0xd7, 0x42, 0x68, 0xc4, 0x7e, 0x98, 0xbc, 0xbd,
+    0xf6, 0xfb, 0xe3, 0x08, 0xb6, 0x60, 0xf5, 0xbb, 0xe7, 0x12, 0x5f, 0x77, 0x8f, 0x44, 0x17, 0x8a,
+    0xd0, 0x3d, 0x02, 0x7c, 0xe6, 0x94, 0x3b, 0x00, 0x17, 0x7b, 0xf1, 0x4c, 0xef, 0x16, 0xff, 0x4a,
+    0xfc, 0x0b, 0x61, 0x28, 0x41, 0x6c, 0x60, 0x0c, 0x00, 0x00,
+};
+
+// wifi_info.html: 1365 bytes source, 1153 minified, 641 gzip
+static const uint8_t web_wifi_info_html[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x54, 0x5b, 0x6f, 0x9b, 0x30,
+    0x14, 0x7e, 0xcf, 0xaf, 0xf0, 0xe8, 0x43, 0x40, 0x0a, 0x90, 0x26, 0x6b, 0xd5, 0x02, 0x41, 0xda,
+    0x7a, 0x5b, 0xa5, 0x5d, 0x2a, 0xb5, 0xd3, 0xb4, 0x47, 0x83, 0x0f, 0xc1, 0xad, 0xb1, 0x91, 0xed,
+    0x94, 0xa4, 0x51, 0xfe, 0xfb, 0x0e, 0x90, 0x64, 0x4d, 0x2b, 0x6d, 0xb2, 0xe4, 0xd8, 0xe7, 0x7c,
+    0xe7, 0xe2, 0xef, 0x3b, 0x24, 0xf9, 0x70, 0xf9, 0xe3, 0xe2, 0xe1, 0xf7, 0xdd, 0x15, 0x29, 0x6d,
+    0x25, 0xd2, 0x64, 0xbb, 0x03, 0x65, 0x69, 0x52, 0x81, 0xa5, 0x24, 0x2f, 0xa9, 0x36, 0x60, 0x67,
+    0xce, 0xcf, 0x87, 0x6b, 0xff, 0xcc, 0x49, 0x13, 0xcb, 0xad, 0x80, 0xf4, 0x17, 0xbf, 0xe6, 0xe4,
+    0x42, 0x03, 0x03, 0x69, 0x39, 0x15, 0x26, 0x09, 0x7b, 0x7b, 0x62, 0xec, 0x0a, 0x7f, 0x32, 0xc5,
+    0x56, 0xeb, 0x42, 0x49, 0xeb, 0x17, 0xb4, 0xe2, 0x62, 0x15, 0x7d, 0xd2, 0x88, 0x1a, 0x19, 0x2a,
+    0x8d, 0x6f, 0x40, 0xf3, 0x22, 0xae, 0xa8, 0x9e, 0x73, 0x19, 0x7d, 0x1c, 0xd7, 0xcb, 0x38, 0xa3,
+    0xf9, 0xd3, 0x5c, 0xab, 0x85, 0x64, 0xd1, 0x51, 0x31, 0x6e, 0xd7, 0x26, 0xc8, 0x31, 0x98, 0x72,
+    0x09, 0x7a, 0xfd, 0xca, 0xdb, 0x94, 0xdc, 0x42, 0x5c, 0x53, 0xc6, 0xb8, 0x9c, 0x47, 0xd3, 0x2e,
+    0x56, 0x69, 0x06, 0xda, 0xd7, 0x94, 0xf1, 0x85, 0x89, 0xce, 0xd0, 0x52, 0xd1, 0xa5, 0xdf, 0x70,
+    0x66, 0xcb, 0xe8, 0x64, 0x3c, 0xee, 0xee, 0x5d, 0xa5, 0x31, 0xa1, 0x0b, 0xab, 0x10, 0xbf, 0xf4,
+    0x4d, 0x49, 0x99, 0x6a, 0xd0, 0x32, 0xa9, 0x97, 0xe4, 0x18, 0x31, 0x44, 0xcf, 0x33, 0xea, 0x8e,
+    0x47, 0xdd, 0x0a, 0x8e, 0xbd, 0x4d, 0x39, 0x59, 0xe7, 0x4a, 0x28, 0x1d, 0x1d, 0x4d, 0xa7, 0xd3,
+    0x6d, 0x06, 0xdf, 0xaa, 0x3a, 0x6a, 0x3b, 0xdb, 0xbf, 0x7a, 0xbd, 0x4d, 0x3d, 0x69, 0x53, 0x8c,
+    0xf7, 0x7d, 0x1d, 0x9f, 0xbc, 0x7d, 0xd3, 0x59, 0xbb, 0xde, 0xb4, 0x8a, 0xa0, 0x4d, 0x20, 0x68,
+    0x06, 0xa2, 0x27, 0xaa, 0x01, 0x3e, 0x2f, 0x6d, 0x94, 0x29, 0xc1, 0xe2, 0x6d, 0xed, 0xd3, 0xd3,
+    0xd3, 0x5d, 0xed, 0x4c, 0x59, 0xab, 0xaa, 0x3e, 0xe8, 0x99, 0x8a, 0x05, 0x1c, 0xb0, 0x5b, 0x29,
+    0xa9, 0x4c, 0x4d, 0x73, 0x88, 0x5f, 0x75, 0xdd, 0x60, 0x39, 0x3f, 0xd3, 0x40, 0x9f, 0xa2, 0x6e,
+    0xf7, 0xa9, 0x10, 0x9b, 0x00, 0xaa, 0xda, 0xae, 0x76, 0x8f, 0x3b, 0x3f, 0x3f, 0x8f, 0xbb, 0x3c,
+    0x9d, 0x6a, 0x11, 0xb7, 0x54, 0xf0, 0x7c, 0x93, 0x84, 0xbd, 0x88, 0x49, 0xd8, 0xcf, 0x41, 0x2b,
+    0x66, 0x9a, 0x30, 0xfe, 0x4c, 0x72, 0x41, 0x8d, 0x99, 0x39, 0x7b, 0x6d, 0x70, 0x1c, 0xca, 0x49,
+    0x7a, 0x03, 0xa6, 0x06, 0x9e, 0x97, 0xa0, 0x2d, 0x90, 0xf7, 0x83, 0x81, 0x88, 0x83, 0xe0, 0xbd,
+    0xcf, 0x39, 0xb0, 0x77, 0x54, 0x38, 0xe9, 0xfd, 0xfd, 0xed, 0x25, 0x71, 0xbf, 0x83, 0x7d, 0x69,
+    0x40, 0x3f, 0x49, 0x5a, 0x81, 0x17, 0x25, 0x21, 0xe2, 0x0e, 0xc0, 0x1d, 0x05, 0x0e, 0xe1, 0x6c,
+    0xe6, 0x18, 0xc3, 0x19, 0x66, 0xea, 0x21, 0xef, 0x80, 0xff, 0xa9, 0x76, 0x87, 0x97, 0x96, 0xa7,
+    0x7f, 0x97, 0xa8, 0xb7, 0xa8, 0x37, 0x65, 0xfa, 0xdd, 0xe4, 0x9a, 0xd7, 0x36, 0x2d, 0x16, 0x32,
+    0xb7, 0x5c, 0x49, 0x62, 0x4a, 0xd5, 0xb8, 0x9c, 0x8d, 0x88, 0x85, 0xa5, 0xf5, 0xc8, 0x7a, 0x80,
+    0x6c, 0x19, 0x4b, 0x40, 0x90, 0x19, 0x61, 0x2a, 0x5f, 0x54, 0xd8, 0x4e, 0x30, 0x07, 0x7b, 0x25,
+    0xa0, 0x3d, 0x7e, 0x5e, 0xdd, 0x32, 0x84, 0x7b, 0xf1, 0x80, 0x17, 0xc4, 0xdd, 0xc5, 0x80, 0x08,
+    0xda, 0xe3, 0x05, 0x12, 0x8d, 0x18, 0x8c, 0x6c, 0x6f, 0xf1, 0x60, 0x83, 0x69, 0x0c, 0xf4, 0x7e,
+    0x2e, 0x51, 0x80, 0x2f, 0x0f, 0xdf, 0xbe, 0xa2, 0x77, 0x98, 0xa0, 0xfa, 0x72, 0xd7, 0x79, 0x27,
+    0xb1, 0x93, 0xba, 0x12, 0x35, 0xb1, 0x64, 0x0e, 0xf8, 0xf9, 0xbe, 0x58, 0x0f, 0x55, 0x45, 0x4c,
+    0x3a, 0xc4, 0x2c, 0xb8, 0x0a, 0xb0, 0x79, 0xe9, 0x0e, 0xc3, 0x86, 0x17, 0x3c, 0xfc, 0x4b, 0x92,
+    0x19, 0x7a, 0x81, 0x2d, 0x41, 0xba, 0x9a, 0xcc, 0x52, 0xa2, 0x83, 0x47, 0xa3, 0xa4, 0xeb, 0x6d,
+    0x6d, 0x8f, 0xad, 0x6d, 0x3d, 0xe8, 0x1e, 0x38, 0x6c, 0x69, 0x1f, 0x8e, 0xc8, 0x63, 0xd0, 0x1e,
+    0xb0, 0xfb, 0xde, 0xba, 0x63, 0xaa, 0xf3, 0xec, 0x2e, 0xe8, 0xdd, 0x78, 0x31, 0xd6, 0xef, 0x99,
+    0x4a, 0xc2, 0x7e, 0xa0, 0xc2, 0xee, 0xbf, 0xe6, 0x0f, 0x59, 0x14, 0xde, 0xea, 0x81, 0x04, 0x00,
+    0x00,
+};
+
+const WebAsset webAssets[] = {
+    {"panel.html", "text/html; charset=UTF-8", web_panel_html, sizeof(web_panel_html), "\"51f5baa05ca6522a\""},
+    {"setup.html", "text/html; charset=UTF-8", web_setup_html, sizeof(web_setup_html), "\"bc864ca5f7cd8bbb\""},
+    {"wifi.html", "text/html; charset=UTF-8", web_wifi_html, sizeof(web_wifi_html), "\"d084646cffaf0ded\""},
+    {"wifi_info.html", "text/html; charset=UTF-8", web_wifi_info_html, sizeof(web_wifi_info_html), "\"a4ec85983a77b7ae\""},
+};
+
+const size_t webAssetCount = sizeof(webAssets) / sizeof(webAssets[0]);
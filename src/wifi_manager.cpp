@@ -1,19 +1,55 @@
 #include "wifi_manager.h"
 #include "servo_control.h"
+#include "angle_math.h"
+#include "move_sequence.h"
 #include "display_control.h"
+#include "alpaca_handlers.h"
+#include "alpaca_response.h"
+#include "event_log.h"
+#include "json_writer.h"
+#include "web_assets.h"
+#include "task_monitor.h"
+#include "profiler.h"
+#include "boot_status.h"
+#include "position_journal.h"
+
+#define NET_TASK_STACK 3072
+#define NET_TASK_PRIORITY 1
+#define NET_DNS_INTERVAL_MS 10         // captive portal DNS while the access point runs
+#define NET_IDLE_INTERVAL_MS 500       // station mode: only watch for a fallback to AP
+#define NET_BUDGET_US 2000
 
 // Access Point configuration
 const char *apSSID = "MoMaRoTa";
 IPAddress apIP(192, 168, 1, 1);
 static DNSServer dnsServer;
 static Preferences preferences;
+static WiFiLinkStats linkStats;
+static bool everConnected = false;
+static TaskHandle_t netTask = nullptr;
 
 // ============================================================================
 // WIFI INITIALIZATION & CONNECTION
 // ============================================================================
 
+// Runs in the WiFi event task
+static void onWiFiEvent(arduino_event_id_t event) {
+    if(event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+        linkStats.disconnects++;
+    } else if(event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+        if(everConnected) linkStats.reconnects++;
+        everConnected = true;
+    }
+}
+
 void initWiFi() {
+    WiFi.onEvent(onWiFiEvent);
     connectWiFi();
+    bootStageDone(BOOT_NETWORK);
+}
+
+WiFiLinkStats getWiFiLinkStats() {
+    return linkStats;
 }
 
 void connectWiFi() {
@@ -71,6 +107,12 @@ void connectWiFi() {
         Serial.print("Signal strength (RSSI): ");
         Serial.print(WiFi.RSSI());
         Serial.println(" dBm");
+
+        // UTC wall clock for Alpaca time stamps (DeviceState), synced in the background
+        configTime(0, 0, "pool.ntp.org");
+
+        // Link-local IPv6 address for Alpaca discovery over IPv6
+        WiFi.enableIpV6();
     } else {
         Serial.println("\nConnection failed!");
         Serial.print("WiFi status: ");
@@ -103,6 +145,28 @@ void processDNS() {
     }
 }
 
+// Network housekeeping next to the WiFi driver on TASK_CORE_NETWORK
+static void networkTask(void *param) {
+    int slot = taskMonitorAdd("net", TASK_CORE_NETWORK, NET_BUDGET_US, NET_TASK_STACK);
+    int64_t dueUs = esp_timer_get_time();
+    for(;;) {
+        taskWorkBegin(slot, dueUs);
+        ProfileFrame frame;
+        profileBegin(frame);
+        processDNS();
+        profileMark(frame, STAGE_NET_DNS);
+        profileEnd(frame, "net");
+        taskWorkEnd(slot);
+        bool ap = WiFi.getMode() == WIFI_AP || WiFi.getMode() == WIFI_AP_STA;
+        taskDelayUntil(dueUs, (ap ? NET_DNS_INTERVAL_MS : NET_IDLE_INTERVAL_MS) * 1000);
+    }
+}
+
+void startNetworkTask() {
+    if(netTask) return;
+    xTaskCreatePinnedToCore(networkTask, "net", NET_TASK_STACK, nullptr, NET_TASK_PRIORITY, &netTask, TASK_CORE_NETWORK);
+}
+
 String getIPAddress() {
     if (WiFi.status() == WL_CONNECTED) {
         return WiFi.localIP().toString();
@@ -115,6 +179,87 @@ String getIPAddress() {
 // SETUP ENDPOINTS
 // ============================================================================
 
+// Rotator selected by the control panel (optional "dev" argument, default 0)
+static int panelDevice(AsyncWebServerRequest *request) {
+    return request->hasArg("dev") ? request->arg("dev").toInt() : 0;
+}
+
+// Embedded page from web/ (gzip in flash, sent without a copy); 304 when the browser's copy is current
+static void sendWebAsset(AsyncWebServerRequest *request, const char *name) {
+    const WebAsset *asset = nullptr;
+    for (size_t i = 0; i < webAssetCount; i++) {
+        if (strcmp(webAssets[i].name, name) == 0) {
+            asset = &webAssets[i];
+            break;
+        }
+    }
+    if (!asset) {
+        request->send(404, "text/plain", "Not Found");
+        return;
+    }
+
+    AsyncWebServerResponse *response;
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == asset->etag) {
+        response = request->beginResponse(304);
+    } else {
+        response = request->beginResponse_P(200, asset->contentType, asset->data, asset->length);
+        response->addHeader("Content-Encoding", "gzip");
+    }
+    response->addHeader("ETag", asset->etag);
+    response->addHeader("Cache-Control", "no-cache");  // revalidate: pages change with the firmware
+    request->send(response);
+}
+
+// Control panel command (HTTP /cmd and the panel WebSocket). Moves pass the
+// same check as the Alpaca move handlers; returns why one was refused, or nullptr
+const char *handlePanelCommand(int dev, int cmdI, double cmdP) {
+    bool move = cmdI == 1 || cmdI == 5 || cmdI == 6 || cmdI == 17;
+    if (move) {
+        const char *reason = moveRefusal(dev);
+        if (reason) return reason;
+    }
+    switch(cmdI) {
+        case 1:  // 90° button
+            requestMoveTo(dev, degreesToSteps(90.0, getStepsPerRev(dev)));
+            break;
+        case 2:  // Stop (also ends a running sequence)
+            abortSequence(dev);
+            requestHalt(dev);
+            break;
+        case 5:  // 180° button
+            requestMoveTo(dev, degreesToSteps(180.0, getStepsPerRev(dev)));
+            break;
+        case 6:  // 0° button
+            requestMoveTo(dev, 0);
+            break;
+        case 7:  // Speed +
+            setActiveSpeed(dev, getActiveSpeed(dev) + 100);
+            break;
+        case 8:  // Speed -
+            setActiveSpeed(dev, getActiveSpeed(dev) - 100);
+            break;
+        case 17: // Goto position
+            requestMoveTo(dev, degreesToSteps(cmdP, getStepsPerRev(dev)));
+            break;
+        case 18: // Set zero
+            setZeroPointExact(dev);
+            break;
+        case 20: // Display OFF
+            displayOff();
+            break;
+        case 21: // Display ON
+            displayOn();
+            break;
+        case 22: // Reverse ON
+            setReverseDirection(dev, true);
+            break;
+        case 23: // Reverse OFF
+            setReverseDirection(dev, false);
+            break;
+    }
+    return nullptr;
+}
+
 void setupWiFiEndpoints(AsyncWebServer &server) {
     server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
         AsyncWebServerResponse *response = request->beginResponse(302, "text/plain", "Redirecting...");
@@ -155,7 +300,7 @@ void setupWiFiEndpoints(AsyncWebServer &server) {
     server.on("/setup/v1/rotator/0/configdevices", HTTP_GET, handleConfigDevices);
     server.on("/reset", HTTP_GET, handleResetWifi);
     
-    // Endpoint to retrieve stored WiFi credentials (JSON format)
+    // Endpoint to retrieve stored WiFi credentials (JSON format, also feeds /wifi/info)
     server.on("/wifi/credentials", HTTP_GET, [](AsyncWebServerRequest *request) {
         Preferences preferences;
         preferences.begin("wifi_config", true);
@@ -163,62 +308,25 @@ void setupWiFiEndpoints(AsyncWebServer &server) {
         String password = preferences.getString("password", "");
         preferences.end();
         
-        String json = "{";
-        json += "\"ssid\":\"" + ssid + "\",";
-        json += "\"password\":\"" + password + "\"";
-        json += "}";
+        char buffer[256];
+        JsonWriter json(buffer, sizeof(buffer));
+        json.beginObject();
+        json.key("ssid").string(ssid.c_str());
+        json.key("password").string(password.c_str());
+        json.endObject();
         
-        request->send(200, "application/json", json);
+        request->send(200, "application/json", json.c_str());
     });
     
-    // Endpoint to retrieve stored WiFi credentials (HTML format)
+    // Stored WiFi credentials (HTML page, values from /wifi/credentials)
     server.on("/wifi/info", HTTP_GET, [](AsyncWebServerRequest *request) {
-        Preferences preferences;
-        preferences.begin("wifi_config", true);
-        String ssid = preferences.getString("ssid", "");
-        String password = preferences.getString("password", "");
-        preferences.end();
-        
-        String html = "<!DOCTYPE html><html><head>";
-        html += "<meta charset='UTF-8'>";
-        html += "<title>WiFi Credentials</title>";
-        html += "<style>";
-        html += "body { font-family: Arial, sans-serif; margin: 40px; background: #f0f0f0; }";
-        html += ".container { background: white; padding: 30px; border-radius: 8px; max-width: 500px; margin: 0 auto; box-shadow: 0 2px 10px rgba(0,0,0,0.1); }";
-        html += "h2 { color: #333; margin-top: 0; }";
-        html += ".credential { margin: 20px 0; padding: 15px; background: #f8f8f8; border-radius: 5px; }";
-        html += ".label { font-weight: bold; color: #666; margin-bottom: 5px; }";
-        html += ".value { font-family: monospace; color: #333; word-break: break-all; }";
-        html += ".empty { color: #999; font-style: italic; }";
-        html += "</style></head><body>";
-        html += "<div class='container'>";
-        html += "<h2>Gespeicherte WiFi Credentials</h2>";
-        html += "<div class='credential'>";
-        html += "<div class='label'>SSID (Netzwerkname):</div>";
-        html += "<div class='value'>";
-        if (ssid.length() > 0) {
-            html += ssid;
-        } else {
-            html += "<span class='empty'>(nicht gesetzt)</span>";
-        }
-        html += "</div></div>";
-        html += "<div class='credential'>";
-        html += "<div class='label'>Password:</div>";
-        html += "<div class='value'>";
-        if (password.length() > 0) {
-            html += password;
-        } else {
-            html += "<span class='empty'>(nicht gesetzt)</span>";
-        }
-        html += "</div></div>";
-        html += "</div></body></html>";
-        
-        request->send(200, "text/html; charset=UTF-8", html);
+        sendWebAsset(request, "wifi_info.html");
     });
     
     // Position and status endpoints (needed by control panel JavaScript)
     server.on("/setup/v1/rotator/0/position", HTTP_GET, [](AsyncWebServerRequest *request) {
-        double pos = getServoAngle();
+        int dev = panelDevice(request);
+        double pos = stepsToDegrees(getLastServoSteps(dev), getStepsPerRev(dev));   // polled, no bus access
         String posValue = String(pos, 2);
         request->send(200, "text/plain", posValue);
     });
@@ -228,49 +336,180 @@ void setupWiFiEndpoints(AsyncWebServer &server) {
         request->send(200, "text/plain", ip);
     });
     
+    // Servo bus throughput benchmark: ?start=1&ms=2000 starts a run (two phases of ms each),
+    // without arguments the last result is returned
+    server.on("/setup/v1/rotator/0/busbench", HTTP_GET, [](AsyncWebServerRequest *request) {
+        if (request->hasArg("start")) {
+            int ms = request->hasArg("ms") ? request->arg("ms").toInt() : 2000;
+            startBusBenchmark(constrain(ms, 100, 10000));
+        }
+        BusBenchResult r = getBusBenchmarkResult();
+        String json = "{\"running\":" + String(r.running ? "true" : "false") + ",";
+        json += "\"buses\":" + String(r.activeBuses) + ",";
+        json += "\"rotators\":" + String(getRotatorCount()) + ",";
+        json += "\"phaseMs\":" + String(r.durationMs) + ",";
+        json += "\"oneBusSamplesPerSec\":" + String(r.oneBusSamplesPerSec, 1) + ",";
+        json += "\"parallelSamplesPerSec\":" + String(r.parallelSamplesPerSec, 1) + "}";
+        request->send(200, "application/json", json);
+    });
+
+    // What boot did per servo: link from the cache or a scan, EEPROM profile check
+    // (read-compare-write), position journal restore; ?forget=1 makes the next
+    // boot scan, ?journal=flush writes the position journal now (mid-move it
+    // only helps a restart: a power cycle discards an in-flight entry)
+    server.on("/setup/v1/rotator/0/servoboot", HTTP_GET, [](AsyncWebServerRequest *request) {
+        if (request->hasArg("forget")) forgetServoLinkCache();
+        if (request->arg("journal") == "flush") flushPositionJournal();
+        ServoLinkResult link = getServoLinkResult();
+        PositionJournalStats j = getPositionJournalStats();
+        String json = "{\"ready\":" + String(isServoReady() ? "true" : "false") + ",";
+        json += "\"resetReason\":\"" + String(getResetReasonName()) + "\",";
+        json += "\"link\":{\"cached\":" + String(link.cached ? "true" : "false") + ",";
+        json += "\"us\":" + String(link.linkUs) + "},";
+        json += "\"journal\":{\"loadUs\":" + String(j.loadUs) + ",";
+        json += "\"writes\":" + String(j.writes) + ",";
+        json += "\"folded\":" + String(j.folded) + ",";
+        json += "\"shutdownWrites\":" + String(j.shutdownWrites) + ",";
+        json += "\"dirty\":" + String(j.dirty ? "true" : "false") + ",";
+        json += "\"lastWriteAgeMs\":" + String(j.lastWriteUs ? (long)((esp_timer_get_time() - j.lastWriteUs) / 1000) : -1L) + ",";
+        json += "\"lastWriteDurationUs\":" + String(j.lastWriteDurationUs) + "},\"rotators\":[";
+        for (int dev = 0; dev < getRotatorCount(); dev++) {
+            ServoConfigResult c = getServoConfigResult(dev);
+            PositionRestore p = getPositionRestore(dev);
+            if (dev > 0) json += ",";
+            json += "{\"dev\":" + String(dev) + ",";
+            json += "\"bus\":" + String(getServoBus(dev)) + ",";
+            json += "\"id\":" + String(getMotorID(dev)) + ",";
+            json += "\"model\":" + (getServoModel(dev) ? String(getServoModel(dev)) : String("null")) + ",";   // null: not readable
+            json += "\"eeprom\":{\"verified\":" + String(c.verified ? "true" : "false") + ",";
+            json += "\"bytesChanged\":" + String(c.bytesChanged) + ",";
+            json += "\"writes\":" + String(c.writes) + ",";
+            json += "\"writesAvoided\":" + String(c.writesAvoided) + ",";
+            json += "\"durationUs\":" + String(c.durationUs) + ",";
+            json += "\"savedMs\":" + String(c.savedMs) + "},";
+            json += "\"restore\":{\"state\":\"" + String(restoreStateName(p.state)) + "\",";
+            json += "\"inFlight\":" + String(p.inFlight ? "true" : "false") + ",";
+            json += "\"position\":" + String(p.position) + ",";
+            json += "\"residual\":" + String(p.residual) + "}}";
+        }
+        json += "]}";
+        request->send(200, "application/json", json);
+    });
+
+    // Alpaca response path cost: handler CPU time, heap held per request, response pool
+    server.on("/setup/v1/rotator/0/alpacastats", HTTP_GET, [](AsyncWebServerRequest *request) {
+        if (request->hasArg("reset")) {
+            resetAlpacaRequestStats();
+            resetMotionStats();
+        }
+        AlpacaRequestStats rq = getAlpacaRequestStats();
+        AlpacaResponseStats rs = getAlpacaResponseStats();
+        MotionStats ms = getMotionStats();
+        uint32_t n = rq.requests ? rq.requests : 1;
+        String json = "{\"requests\":" + String(rq.requests) + ",";
+        json += "\"avgUs\":" + String((double)rq.totalUs / n, 1) + ",";
+        json += "\"maxUs\":" + String(rq.maxUs) + ",";
+        json += "\"budgetUs\":" + String(ALPACA_HANDLER_BUDGET_US) + ",";
+        json += "\"overBudget\":" + String(rq.overBudget) + ",";
+        json += "\"avgHeapBytes\":" + String((double)rq.heapBytes / n, 1) + ",";
+        json += "\"minFreeHeap\":" + String(rq.minFreeHeap) + ",";
+        json += "\"responses\":" + String(rs.responses) + ",";
+        json += "\"poolMisses\":" + String(rs.poolMisses) + ",";
+        json += "\"overflows\":" + String(rs.overflows) + ",";
+        json += "\"maxResponseBytes\":" + String(rs.maxLength) + ",";
+        json += "\"discoveryReplies\":" + String(getDiscoveryReplies()) + ",";
+        json += "\"motion\":{\"requests\":" + String(ms.requests) + ",";
+        json += "\"applied\":" + String(ms.applied) + ",";
+        json += "\"merged\":" + String(ms.merged) + ",";
+        json += "\"lastDelayUs\":" + String(ms.lastDelayUs) + ",";
+        json += "\"maxDelayUs\":" + String(ms.maxDelayUs) + "}}";
+        request->send(200, "application/json", json);
+    });
+
+    // Adaptive polling: configured rates (set via args) and achieved intervals per bus
+    // Gear ratio per rotator (NVS, applied at once); ?dev=1&ratio=3 sets 1:3,
+    // refused (409) while that rotator moves, runs a sequence or is not ready
+    server.on("/setup/v1/rotator/0/gear", HTTP_GET, [](AsyncWebServerRequest *request) {
+        if (request->hasArg("ratio")) {
+            int dev = request->arg("dev").toInt();
+            if (moveRefusal(dev) || !setGearRatio(dev, request->arg("ratio").toInt())) {
+                request->send(409, "text/plain", "Gear ratio not set (1-" + String(GEAR_RATIO_MAX) + ", rotator standing still)");
+                return;
+            }
+        }
+        String json = "{\"rotators\":[";
+        for (int dev = 0; dev < getRotatorCount(); dev++) {
+            if (dev > 0) json += ",";
+            json += "{\"dev\":" + String(dev) + ",";
+            json += "\"ratio\":" + String(getGearRatio(dev)) + ",";
+            json += "\"stepsPerRev\":" + String(getStepsPerRev(dev)) + "}";
+        }
+        json += "]}";
+        request->send(200, "application/json", json);
+    });
+
+    server.on("/setup/v1/rotator/0/polling", HTTP_GET, [](AsyncWebServerRequest *request) {
+        PollSchedule s = getPollSchedule();
+        bool changed = false;
+        if (request->hasArg("motionMs")) { s.motionMs = request->arg("motionMs").toInt(); changed = true; }
+        if (request->hasArg("idleMs")) { s.idleMs = request->arg("idleMs").toInt(); changed = true; }
+        if (request->hasArg("slowMs")) { s.slowMs = request->arg("slowMs").toInt(); changed = true; }
+        if (request->hasArg("modeMs")) { s.modeMs = request->arg("modeMs").toInt(); changed = true; }
+        if (request->hasArg("lingerMs")) { s.lingerMs = request->arg("lingerMs").toInt(); changed = true; }
+        if (changed) {
+            setPollSchedule(s);
+            s = getPollSchedule();
+        }
+
+        static const char *tierNames[POLL_TIER_COUNT] = {"position", "slow", "mode"};
+        String json = "{\"schedule\":{\"motionMs\":" + String(s.motionMs) + ",";
+        json += "\"idleMs\":" + String(s.idleMs) + ",";
+        json += "\"slowMs\":" + String(s.slowMs) + ",";
+        json += "\"modeMs\":" + String(s.modeMs) + ",";
+        json += "\"lingerMs\":" + String(s.lingerMs) + "},\"buses\":[";
+        for (int b = 0; b < MAX_SERVO_BUSES; b++) {
+            BusPollStats st = getBusPollStats(b);
+            if (b > 0) json += ",";
+            json += "{\"bus\":" + String(b) + ",";
+            json += "\"enabled\":" + String(st.enabled ? "true" : "false") + ",";
+            json += "\"rotators\":" + String(st.rotators) + ",";
+            json += "\"moving\":" + String(st.moving ? "true" : "false") + ",";
+            json += "\"occupancyPercent\":" + String(st.occupancyPercent, 2) + ",";
+            json += "\"transactions\":" + String(st.transactions);
+            for (int t = 0; t < POLL_TIER_COUNT; t++) {
+                const PollTierStats &ts = st.tiers[t];
+                json += ",\"" + String(tierNames[t]) + "\":{\"count\":" + String(ts.count) + ",";
+                json += "\"lastMs\":" + String(ts.lastIntervalUs / 1000.0f, 1) + ",";
+                json += "\"avgMs\":" + String(ts.avgIntervalUs / 1000.0f, 1) + ",";
+                json += "\"maxMs\":" + String(ts.maxIntervalUs / 1000.0f, 1) + "}";
+            }
+            json += "}";
+        }
+        // Link health per rotator: offline ones are only probed, their state is the last known
+        json += "],\"links\":[";
+        int64_t now = esp_timer_get_time();
+        for (int dev = 0; dev < getRotatorCount(); dev++) {
+            LinkHealth link = getLinkHealth(dev);
+            if (dev > 0) json += ",";
+            json += "{\"dev\":" + String(dev) + ",";
+            json += "\"state\":\"" + String(linkStateName(link.state)) + "\",";
+            json += "\"consecutiveErrors\":" + String(link.consecutiveErrors) + ",";
+            json += "\"outages\":" + String(link.outages) + ",";
+            json += "\"probes\":" + String(link.probes) + ",";
+            json += "\"probeIntervalMs\":" + String(link.probeIntervalMs) + ",";
+            json += "\"sinceMs\":" + String(link.changedUs ? (uint32_t)((now - link.changedUs) / 1000) : 0) + "}";
+        }
+        json += "]}";
+        request->send(200, "application/json", json);
+    });
+
     // Control panel command handler (register both short and full paths)
     auto cmdHandler = [](AsyncWebServerRequest *request) {
-        int cmdT = request->arg("inputT").toInt();
-        int cmdI = request->arg("inputI").toInt();
-        double cmdP = request->arg("inputP").toDouble();
-        
-        switch(cmdI) {
-            case 1:  // 90° button
-                moveServoToAngle(90.0);
-                break;
-            case 2:  // Stop
-                stopServo();
-                break;
-            case 5:  // 180° button
-                moveServoToAngle(180.0);
-                break;
-            case 6:  // 0° button
-                moveServoToAngle(0.0);
-                break;
-            case 7:  // Speed +
-                setActiveSpeed(getActiveSpeed() + 100);
-                break;
-            case 8:  // Speed -
-                setActiveSpeed(getActiveSpeed() - 100);
-                break;
-            case 17: // Goto position
-                moveServoToAngle(cmdP);
-                break;
-            case 18: // Set zero
-                setZeroPointExact();
-                break;
-            case 20: // Display OFF
-                displayOff();
-                break;
-            case 21: // Display ON
-                displayOn();
-                break;
-            case 22: // Reverse ON
-                setReverseDirection(true);
-                break;
-            case 23: // Reverse OFF
-                setReverseDirection(false);
-                break;
+        const char *refused = handlePanelCommand(panelDevice(request), request->arg("inputI").toInt(),
+                                                 request->arg("inputP").toDouble());
+        if (refused) {
+            request->send(409, "text/plain", refused);
+            return;
         }
         request->send(200, "text/plain", "OK");
     };
@@ -280,7 +519,8 @@ void setupWiFiEndpoints(AsyncWebServer &server) {
 
     
     server.on("/position", HTTP_GET, [](AsyncWebServerRequest *request) {
-        double pos = getServoAngle();
+        int dev = panelDevice(request);
+        double pos = stepsToDegrees(getLastServoSteps(dev), getStepsPerRev(dev));   // polled, no bus access
         String posValue = String(pos, 2);
         request->send(200, "text/plain", posValue);
     });
@@ -303,88 +543,13 @@ void handleCaptivePortal(AsyncWebServerRequest *request) {
 }
 
 void handleSetupPage(AsyncWebServerRequest *request) {
-    String html = "<!DOCTYPE html><html><head>";
-    html += "<meta charset='UTF-8'><meta name='viewport' content='width=device-width,initial-scale=1'>";
-    html += "<title>MoMa Rotator Setup</title>";
-    html += "<style>";
-    html += "html{font-family:Arial;background:#181818;color:#ededed}";
-    html += "body{max-width:360px;margin:0 auto;padding:20px;background:rgb(27,90,76);border-radius:12px;box-shadow:0 0 8px #111}";
-    html += "h2{font-size:2rem;padding:20px 0 10px;margin:0;text-align:center}";
-    html += ".button{display:block;width:100%;margin:12px 0;padding:16px;border:0;cursor:pointer;background:#4247b7;color:#fff;border-radius:6px;font-size:1.1rem;text-align:center;text-decoration:none;box-sizing:border-box}";
-    html += ".button:hover{background:#5c61d4}";
-    html += ".btn-danger{background:#b74242}";
-    html += ".btn-danger:hover{background:#d45555}";
-    html += ".divider{border-top:2px solid #555;margin:20px 0;width:100%}";
-    html += "</style>";
-    html += "</head><body>";
-    html += "<h2>MoMa Rotator Setup</h2>";
-    html += "<a href='/setup/v1/rotator/0/wifi' class='button'>WiFi Settings</a>";
-    html += "<a href='/setup/v1/rotator/0/configdevices' class='button'>Rotator Control</a>";
-    html += "<div class='divider'></div>";
-    html += "<button class='button btn-danger' onclick='if(confirm(\"Reset WiFi configuration?\")) location.href=\"/reset\"'>Reset WiFi</button>";
-    html += "</body></html>";
-
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/html; charset=UTF-8", html);
-    request->send(response);
+    sendWebAsset(request, "setup.html");
 }
 
 void handleWifiSetupPage(AsyncWebServerRequest *request) {
-    Serial.println("WiFi setup page requested");
-
-    String html = "<!DOCTYPE html><html><head>";
-    html += "<meta charset='UTF-8'><meta name='viewport' content='width=device-width,initial-scale=1'>";
-    html += "<title>WiFi Configuration</title>";
-    html += "<style>";
-    html += "html{font-family:Arial;background:#181818;color:#ededed}";
-    html += "body{max-width:360px;margin:0 auto;padding:20px;background:rgb(27,90,76);border-radius:12px;box-shadow:0 0 8px #111}";
-    html += "h2{font-size:2rem;padding:20px 0 10px;margin:0;text-align:center}";
-    html += "form{width:100%;box-sizing:border-box}";
-    html += "label{display:block;margin:15px 0 5px;font-size:1.1rem;color:#fdc100}";
-    html += "input[type='text'],input[type='password']{width:100%;padding:12px;margin:5px 0 15px;border:2px solid #e3eae3;border-radius:5px;background:rgb(55,137,75);color:#ededed;font-size:1rem;box-sizing:border-box}";
-    html += "input[type='text']::placeholder,input[type='password']::placeholder{color:#aaa}";
-    html += "input[type='submit']{display:block;width:100%;margin:20px 0 10px;padding:16px;border:0;cursor:pointer;background:#4247b7;color:#fff;border-radius:6px;font-size:1.1rem;text-align:center}";
-    html += "input[type='submit']:hover{background:#5c61d4}";
-    html += ".back-link{display:block;text-align:center;margin-top:20px;color:#fdc100;text-decoration:none}";
-    html += ".back-link:hover{color:#fff}";
-    html += "</style>";
-    html += "</head><body>";
-    html += "<h2>WiFi Configuration</h2>";
-    html += "<form action='/setup/v1/rotator/0/save' method='POST'>";
-    html += "<label>SSID (Network Name):</label>";
-    html += "<div style='display:flex;gap:8px;align-items:center;margin:5px 0 10px'>";
-    html += "<select id='ssid_list' style='flex:1;padding:12px;border:2px solid #e3eae3;border-radius:5px;background:rgb(55,137,75);color:#ededed;font-size:1rem'></select>";
-    html += "<button type='button' id='scanBtn' style='padding:12px 14px;border:0;cursor:pointer;background:#4247b7;color:#fff;border-radius:6px;font-size:0.95rem'>Scan</button>";
-    html += "</div>";
-    html += "<div style='font-size:0.9rem;color:#ccc;margin:-6px 0 12px'>Wähle ein WLAN aus der Liste oder tippe die SSID manuell.</div>";
-    html += "<input type='text' id='ssid_manual' name='ssid_manual' placeholder='Enter network name'>";
-    html += "<label>Password:</label>";
-    html += "<input type='password' name='password' placeholder='Enter password (optional)'>";
-    html += "<input type='submit' value='Save and Restart'>";
-    html += "</form>";
-    html += "<a href='/setup/v1/rotator/0/setup' class='back-link'>&larr; Back to Setup</a>";
-    html += "<script>";
-    html += "const sel=document.getElementById('ssid_list');";
-    html += "const ssidInput=document.getElementById('ssid_manual');";
-    html += "function setBtn(b,txt,dis){b.textContent=txt;b.disabled=dis;b.style.opacity=dis?0.7:1;}";
-    html += "function fill(list){sel.innerHTML='';";
-    html += "const opt0=document.createElement('option');opt0.value='';opt0.textContent='-- Select WiFi --';sel.appendChild(opt0);";
-    html += "list.forEach(n=>{const o=document.createElement('option');o.value=n.ssid;o.textContent=`${n.ssid} (${n.rssi} dBm)`;sel.appendChild(o);});";
-    html += "}";
-    html += "async function scan(){";
-    html += "const b=document.getElementById('scanBtn');setBtn(b,'Scanning...',true);";
-    html += "try{const r=await fetch('/setup/v1/rotator/0/scan');const j=await r.json();";
-    html += "fill(j.networks||[]);}";
-    html += "catch(e){alert('Scan failed');}";
-    html += "finally{setBtn(document.getElementById('scanBtn'),'Scan',false);}";
-    html += "}";
-    html += "document.getElementById('scanBtn').addEventListener('click',scan);";
-    html += "sel.addEventListener('change',()=>{if(sel.value){ssidInput.value=sel.value;}});";
-    html += "window.addEventListener('load',scan);";
-    html += "</script>";
-    html += "</body></html>";
+    LOG_I(LOG_TAG_WIFI, "WiFi setup page requested");
 
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/html; charset=UTF-8", html);
-    request->send(response);
+    sendWebAsset(request, "wifi.html");
 }
 
 void handleSaveWifi(AsyncWebServerRequest *request) {
@@ -415,13 +580,13 @@ void handleSaveWifi(AsyncWebServerRequest *request) {
 }
 
 void handleResetWifi(AsyncWebServerRequest *request) {
-    Serial.println("WiFi reset requested");
+    LOG_I(LOG_TAG_WIFI, "WiFi reset requested");
 
     preferences.begin("wifi_config", false);
     preferences.clear();
     preferences.end();
 
-    Serial.println("WiFi credentials cleared");
+    LOG_I(LOG_TAG_WIFI, "WiFi credentials cleared");
 
     String html = "<h2>WiFi configuration reset! Restarting...</h2>";
     AsyncWebServerResponse *response = request->beginResponse(200, "text/html; charset=UTF-8", html);
@@ -432,89 +597,6 @@ void handleResetWifi(AsyncWebServerRequest *request) {
 }
 
 void handleConfigDevices(AsyncWebServerRequest *request) {
-    // Embedded HTML for control panel
-    String html = "<!DOCTYPE html><html><head>";
-    html += "<meta charset='UTF-8'><meta name='viewport' content='width=device-width,initial-scale=1'>";
-    html += "<title>MoMa Rotator Panel</title>";
-    html += "<style>";
-    html += "html{font-family:Arial;background:#181818;color:#ededed}";
-    html += "body{max-width:360px;margin:0 auto;padding:20px;background:rgb(27,90,76);border-radius:12px;box-shadow:0 0 8px #111}";
-    html += "h2{font-size:2rem;padding:20px 0 10px;margin:0;text-align:center}";
-    html += ".centered{display:flex;justify-content:center;align-items:center;margin-bottom:12px}";
-    html += ".section{display:flex;align-items:center;justify-content:center;margin-bottom:8px;gap:8px}";
-    html += "label{margin:0 8px 0 0;font-size:1.1rem}";
-    html += ".small-label{font-size:0.85rem;color:#ddd;margin:2px 0 8px;text-align:center}";
-    html += ".output-field{font-size:1.3rem;background:#e3a71d;padding:12px;border-radius:5px;text-align:center;border:1px solid #870b0b;min-width:100px;margin-bottom:4px}";
-    html += "input[type='number']{width:120px;height:28px;font-size:1.1rem;padding:4px 8px;border-radius:4px;border:2px solid #e3eae3;background:rgb(55,137,75);color:#ededed;text-align:center}";
-    html += ".button{margin:4px;padding:6px 12px;border:0;cursor:pointer;background:#4247b7;color:#fff;border-radius:6px;font-size:0.95rem;min-width:70px}";
-    html += ".button-stop{margin:4px;padding:6px 12px;border:0;cursor:pointer;background:#b74242;color:#fff;border-radius:6px;font-size:0.95rem;min-width:70px}";
-    html += ".button:hover{background:#ff494d}";
-    html += ".divider{border-top:2px solid #555;margin:20px 0;width:100%}";
-    html += ".section-title{text-align:center;font-size:1.2rem;margin:15px 0 10px;color:#fdc100}";
-    html += ".output-line{display:flex;color:#ccc;font-size:0.95em;justify-content:center;margin-top:20px}";
-    html += "</style></head><body>";
-    html += "<h2>Rotator Panel</h2>";
-    html += "<div class='centered' style='flex-direction:column'>";
-    html += "<label>Position in &deg;</label>";
-    html += "<div class='output-field' id='virtual-pos'>0.0</div></div>";
-    html += "<div style='display:flex;align-items:center;justify-content:center;gap:8px;margin-bottom:8px'>";
-    html += "<input type='number' id='posInput' min='-360' max='360' step='0.1' value='0'>";
-    html += "<button class='button' onclick='gotoTarget()'>Goto</button></div>";
-    html += "<div class='centered' style='gap:8px'><label style='font-size:0.95rem'>Reverse:</label>";
-    html += "<input type='checkbox' id='reverseCheckbox' onchange='toggleReverse()' style='width:auto;height:18px'>";
-    html += "</div>";
-    html += "<div class='small-label'>(-360 .. +360&deg;)</div>";
-    html += "<div class='divider'></div>";
-    html += "<div class='section-title'>Goto Position ...</div>";
-    html += "<div class='section'>";
-    html += "<button class='button-stop' onclick='cmd(1,2)'>Stop</button>";
-    html += "<button class='button' onclick='cmd(1,6)'>0&deg;</button>";
-    html += "<button class='button' onclick='cmd(1,1)'>90&deg;</button>";
-    html += "<button class='button' onclick='cmd(1,5)'>180&deg;</button></div>";
-    html += "<div class='section'>";
-    html += "<button class='button' onclick='moveToAngle(270)'>270&deg;</button>";
-    html += "<button class='button' onclick='moveToAngle(360)'>360&deg;</button></div>";
-    html += "<div class='divider'></div>";
-    html += "<div class='section-title'>Sync Current Position as</div>";
-    html += "<div class='section'>";
-    html += "<button class='button' onclick='cmd(1,18)'>Zero</button></div>";
-    html += "<div class='section'><label>Speed:</label>";
-    html += "<button class='button' onclick='cmd(1,7)'>+</button>";
-    html += "<button class='button' onclick='cmd(1,8)'>-</button></div>";
-    html += "<div class='divider'></div>";
-    html += "<div class='centered' style='gap:8px'><label style='font-size:0.95rem'>Display:</label>";
-    html += "<button class='button' onclick='cmd(1,21)' style='min-width:50px'>ON</button>";
-    html += "<button class='button' onclick='cmd(1,20)' style='min-width:50px'>OFF</button></div>";
-    html += "<div class='output-line' id='ip'>--.--.--.--</div>";
-    html += "<script>";
-    html += "function cmd(t,i,a=0,b=0,p=0,d=0){";
-    html += "var x=new XMLHttpRequest();";
-    html += "x.open('GET',`cmd?inputT=${t}&inputI=${i}&inputA=${a}&inputB=${b}&inputP=${p}&inputD=${d}`,true);";
-    html += "x.send();}";
-    html += "function gotoTarget(){";
-    html += "var val=parseFloat(document.getElementById('posInput').value);";
-    html += "if(isNaN(val)||val<-360||val>360){alert('Value -360 to +360');return;}";
-    html += "cmd(1,17,0,0,val,0);}";
-    html += "function moveToAngle(angle){cmd(1,17,0,0,angle,0);}";
-    html += "function getData(){";
-    html += "var x=new XMLHttpRequest();";
-    html += "x.onreadystatechange=function(){";
-    html += "if(this.readyState==4&&this.status==200){";
-    html += "document.getElementById('virtual-pos').innerHTML=parseFloat(this.responseText).toFixed(2);}};";
-    html += "x.open('GET','position',true);x.send();}";
-    html += "function getIP(){";
-    html += "var x=new XMLHttpRequest();";
-    html += "x.onreadystatechange=function(){";
-    html += "if(this.readyState==4&&this.status==200){";
-    html += "document.getElementById('ip').innerHTML=this.responseText;}};";
-    html += "x.open('GET','printip',true);x.send();}";
-    html += "function toggleReverse(){";
-    html += "var checked=document.getElementById('reverseCheckbox').checked;";
-    html += "cmd(1,checked?22:23);}";
-    html += "setInterval(getData,300);";
-    html += "setInterval(getIP,1200);";
-    html += "</script></body></html>";
-
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/html; charset=UTF-8", html);
-    request->send(response);
+    // Control panel: static page, state arrives over the panel WebSocket
+    sendWebAsset(request, "panel.html");
 }
@@ -0,0 +1,937 @@
+// ============================================================================
+// Host harness: Alpaca and setup handlers against a simulated web server
+// ============================================================================
+// Build & run on Linux (not part of the PlatformIO firmware build):
+//   g++ -O2 -std=gnu++17 -Itools/host -Iinclude tools/alpaca_host.cpp tools/host/*.cpp src/alpaca_handlers.cpp src/alpaca_response.cpp src/move_sequence.cpp src/metrics.cpp src/wifi_manager.cpp src/web_assets.cpp src/event_log.cpp src/task_monitor.cpp src/profiler.cpp src/boot_status.cpp src/position_journal.cpp -o alpaca_host
+//   ./alpaca_host              # checks, exit code 1 on any failure
+//   ./alpaca_host --bench [n]  # handler cost per endpoint, n requests each
+//   ./alpaca_host --listen [port]  # serve the handlers on 127.0.0.1:port (8080)
+//
+// The firmware sources are compiled unchanged against tools/host: the
+// ESPAsyncWebServer subset (requests from URL, form body and headers; the
+// response drained through the same _fillBuffer path), a counted heap and
+// simulated rotators. Checks cover routing, parameter parsing, JSON output
+// and Alpaca error numbers; the benchmark reports time and heap allocations
+// per request. On the device, /metrics and /setup/v1/rotator/0/alpacastats
+// report the real figures.
+//
+// --listen puts a minimal HTTP/1.x front end over the same server so network
+// clients (alpaca_load, curl, ConformU) can run without a device:
+//   ./alpaca_host --listen 8080 &
+//   ./alpaca_load --host 127.0.0.1 --port 8080 --connections 4 --duration 10
+// One thread polls all connections; the simulated bus completes queued moves
+// between requests. Latencies are those of a PC, not of the ESP32.
+// ============================================================================
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "host_platform.h"
+#include "alpaca_handlers.h"
+#include "alpaca_response.h"
+#include "wifi_manager.h"
+#include "metrics.h"
+#include "task_monitor.h"
+#include "profiler.h"
+#include "boot_status.h"
+#include "position_journal.h"
+#include "event_log.h"
+#include "servo_control.h"
+#include "display_control.h"
+#include "angle_math.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static AsyncWebServer server(80);
+static int checks = 0;
+static int failures = 0;
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+static void check(bool ok, const char *what, int line) {
+    checks++;
+    if(ok) return;
+    failures++;
+    printf("  FAIL line %d: %s\n", line, what);
+}
+
+static std::unique_ptr<AsyncWebServerRequest> call(WebRequestMethod method, const char *url, const char *body = nullptr) {
+    std::unique_ptr<AsyncWebServerRequest> request(new AsyncWebServerRequest(method, url, body));
+    server.hostHandle(*request);
+    return request;
+}
+
+// ============================================================================
+// JSON
+// ============================================================================
+
+// Strict RFC 8259 syntax check (no duplicate-key or number range checks)
+struct JsonParser {
+    const char *p;
+
+    void space() { while(*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++; }
+    bool literal(const char *word) {
+        size_t n = strlen(word);
+        if(strncmp(p, word, n) != 0) return false;
+        p += n;
+        return true;
+    }
+    bool string() {
+        if(*p++ != '"') return false;
+        while(*p != '"') {
+            if((unsigned char)*p < 0x20) return false;
+            if(*p++ == '\\') {
+                if(*p == 'u') {
+                    for(int i = 1; i <= 4; i++) if(!isxdigit((unsigned char)p[i])) return false;
+                    p += 5;
+                } else if(!strchr("\"\\/bfnrt", *p++)) {
+                    return false;
+                }
+            }
+        }
+        p++;
+        return true;
+    }
+    bool number() {
+        if(*p == '-') p++;
+        if(*p == '0') p++;
+        else if(isdigit((unsigned char)*p)) while(isdigit((unsigned char)*p)) p++;
+        else return false;
+        if(*p == '.') {
+            p++;
+            if(!isdigit((unsigned char)*p)) return false;
+            while(isdigit((unsigned char)*p)) p++;
+        }
+        if(*p == 'e' || *p == 'E') {
+            p++;
+            if(*p == '+' || *p == '-') p++;
+            if(!isdigit((unsigned char)*p)) return false;
+            while(isdigit((unsigned char)*p)) p++;
+        }
+        return true;
+    }
+    bool value() {
+        space();
+        switch(*p) {
+            case '{': {
+                p++;
+                space();
+                if(*p == '}') { p++; return true; }
+                for(;;) {
+                    space();
+                    if(!string()) return false;
+                    space();
+                    if(*p++ != ':' || !value()) return false;
+                    space();
+                    if(*p == '}') { p++; return true; }
+                    if(*p++ != ',') return false;
+                }
+            }
+            case '[': {
+                p++;
+                space();
+                if(*p == ']') { p++; return true; }
+                for(;;) {
+                    if(!value()) return false;
+                    space();
+                    if(*p == ']') { p++; return true; }
+                    if(*p++ != ',') return false;
+                }
+            }
+            case '"': return string();
+            case 't': return literal("true");
+            case 'f': return literal("false");
+            case 'n': return literal("null");
+            default: return number();
+        }
+    }
+};
+
+static bool jsonValid(const std::string &text) {
+    JsonParser parser{text.c_str()};
+    if(!parser.value()) return false;
+    parser.space();
+    return *parser.p == '\0';
+}
+
+// Raw text of the first "key": value in the document (string values with quotes)
+static std::string jsonField(const std::string &text, const char *key) {
+    std::string pattern = std::string("\"") + key + "\":";
+    size_t start = text.find(pattern);
+    if(start == std::string::npos) return "<missing>";
+    JsonParser parser{text.c_str() + start + pattern.size()};
+    const char *begin = parser.p;
+    if(!parser.value()) return "<invalid>";
+    return std::string(begin, parser.p - begin);
+}
+
+// Alpaca device call: HTTP 200, valid JSON envelope; returns ErrorNumber
+static int alpacaError(const AsyncWebServerRequest &r) {
+    if(r.hostCode != 200 || !jsonValid(r.hostBody)) return -1;
+    return atoi(jsonField(r.hostBody, "ErrorNumber").c_str());
+}
+
+static std::string alpacaValue(const AsyncWebServerRequest &r) {
+    return jsonField(r.hostBody, "Value");
+}
+
+static double angleValue(const AsyncWebServerRequest &r) {
+    return atof(alpacaValue(r).c_str());
+}
+
+// ============================================================================
+// CHECKS
+// ============================================================================
+
+static void checkRouting() {
+    printf("routing\n");
+    auto r = call(HTTP_GET, "/api/v1/rotator/0/connected");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    CHECK(r->hostSends == 1);
+    CHECK(r->hostContentType == "application/json");
+
+    r = call(HTTP_GET, "/api/v1/telescope/0/connected");
+    CHECK(r->hostCode == 400 && r->hostBody == "Unsupported device type");
+    r = call(HTTP_GET, "/api/v1/rotator/1/connected");
+    CHECK(r->hostCode == 400 && r->hostBody == "Invalid device number");
+    r = call(HTTP_GET, "/api/v1/rotator/x/connected");
+    CHECK(r->hostCode == 400 && r->hostBody == "Invalid device number");
+    r = call(HTTP_GET, "/api/v1/rotator/99999999999/connected");
+    CHECK(r->hostCode == 400);
+    r = call(HTTP_GET, "/api/v1/rotator/0/nosuchmethod");
+    CHECK(r->hostCode == 400 && r->hostBody == "Unknown method");
+    r = call(HTTP_GET, "/api/v1/rotator/0/Position");   // method names are lower case
+    CHECK(r->hostCode == 400);
+    r = call(HTTP_PUT, "/api/v1/rotator/0/position", "");
+    CHECK(r->hostCode == 405);
+    r = call(HTTP_GET, "/api/v1/rotator/0/halt");
+    CHECK(r->hostCode == 405);
+    r = call(HTTP_POST, "/api/v1/rotator/0/halt", "");
+    CHECK(r->hostCode == 405);
+
+    hostSetRotatorCount(2);
+    r = call(HTTP_GET, "/api/v1/rotator/1/connected");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    hostSetRotatorCount(1);
+
+    r = call(HTTP_GET, "/nosuchpage");
+    CHECK(r->hostCode == 404);
+}
+
+static void checkParameters() {
+    printf("parameters\n");
+    auto r = call(HTTP_GET, "/api/v1/rotator/0/connected?ClientID=7&ClientTransactionID=42");
+    CHECK(jsonField(r->hostBody, "ClientID") == "7");
+    CHECK(jsonField(r->hostBody, "ClientTransactionID") == "42");
+
+    // Names are case-insensitive, invalid IDs are reported as 0
+    r = call(HTTP_GET, "/api/v1/rotator/0/connected?clientid=3&CLIENTTRANSACTIONID=abc");
+    CHECK(jsonField(r->hostBody, "ClientID") == "3");
+    CHECK(jsonField(r->hostBody, "ClientTransactionID") == "0");
+
+    auto a = call(HTTP_GET, "/api/v1/rotator/0/connected");
+    auto b = call(HTTP_GET, "/api/v1/rotator/0/connected");
+    CHECK(atol(jsonField(b->hostBody, "ServerTransactionID").c_str())
+          == atol(jsonField(a->hostBody, "ServerTransactionID").c_str()) + 1);
+
+    // PUT values arrive as form body, booleans case-insensitive
+    r = call(HTTP_PUT, "/api/v1/rotator/0/connected", "Connected=TRUE&ClientID=1&ClientTransactionID=2");
+    CHECK(alpacaError(*r) == ALPACA_OK && alpacaValue(*r) == "true");
+    CHECK(jsonField(r->hostBody, "ClientTransactionID") == "2");
+    r = call(HTTP_GET, "/api/v1/rotator/0/connected");
+    CHECK(alpacaValue(*r) == "true");
+    r = call(HTTP_PUT, "/api/v1/rotator/0/connected", "connected=false");
+    CHECK(alpacaValue(*r) == "false");
+    r = call(HTTP_PUT, "/api/v1/rotator/0/connected", "");
+    CHECK(alpacaError(*r) == ALPACA_ERROR_INVALID_VALUE);
+    CHECK(jsonField(r->hostBody, "ErrorMessage") == "\"Missing Connected\"");
+    r = call(HTTP_PUT, "/api/v1/rotator/0/connect", "");
+    CHECK(alpacaError(*r) == ALPACA_OK && alpacaValue(*r) == "<missing>");
+
+    r = call(HTTP_GET, "/api/v1/rotator/0/name?Id=0");
+    CHECK(alpacaValue(*r) == "\"MoMa Rotator\"");
+    r = call(HTTP_GET, "/api/v1/rotator/0/name?Id=2");
+    CHECK(alpacaError(*r) == ALPACA_ERROR_INVALID_VALUE);
+
+    r = call(HTTP_PUT, "/api/v1/rotator/0/reverse", "Reverse=True");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    r = call(HTTP_GET, "/api/v1/rotator/0/reverse");
+    CHECK(alpacaValue(*r) == "true");
+    call(HTTP_PUT, "/api/v1/rotator/0/reverse", "Reverse=false");
+}
+
+static void checkMotion() {
+    printf("motion\n");
+    call(HTTP_PUT, "/api/v1/rotator/0/sync", "Position=0");
+    auto r = call(HTTP_GET, "/api/v1/rotator/0/position");
+    CHECK(alpacaError(*r) == ALPACA_OK && angleValue(*r) == 0.0);
+
+    r = call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=90");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    r = call(HTTP_GET, "/api/v1/rotator/0/ismoving");
+    CHECK(alpacaValue(*r) == "true");
+    r = call(HTTP_GET, "/api/v1/rotator/0/targetposition");
+    CHECK(fabs(angleValue(*r) - 90.0) < 0.05);
+    // Sent but not read back yet: still moving towards the same target
+    hostServoFlush();
+    r = call(HTTP_GET, "/api/v1/rotator/0/ismoving");
+    CHECK(alpacaValue(*r) == "true");
+    r = call(HTTP_GET, "/api/v1/rotator/0/targetposition");
+    CHECK(fabs(angleValue(*r) - 90.0) < 0.05);
+    hostServoPoll();
+    r = call(HTTP_GET, "/api/v1/rotator/0/ismoving");
+    CHECK(alpacaValue(*r) == "false");
+    r = call(HTTP_GET, "/api/v1/rotator/0/position");
+    CHECK(fabs(angleValue(*r) - 90.0) < 0.05);
+    CHECK(hostServoSteps(0) == degreesToSteps(90.0));
+
+    // Relative move within range, then one that would leave 0..360
+    r = call(HTTP_PUT, "/api/v1/rotator/0/move", "Position=-45.5");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    hostServoPoll();
+    r = call(HTTP_GET, "/api/v1/rotator/0/position");
+    CHECK(fabs(angleValue(*r) - 44.5) < 0.05);
+    r = call(HTTP_PUT, "/api/v1/rotator/0/move", "Position=-50");
+    CHECK(alpacaError(*r) == ALPACA_ERROR_INVALID_VALUE);
+    r = call(HTTP_PUT, "/api/v1/rotator/0/move", "Position=320");
+    CHECK(alpacaError(*r) == ALPACA_ERROR_INVALID_VALUE);
+
+    for(const char *bad : {"Position=360", "Position=-0.5", "Position=1e9"}) {
+        r = call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", bad);
+        CHECK(alpacaError(*r) == ALPACA_ERROR_INVALID_VALUE);
+        r = call(HTTP_PUT, "/api/v1/rotator/0/movemechanical", bad);
+        CHECK(alpacaError(*r) == ALPACA_ERROR_INVALID_VALUE);
+    }
+    CHECK(!isServoMoving(0));
+
+    r = call(HTTP_PUT, "/api/v1/rotator/0/sync", "Position=180");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    r = call(HTTP_GET, "/api/v1/rotator/0/mechanicalposition");
+    CHECK(fabs(angleValue(*r) - 180.0) < 0.05);
+
+    r = call(HTTP_GET, "/api/v1/rotator/0/stepsize");
+    CHECK(fabs(angleValue(*r) - 360.0 / GEAR_STEPS_PER_REV) < 1e-9);
+
+    // DeviceState: Name/Value list, TimeStamp once the wall clock is set (always on the host)
+    r = call(HTTP_GET, "/api/v1/rotator/0/devicestate");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    CHECK(r->hostBody.find("{\"Name\":\"IsMoving\",\"Value\":false}") != std::string::npos);
+    CHECK(r->hostBody.find("\"Name\":\"TimeStamp\",\"Value\":\"20") != std::string::npos);
+
+    r = call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=10");
+    r = call(HTTP_PUT, "/api/v1/rotator/0/halt", "");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    hostServoPoll();
+    r = call(HTTP_GET, "/api/v1/rotator/0/position");
+    CHECK(fabs(angleValue(*r) - 180.0) < 0.05);
+}
+
+static void checkActions() {
+    printf("actions\n");
+    auto r = call(HTTP_GET, "/api/v1/rotator/0/supportedactions");
+    CHECK(alpacaValue(*r) == "[\"RunSequence\",\"SequenceStatus\",\"AbortSequence\"]");
+
+    r = call(HTTP_PUT, "/api/v1/rotator/0/action", "Action=Explode&Parameters=");
+    CHECK(alpacaError(*r) == ALPACA_ERROR_ACTION_NOT_IMPLEMENTED);
+    r = call(HTTP_PUT, "/api/v1/rotator/0/action", "Action=RunSequence&Parameters=oops");
+    CHECK(alpacaError(*r) == ALPACA_ERROR_INVALID_VALUE);
+    r = call(HTTP_PUT, "/api/v1/rotator/0/action", "Action=RunSequence&Parameters=");
+    CHECK(alpacaError(*r) == ALPACA_ERROR_INVALID_VALUE);
+
+    r = call(HTTP_PUT, "/api/v1/rotator/0/action", "action=runsequence&parameters=10%2C500%3B20%2C0%2C800");
+    CHECK(alpacaError(*r) == ALPACA_OK && alpacaValue(*r) == "\"2\"");
+    r = call(HTTP_PUT, "/api/v1/rotator/0/action", "Action=RunSequence&Parameters=30,0");
+    CHECK(alpacaError(*r) == ALPACA_ERROR_INVALID_OPERATION);
+    r = call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=5");
+    CHECK(alpacaError(*r) == ALPACA_ERROR_INVALID_OPERATION);
+
+    // The status is a JSON document inside the string Value
+    r = call(HTTP_PUT, "/api/v1/rotator/0/action", "Action=SequenceStatus&Parameters=");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    CHECK(alpacaValue(*r).find("\\\"state\\\":\\\"moving\\\"") != std::string::npos);
+    CHECK(alpacaValue(*r).find("\\\"steps\\\":2") != std::string::npos);
+
+    r = call(HTTP_PUT, "/api/v1/rotator/0/action", "Action=AbortSequence&Parameters=");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    r = call(HTTP_PUT, "/api/v1/rotator/0/action", "Action=SequenceStatus&Parameters=");
+    CHECK(alpacaValue(*r).find("\\\"state\\\":\\\"aborted\\\"") != std::string::npos);
+    hostServoPoll();
+    r = call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=5");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    hostServoPoll();
+}
+
+static void checkManagement() {
+    printf("management\n");
+    auto r = call(HTTP_GET, "/management/apiversions?ClientTransactionID=9");
+    CHECK(alpacaError(*r) == ALPACA_OK && alpacaValue(*r) == "[1]");
+    CHECK(jsonField(r->hostBody, "ClientTransactionID") == "9");
+    r = call(HTTP_GET, "/management/v1/description");
+    CHECK(jsonField(r->hostBody, "ServerName") == "\"MoMa Rotator\"");
+
+    hostSetRotatorCount(MAX_ROTATORS);
+    r = call(HTTP_GET, "/management/v1/configureddevices");
+    CHECK(alpacaError(*r) == ALPACA_OK);
+    CHECK(r->hostBody.find("\"DeviceNumber\":3") != std::string::npos);
+    CHECK(r->hostBody.find("\"DeviceName\":\"Rotator 3\"") != std::string::npos);
+    hostSetRotatorCount(1);
+    r = call(HTTP_GET, "/management/v1/configureddevices");
+    CHECK(r->hostBody.find("\"DeviceNumber\":1") == std::string::npos);
+    r = call(HTTP_PUT, "/management/apiversions", "");
+    CHECK(r->hostCode == 404);
+}
+
+static void checkResponsePath() {
+    printf("response path\n");
+
+    // The body survives being drained in small pieces
+    AsyncWebServerRequest small(HTTP_GET, "/management/v1/configureddevices");
+    small.hostSegment = 7;
+    server.hostHandle(small);
+    CHECK(alpacaError(small) == ALPACA_OK);
+
+    // Handlers use no heap: the response comes from the pool and takes the
+    // content type String its slot allocated on first use
+    AlpacaRequestStats before = getAlpacaRequestStats();
+    for(int i = 0; i < 50; i++) {
+        call(HTTP_GET, "/api/v1/rotator/0/position?ClientID=1&ClientTransactionID=5");
+        call(HTTP_GET, "/api/v1/rotator/0/devicestate");
+        call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=12.5");
+    }
+    hostServoPoll();
+    AlpacaRequestStats after = getAlpacaRequestStats();
+    CHECK(after.requests - before.requests == 150);
+    CHECK(after.heapBytes - before.heapBytes == 0);
+    CHECK(getAlpacaResponseStats().poolMisses == 0);
+    CHECK(getAlpacaResponseStats().overflows == 0);
+
+    // Every response still in flight uses the heap once the pool is exhausted
+    std::vector<std::unique_ptr<AsyncWebServerRequest>> held;
+    std::vector<AlpacaResponse *> responses;
+    for(int i = 0; i < ALPACA_RESPONSE_POOL + 1; i++) {
+        held.emplace_back(new AsyncWebServerRequest(HTTP_GET, "/api/v1/rotator/0/position"));
+        responses.push_back(AlpacaResponse::begin(held.back().get()));
+    }
+    for(AlpacaResponse *response : responses) response->send();
+    for(auto &request : held) request->hostFinish();
+    CHECK(getAlpacaResponseStats().poolMisses == 1);
+    resetAlpacaRequestStats();
+}
+
+static void checkSetupEndpoints() {
+    printf("setup endpoints\n");
+    auto r = call(HTTP_GET, "/");
+    CHECK(r->hostCode == 302 && r->hostHeader("Location") && *r->hostHeader("Location") == "/setup/v1/rotator/0/setup");
+
+    // Gzipped page with ETag, 304 when the browser already has it
+    r = call(HTTP_GET, "/setup/v1/rotator/0/configdevices");
+    CHECK(r->hostCode == 200 && r->hostHeader("Content-Encoding") && r->hostHeader("ETag"));
+    CHECK(r->hostBody.size() > 2 && (uint8_t)r->hostBody[0] == 0x1f && (uint8_t)r->hostBody[1] == 0x8b);
+    std::string etag = r->hostHeader("ETag") ? r->hostHeader("ETag")->c_str() : "";
+    AsyncWebServerRequest cached(HTTP_GET, "/setup/v1/rotator/0/configdevices");
+    cached.hostAddHeader("if-none-match", etag.c_str());
+    server.hostHandle(cached);
+    CHECK(cached.hostCode == 304 && cached.hostBody.empty());
+
+    // Panel commands and the text endpoints
+    r = call(HTTP_GET, "/cmd?inputI=17&inputP=270");
+    CHECK(r->hostCode == 200 && r->hostBody == "OK");
+    hostServoPoll();
+    r = call(HTTP_GET, "/setup/v1/rotator/0/position");
+    CHECK(r->hostBody == "270.00");
+
+    // Gear ratio: the same motor steps are a different rotator angle, refused while moving
+    r = call(HTTP_GET, "/setup/v1/rotator/0/gear?dev=0&ratio=3");
+    CHECK(r->hostCode == 200 && jsonValid(r->hostBody) && jsonField(r->hostBody, "stepsPerRev") == "12288");
+    r = call(HTTP_GET, "/setup/v1/rotator/0/position");
+    CHECK(fabs(atof(r->hostBody.c_str()) - stepsToDegrees(wrapSteps(hostServoSteps(0), 12288), 12288)) < 0.01);
+    call(HTTP_GET, "/cmd?inputI=6");
+    r = call(HTTP_GET, "/setup/v1/rotator/0/gear?dev=0&ratio=2");
+    CHECK(r->hostCode == 409 && getStepsPerRev(0) == 12288);
+    hostServoPoll();
+    CHECK(call(HTTP_GET, "/setup/v1/rotator/0/gear?dev=0&ratio=0")->hostCode == 409);
+    CHECK(call(HTTP_GET, "/setup/v1/rotator/0/gear?dev=0&ratio=2")->hostCode == 200 && getStepsPerRev(0) == 8192);
+
+    call(HTTP_GET, "/cmd?inputI=20");
+    CHECK(!isDisplayEnabled());
+    call(HTTP_GET, "/setup/v1/rotator/0/cmd?inputI=21");
+    CHECK(isDisplayEnabled());
+
+    // Saved credentials: form decoding in, JSON escaping out
+    int restarts = hostRestarts();
+    r = call(HTTP_POST, "/setup/v1/rotator/0/save", "ssid=My+Net&password=p%26w%22d");
+    CHECK(r->hostCode == 200 && hostRestarts() == restarts + 1);
+    r = call(HTTP_GET, "/wifi/credentials");
+    CHECK(jsonValid(r->hostBody));
+    CHECK(jsonField(r->hostBody, "ssid") == "\"My Net\"");
+    CHECK(jsonField(r->hostBody, "password") == "\"p&w\\\"d\"");
+    r = call(HTTP_POST, "/setup/v1/rotator/0/save", "password=x");
+    CHECK(r->hostBody == "Missing parameters");
+    call(HTTP_GET, "/reset");
+    r = call(HTTP_GET, "/wifi/credentials");
+    CHECK(jsonField(r->hostBody, "ssid") == "\"\"");
+
+    for(const char *url : {"/setup/v1/rotator/0/alpacastats", "/setup/v1/rotator/0/polling",
+                           "/setup/v1/rotator/0/busbench", "/setup/v1/rotator/0/servoboot", "/log?stats=1"}) {
+        r = call(HTTP_GET, url);
+        CHECK(r->hostCode == 200 && jsonValid(r->hostBody));
+        if(!jsonValid(r->hostBody)) printf("  %s: %s\n", url, r->hostBody.c_str());
+    }
+    r = call(HTTP_GET, "/log?level=verbose");
+    CHECK(r->hostCode == 400);
+}
+
+static void checkTasks() {
+    printf("tasks\n");
+    // Firmware tasks are not run here: the harness thread registers as one
+    int slot = taskMonitorAdd("harness", -1, 1000000, 8192);
+    CHECK(slot >= 0);
+    for(int i = 0; i < 3; i++) {
+        taskWorkBegin(slot, esp_timer_get_time() - 500);
+        call(HTTP_GET, "/api/v1/rotator/0/position");
+        taskWorkEnd(slot);
+    }
+    TaskStats s;
+    CHECK(getTaskStats(slot, s) && s.runs == 3 && s.work.count == 3 && s.overBudget == 0 && s.lateMaxUs >= 500);
+
+    auto r = call(HTTP_GET, "/setup/v1/rotator/0/tasks");
+    CHECK(r->hostCode == 200 && jsonValid(r->hostBody));
+    CHECK(r->hostBody.find("\"name\":\"harness\"") != std::string::npos);
+    CHECK(r->hostBody.find("\"runs\":3") != std::string::npos);
+    r = call(HTTP_GET, "/setup/v1/rotator/0/tasks?reset=1");
+    CHECK(getTaskStats(slot, s) && s.runs == 0 && s.lateMaxUs == 0);
+
+    taskWorkBegin(slot);
+    taskWorkEnd(slot);
+    r = call(HTTP_GET, "/metrics");
+    CHECK(r->hostBody.find("moma_task_work_duration_seconds_count{task=\"harness\"} 1") != std::string::npos);
+    CHECK(r->hostBody.find("moma_task_stack_free_bytes{task=\"harness\"} ") != std::string::npos);
+}
+
+static void checkProfiler() {
+    printf("profiler\n");
+    // Iterations as the bus task runs them: the slowest above the threshold keep their breakdown
+    call(HTTP_GET, "/setup/v1/rotator/0/profile?reset=1&thresholdUs=0");
+    for(int i = 0; i < PROFILER_WORST + 2; i++) {
+        ProfileFrame frame;
+        profileBegin(frame);
+        call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=10&ClientID=1&ClientTransactionID=1");
+        profileMark(frame, STAGE_BUS_MOTION);
+        hostServoPoll();
+        profileMark(frame, STAGE_BUS_FEEDBACK);
+        profileEnd(frame, "bus0");
+    }
+    ProfileStageStats motion = getProfileStageStats(STAGE_BUS_MOTION);
+    CHECK(motion.count == PROFILER_WORST + 2 && motion.histogram.count == motion.count);
+    CHECK(motion.maxCycles >= motion.avgCycles && motion.avgCycles > 0);
+    CHECK(getProfileStageStats(STAGE_BUS_MOVES).count == 0);
+
+    ProfileCapture worst[PROFILER_WORST];
+    int n = getProfileCaptures(worst, PROFILER_WORST);
+    CHECK(n == PROFILER_WORST);
+    bool ordered = true;
+    for(int i = 1; i < n; i++) ordered &= worst[i - 1].totalCycles >= worst[i].totalCycles;
+    CHECK(ordered && strcmp(worst[0].task, "bus0") == 0);
+    CHECK(worst[0].stages == ((1 << STAGE_BUS_MOTION) | (1 << STAGE_BUS_FEEDBACK)));
+    CHECK(worst[0].cycles[STAGE_BUS_MOTION] + worst[0].cycles[STAGE_BUS_FEEDBACK] == worst[0].totalCycles);
+
+    auto r = call(HTTP_GET, "/setup/v1/rotator/0/profile?thresholdUs=100000&oled=1");
+    CHECK(r->hostCode == 200 && jsonValid(r->hostBody));
+    CHECK(jsonField(r->hostBody, "thresholdUs") == "100000" && isProfileOnDisplay());
+    CHECK(r->hostBody.find("\"stagesUs\":{\"motion\":") != std::string::npos);
+    call(HTTP_GET, "/setup/v1/rotator/0/profile?reset=1&oled=0");
+    CHECK(getProfileCaptures(worst, PROFILER_WORST) == 0 && !isProfileOnDisplay());
+    setProfileThresholdUs(PROFILER_DEFAULT_THRESHOLD_US);
+}
+
+static void checkOffline() {
+    printf("offline\n");
+    // A rotator that stops answering keeps serving its last position and refuses moves
+    call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=40&ClientID=1&ClientTransactionID=1");
+    hostServoPoll();
+    hostSetRotatorOnline(0, false);
+    auto r = call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=80&ClientID=1&ClientTransactionID=2");
+    CHECK(jsonField(r->hostBody, "ErrorNumber") == "1031");
+    hostServoPoll();
+    r = call(HTTP_GET, "/api/v1/rotator/0/position?ClientID=1&ClientTransactionID=3");
+    CHECK(jsonField(r->hostBody, "ErrorNumber") == "0" && atof(jsonField(r->hostBody, "Value").c_str()) > 39.9);
+    RotatorSnapshot snapshot;
+    CHECK(getRotatorSnapshot(0, snapshot) && snapshot.stale);
+    r = call(HTTP_GET, "/cmd?inputI=17&inputP=80");   // panel moves pass the same check
+    CHECK(r->hostCode == 409 && r->hostBody == "Rotator not responding");
+    r = call(HTTP_GET, "/cmd?inputI=2");               // stop is always accepted
+    CHECK(r->hostCode == 200);
+
+    r = call(HTTP_GET, "/setup/v1/rotator/0/polling");
+    CHECK(jsonValid(r->hostBody) && r->hostBody.find("\"state\":\"offline\"") != std::string::npos);
+    r = call(HTTP_GET, "/metrics");
+    CHECK(r->hostBody.find("moma_rotator_link_state{dev=\"0\"} 2") != std::string::npos);
+
+    hostSetRotatorOnline(0, true);
+    r = call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=80&ClientID=1&ClientTransactionID=4");
+    CHECK(jsonField(r->hostBody, "ErrorNumber") == "0");
+    hostServoPoll();
+    CHECK(getRotatorSnapshot(0, snapshot) && !snapshot.stale && getLinkHealth(0).outages == 1);
+}
+
+static void checkBoot() {
+    printf("boot\n");
+    // Servo stage still running: identity and connection methods answer, the rest is "not connected"
+    hostSetServoReady(false);
+    auto r = call(HTTP_PUT, "/api/v1/rotator/0/connect", "ClientID=1&ClientTransactionID=1");
+    CHECK(jsonField(r->hostBody, "ErrorNumber") == "0");
+    r = call(HTTP_GET, "/api/v1/rotator/0/connecting?ClientID=1&ClientTransactionID=2");
+    CHECK(jsonField(r->hostBody, "Value") == "true");
+    r = call(HTTP_GET, "/api/v1/rotator/0/connected?ClientID=1&ClientTransactionID=3");
+    CHECK(jsonField(r->hostBody, "Value") == "false");
+    r = call(HTTP_GET, "/api/v1/rotator/0/name?ClientID=1&ClientTransactionID=4");
+    CHECK(jsonField(r->hostBody, "ErrorNumber") == "0");
+    r = call(HTTP_GET, "/api/v1/rotator/0/position?ClientID=1&ClientTransactionID=5");
+    CHECK(jsonField(r->hostBody, "ErrorNumber") == "1031");
+    char url[48];
+    snprintf(url, sizeof(url), "/api/v1/rotator/%d/name", MAX_ROTATORS);
+    r = call(HTTP_GET, url);
+    CHECK(r->hostCode == 400);
+
+    hostSetServoReady(true);
+    r = call(HTTP_GET, "/api/v1/rotator/0/connecting?ClientID=1&ClientTransactionID=6");
+    CHECK(jsonField(r->hostBody, "Value") == "false");
+    r = call(HTTP_GET, "/api/v1/rotator/0/connected?ClientID=1&ClientTransactionID=7");
+    CHECK(jsonField(r->hostBody, "Value") == "true");
+    r = call(HTTP_GET, "/api/v1/rotator/0/position?ClientID=1&ClientTransactionID=8");
+    CHECK(jsonField(r->hostBody, "ErrorNumber") == "0");
+    CHECK(getFirstAlpacaResponseMs() > 0);
+}
+
+static void checkJournal() {
+    printf("journal\n");
+    // Restart with a move queued: the shutdown handler journals it in flight, a flush once arrived
+    startPositionJournal();
+    call(HTTP_PUT, "/api/v1/rotator/0/sync", "Position=0");
+    hostServoPoll();
+    call(HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=90");
+    PositionJournalStats before = getPositionJournalStats();
+    ESP.restart();
+    PositionJournalStats after = getPositionJournalStats();
+    CHECK(after.shutdownWrites == before.shutdownWrites + 1);
+    JournalEntry entries[MAX_ROTATORS];
+    int n = loadPositionJournal(entries, MAX_ROTATORS);
+    CHECK(n == getRotatorCount() && (entries[0].flags & JOURNAL_IN_FLIGHT));
+    CHECK(entries[0].position == hostServoSteps(0));   // queued, not sent: journaled at the old target
+
+    hostServoPoll();
+    auto r = call(HTTP_GET, "/setup/v1/rotator/0/servoboot?journal=flush");
+    CHECK(jsonValid(r->hostBody));
+    CHECK(getPositionJournalStats().writes == after.writes + 1);
+    n = loadPositionJournal(entries, MAX_ROTATORS);
+    CHECK(n > 0 && entries[0].position == hostServoSteps(0) && entries[0].spanSteps == 0);
+    call(HTTP_GET, "/setup/v1/rotator/0/servoboot?journal=flush");
+    CHECK(getPositionJournalStats().writes == after.writes + 1);   // unchanged: not written again
+
+    // Restore rule: same servo, remaining distance within what was still to go
+    JournalEntry e = entries[0];
+    CHECK(checkJournalEntry(e, e.bus, e.id, true, 1) == RESTORE_OK);
+    CHECK(checkJournalEntry(e, e.bus, e.id, true, 200) == RESTORE_RESIDUAL);
+    CHECK(checkJournalEntry(e, e.bus, e.id + 1, true, 0) == RESTORE_OTHER_SERVO);
+    CHECK(checkJournalEntry(e, e.bus, e.id, false, 0) == RESTORE_UNVERIFIED);
+
+    // In flight: trusted after a restart only, a power cycle reports no residual
+    e.flags = JOURNAL_IN_FLIGHT;
+    e.spanSteps = 300;
+    hostSetResetReason(ESP_RST_SW);
+    CHECK(checkJournalEntry(e, e.bus, e.id, true, -200) == RESTORE_OK);
+    CHECK(checkJournalEntry(e, e.bus, e.id, false, 0) == RESTORE_UNVERIFIED);
+    hostSetResetReason(ESP_RST_POWERON);
+    CHECK(checkJournalEntry(e, e.bus, e.id, true, 0) == RESTORE_RESIDUAL);
+    CHECK(checkJournalEntry(e, e.bus, e.id, false, 0) == RESTORE_RESIDUAL);
+    hostSetResetReason(ESP_RST_BROWNOUT);
+    CHECK(checkJournalEntry(e, e.bus, e.id, true, -200) == RESTORE_RESIDUAL);
+    hostSetResetReason(ESP_RST_POWERON);
+}
+
+static void checkMetrics() {
+    printf("metrics\n");
+    call(HTTP_GET, "/api/v1/rotator/0/position");
+    auto r = call(HTTP_GET, "/metrics");
+    CHECK(r->hostCode == 200 && r->hostContentType == "text/plain; version=0.0.4");
+    CHECK(r->hostBody.find("# block") == std::string::npos);   // no block truncated
+    CHECK(r->hostBody.find("moma_alpaca_request_duration_seconds_count{endpoint=\"position\"} ") != std::string::npos);
+    CHECK(r->hostBody.find("moma_wifi_connected 1") != std::string::npos);
+
+    // Every sample line is "name[{labels}] value"
+    bool wellFormed = !r->hostBody.empty() && r->hostBody.back() == '\n';
+    size_t start = 0;
+    while(start < r->hostBody.size()) {
+        size_t end = r->hostBody.find('\n', start);
+        std::string line = r->hostBody.substr(start, end - start);
+        start = end + 1;
+        if(line.empty() || line[0] == '#') continue;
+        size_t space = line.rfind(' ');
+        char *rest = nullptr;
+        strtod(line.c_str() + space + 1, &rest);
+        if(space == std::string::npos || *rest != '\0' || !(isalpha((unsigned char)line[0]) || line[0] == '_')) {
+            printf("  bad sample: %s\n", line.c_str());
+            wellFormed = false;
+        }
+    }
+    CHECK(wellFormed);
+
+    // HTTP/1.0 and small segments render the same document
+    AsyncWebServerRequest old(HTTP_GET, "/metrics");
+    old.hostSetVersion(0);
+    old.hostSegment = 100;
+    server.hostHandle(old);
+    CHECK(old.hostBody.size() > 1000 && old.hostBody.back() == '\n');
+
+    // A scrape uses no heap once the response slot has its content type
+    AsyncWebServerRequest again(HTTP_GET, "/metrics");
+    uint64_t allocsBefore = hostHeapStats().allocations;
+    server.hostHandle(again);
+    CHECK(hostHeapStats().allocations == allocsBefore && again.hostBody.size() > 1000);
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+struct BenchCase {
+    const char *name;
+    WebRequestMethod method;
+    const char *url;
+    const char *body;
+};
+
+static const BenchCase benchCases[] = {
+    {"GET position", HTTP_GET, "/api/v1/rotator/0/position?ClientID=1&ClientTransactionID=17", nullptr},
+    {"GET ismoving", HTTP_GET, "/api/v1/rotator/0/ismoving?ClientID=1&ClientTransactionID=17", nullptr},
+    {"GET devicestate", HTTP_GET, "/api/v1/rotator/0/devicestate?ClientID=1&ClientTransactionID=17", nullptr},
+    {"PUT moveabsolute", HTTP_PUT, "/api/v1/rotator/0/moveabsolute", "Position=123.4&ClientID=1&ClientTransactionID=17"},
+    {"PUT action status", HTTP_PUT, "/api/v1/rotator/0/action", "Action=SequenceStatus&Parameters=&ClientID=1"},
+    {"GET configureddevices", HTTP_GET, "/management/v1/configureddevices", nullptr},
+    {"GET unknown method", HTTP_GET, "/api/v1/rotator/0/nosuchmethod", nullptr},
+    {"GET alpacastats", HTTP_GET, "/setup/v1/rotator/0/alpacastats", nullptr},
+    {"GET /metrics", HTTP_GET, "/metrics", nullptr},
+};
+
+static void runBench(int iterations) {
+    printf("%-22s %10s %10s %10s %8s\n", "endpoint", "mean ns", "p99 ns", "allocs", "bytes");
+    std::vector<uint32_t> times(iterations);
+    for(const BenchCase &c : benchCases) {
+        uint64_t allocations = 0;
+        size_t bytes = 0;
+        for(int i = 0; i < iterations; i++) {
+            AsyncWebServerRequest request(c.method, c.url, c.body);
+            uint64_t allocsBefore = hostHeapStats().allocations;
+            auto start = std::chrono::steady_clock::now();
+            server.hostHandle(request);
+            auto end = std::chrono::steady_clock::now();
+            allocations += hostHeapStats().allocations - allocsBefore;
+            times[i] = (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            bytes = request.hostBody.size();
+            if(c.method == HTTP_PUT) hostServoPoll();
+        }
+        std::sort(times.begin(), times.end());
+        uint64_t sum = 0;
+        for(uint32_t t : times) sum += t;
+        printf("%-22s %10.0f %10u %10.2f %8u\n", c.name, (double)sum / iterations,
+               (unsigned)times[iterations * 99 / 100], (double)allocations / iterations, (unsigned)bytes);
+    }
+}
+
+// ============================================================================
+// LISTENER
+// ============================================================================
+
+struct Client {
+    int fd;
+    std::string in;
+};
+
+static const char *statusText(int code) {
+    switch(code) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 302: return "Found";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "Status";
+    }
+}
+
+static bool parseMethod(const std::string &name, WebRequestMethod &method) {
+    static const struct { const char *name; WebRequestMethod method; } methods[] = {
+        {"GET", HTTP_GET}, {"POST", HTTP_POST}, {"PUT", HTTP_PUT}, {"DELETE", HTTP_DELETE},
+        {"PATCH", HTTP_PATCH}, {"HEAD", HTTP_HEAD}, {"OPTIONS", HTTP_OPTIONS},
+    };
+    for(const auto &m : methods) {
+        if(name == m.name) { method = m.method; return true; }
+    }
+    return false;
+}
+
+static bool sendAll(int fd, const std::string &data) {
+    size_t done = 0;
+    while(done < data.size()) {
+        ssize_t n = send(fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+        if(n <= 0) return false;
+        done += n;
+    }
+    return true;
+}
+
+// Handles every complete request in the client's buffer; false = close the connection
+static bool serveClient(Client &client) {
+    for(;;) {
+        size_t headerEnd = client.in.find("\r\n\r\n");
+        if(headerEnd == std::string::npos) return client.in.size() < 16384;
+        std::string head = client.in.substr(0, headerEnd);
+
+        char methodName[16], target[2048], version[16];
+        if(sscanf(head.c_str(), "%15s %2047s %15s", methodName, target, version) != 3) return false;
+        bool http10 = strcmp(version, "HTTP/1.0") == 0;
+        bool keepAlive = !http10;
+        size_t contentLength = 0;
+        std::vector<std::pair<std::string, std::string>> headers;
+        size_t line = head.find("\r\n");
+        while(line != std::string::npos && line < head.size()) {
+            size_t next = head.find("\r\n", line + 2);
+            std::string h = head.substr(line + 2, (next == std::string::npos ? head.size() : next) - line - 2);
+            size_t colon = h.find(':');
+            if(colon != std::string::npos) {
+                size_t start = h.find_first_not_of(' ', colon + 1);
+                std::string name = h.substr(0, colon);
+                std::string value = start == std::string::npos ? std::string() : h.substr(start);
+                if(strcasecmp(name.c_str(), "Content-Length") == 0) contentLength = strtoul(value.c_str(), nullptr, 10);
+                if(strcasecmp(name.c_str(), "Connection") == 0) {
+                    if(strcasecmp(value.c_str(), "close") == 0) keepAlive = false;
+                    if(strcasecmp(value.c_str(), "keep-alive") == 0) keepAlive = true;
+                }
+                headers.emplace_back(name, value);
+            }
+            line = next;
+        }
+        if(client.in.size() < headerEnd + 4 + contentLength) return true;   // body incomplete
+        std::string body = client.in.substr(headerEnd + 4, contentLength);
+        client.in.erase(0, headerEnd + 4 + contentLength);
+
+        WebRequestMethod method;
+        std::string out;
+        if(!parseMethod(methodName, method)) {
+            out = "HTTP/1.1 405 Method Not Allowed\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+            sendAll(client.fd, out);
+            return false;
+        }
+        AsyncWebServerRequest request(method, target, body.empty() ? nullptr : body.c_str());
+        if(http10) request.hostSetVersion(0);
+        for(const auto &h : headers) request.hostAddHeader(h.first.c_str(), h.second.c_str());
+        server.hostHandle(request);
+
+        // The captured body is decoded: always sent with its length
+        char status[64];
+        snprintf(status, sizeof(status), "HTTP/1.%d %d %s\r\n", http10 ? 0 : 1, request.hostCode,
+                 statusText(request.hostCode));
+        out = status;
+        if(!request.hostContentType.empty()) out += "Content-Type: " + request.hostContentType + "\r\n";
+        for(const AsyncWebHeader &h : request.hostHeaders) {
+            out += std::string(h.name().c_str()) + ": " + h.value().c_str() + "\r\n";
+        }
+        out += "Content-Length: " + std::to_string(method == HTTP_HEAD ? 0 : request.hostBody.size()) + "\r\n";
+        out += keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+        if(method != HTTP_HEAD) out += request.hostBody;
+        if(!sendAll(client.fd, out) || !keepAlive) return false;
+    }
+}
+
+static int runListener(int port) {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(listener < 0 || bind(listener, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(listener, 64) != 0) {
+        perror("listen");
+        return 1;
+    }
+    printf("listening on 127.0.0.1:%d\n", port);
+    fflush(stdout);
+
+    std::vector<Client> clients;
+    std::vector<pollfd> fds;
+    for(;;) {
+        fds.assign(1, pollfd{listener, POLLIN, 0});
+        for(const Client &c : clients) fds.push_back(pollfd{c.fd, POLLIN, 0});
+        if(poll(fds.data(), fds.size(), 10) < 0) continue;
+
+        // Clients first: the indexes of fds match clients only before accepting
+        for(size_t i = clients.size(); i-- > 0;) {
+            if(!(fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            char chunk[4096];
+            ssize_t n = recv(clients[i].fd, chunk, sizeof(chunk), 0);
+            bool keep = n > 0;
+            if(keep) {
+                clients[i].in.append(chunk, n);
+                keep = serveClient(clients[i]);
+            }
+            if(!keep) {
+                close(clients[i].fd);
+                clients.erase(clients.begin() + i);
+            }
+        }
+        if(fds[0].revents & POLLIN) {
+            int fd = accept(listener, nullptr, nullptr);
+            if(fd >= 0) {
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                clients.push_back(Client{fd, std::string()});
+            }
+        }
+        hostServoPoll();   // the bus task: queued moves go out and arrive
+    }
+}
+
+int main(int argc, char **argv) {
+    setupAlpacaEndpoints(server);
+    setupWiFiEndpoints(server);
+    setupLogEndpoints(server);
+    setupMetricsEndpoint(server);
+    setupTaskEndpoint(server);
+    setupProfileEndpoint(server);
+
+    if(argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        int iterations = argc > 2 ? atoi(argv[2]) : 20000;
+        runBench(iterations > 100 ? iterations : 100);
+        return 0;
+    }
+    if(argc > 1 && strcmp(argv[1], "--listen") == 0) {
+        return runListener(argc > 2 ? atoi(argv[2]) : 8080);
+    }
+
+    checkRouting();
+    checkParameters();
+    checkMotion();
+    checkActions();
+    checkManagement();
+    checkResponsePath();
+    checkSetupEndpoints();
+    checkTasks();
+    checkProfiler();
+    checkOffline();
+    checkBoot();
+    checkJournal();
+    checkMetrics();
+
+    printf("%d checks, %d failed\n", checks, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,85 @@
+// ============================================================================
+// Host benchmark: Alpaca envelope via fixed-buffer JsonWriter vs. heap strings
+// ============================================================================
+// Build & run on Linux (not part of the PlatformIO firmware build):
+//   g++ -O2 -std=gnu++17 -Iinclude tools/alpaca_json_bench.cpp -o alpaca_json_bench && ./alpaca_json_bench
+//
+// The "heap string" path mimics the old response path: envelope serialized into
+// a growing string, logged as "ALPACA Response: " + body, then copied once more
+// for the web server. Counts heap allocations per response via operator new.
+// On the device, /setup/v1/rotator/0/alpacastats reports the real per-request cost.
+// ============================================================================
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "json_writer.h"
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+    allocations++;
+    void *p = malloc(size ? size : 1);
+    if(!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+static volatile size_t sink = 0;
+
+static size_t heapStringResponse(double value, unsigned clientID, unsigned clientTx, unsigned serverTx) {
+    std::string body = "{\"Value\":";
+    char num[32];
+    snprintf(num, sizeof(num), "%.9g", value);
+    body += num;
+    body += ",\"ClientID\":" + std::to_string(clientID);
+    body += ",\"ClientTransactionID\":" + std::to_string(clientTx);
+    body += ",\"ServerTransactionID\":" + std::to_string(serverTx);
+    body += ",\"ErrorNumber\":0,\"ErrorMessage\":\"\"}";
+    std::string log = "ALPACA Response: " + body;
+    std::string sent = body;  // copy handed to the web server
+    return log.size() + sent.size();
+}
+
+static size_t writerResponse(double value, unsigned clientID, unsigned clientTx, unsigned serverTx) {
+    char buffer[768];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.key("Value").number(value);
+    json.key("ClientID").integer(clientID);
+    json.key("ClientTransactionID").integer(clientTx);
+    json.key("ServerTransactionID").integer(serverTx);
+    json.key("ErrorNumber").integer(0);
+    json.key("ErrorMessage").string("");
+    json.endObject();
+    return json.length();
+}
+
+template<typename F>
+static void run(const char *name, size_t n, F fn) {
+    size_t allocBefore = allocations;
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < n; i++) {
+        sink = sink + fn((double)(i % 36000) / 100.0, 1, (unsigned)i, (unsigned)i + 7);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double sec = std::chrono::duration<double>(t1 - t0).count();
+    printf("%-28s %8.1f ns/response  %5.2f allocations/response\n", name, sec * 1e9 / n,
+           (double)(allocations - allocBefore) / n);
+}
+
+int main() {
+    const size_t N = 2000000;
+
+    char buffer[128];
+    JsonWriter check(buffer, sizeof(buffer));
+    check.beginObject().key("Value").number(123.456).key("s").string("a\"b").endObject();
+    printf("sample: %s\n", check.c_str());
+
+    run("heap strings (old path)", N, heapStringResponse);
+    run("JsonWriter (fixed buffer)", N, writerResponse);
+    return 0;
+}
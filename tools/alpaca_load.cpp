@@ -0,0 +1,392 @@
+// ============================================================================
+// Host load test: concurrent Alpaca clients against the rotator HTTP API
+// ============================================================================
+// Build & run on Linux (not part of the PlatformIO firmware build):
+//   g++ -O2 -std=gnu++17 -pthread tools/alpaca_load.cpp -o alpaca_load
+//   ./alpaca_load --host 192.168.1.50 --connections 4 --rate 10 --duration 30
+//
+// Each connection behaves like a polling client (N.I.N.A., ASCOM Remote,
+// ConformU): keep-alive HTTP/1.1, ClientID/ClientTransactionID on every call,
+// requests picked from a weighted mix. With --rate the requests are paced on a
+// fixed schedule and latency is measured from the scheduled send time, so a
+// stalled server is not hidden by the client waiting (coordinated omission).
+//
+// Per endpoint: count, errors (transport, HTTP status, ErrorNumber != 0 or a
+// wrong ClientTransactionID echo), throughput and p50/p99/p999/max latency.
+// Works against the device or the host harness without one:
+//   ./alpaca_host --listen 8080 &
+//   ./alpaca_load --host 127.0.0.1 --port 8080 --connections 4 --duration 10
+// ============================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string host = "192.168.1.1";
+    int port = 80;
+    int device = 0;
+    int connections = 4;
+    double rate = 0;            // requests/s per connection, 0 = as fast as possible
+    double duration = 10;       // s
+    int timeoutMs = 2000;
+    bool keepAlive = true;
+    bool csv = false;
+    std::string mix = "position:40,ismoving:40,targetposition:10,move:5,halt:5";
+};
+
+struct Endpoint {
+    const char *method;         // Alpaca method name
+    bool put;
+};
+
+static const Endpoint endpoints[] = {
+    {"position", false},
+    {"ismoving", false},
+    {"mechanicalposition", false},
+    {"targetposition", false},
+    {"connected", false},
+    {"devicestate", false},
+    {"move", true},             // small relative move
+    {"moveabsolute", true},     // random absolute target
+    {"halt", true},
+};
+static const size_t endpointCount = sizeof(endpoints) / sizeof(endpoints[0]);
+
+struct Result {
+    std::vector<uint32_t> latencyUs[endpointCount];
+    uint64_t errors[endpointCount] = {};
+};
+
+// ============================================================================
+// HTTP CLIENT
+// ============================================================================
+
+class Connection {
+public:
+    Connection(const Options &o, const sockaddr_in &addr) : opt(o), address(addr) {}
+    ~Connection() { close(); }
+
+    // Sends one request and reads the response body; returns HTTP status or -1
+    int request(const std::string &raw, std::string &body) {
+        for(int attempt = 0; attempt < 2; attempt++) {
+            if(fd < 0 && !connectSocket()) return -1;
+            int status = exchange(raw, body);
+            if(status > 0) return status;
+            close();  // Stale keep-alive connection: reconnect once
+            if(!reused) return -1;
+        }
+        return -1;
+    }
+
+    void close() {
+        if(fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+private:
+    const Options &opt;
+    sockaddr_in address;
+    int fd = -1;
+    bool reused = false;
+    std::string buffer;
+
+    bool connectSocket() {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if(fd < 0) return false;
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        timeval tv = {opt.timeoutMs / 1000, (opt.timeoutMs % 1000) * 1000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        if(connect(fd, (const sockaddr *)&address, sizeof(address)) != 0) {
+            close();
+            return false;
+        }
+        reused = false;
+        buffer.clear();
+        return true;
+    }
+
+    int exchange(const std::string &raw, std::string &body) {
+        bool wasReused = reused;
+        reused = true;
+        if(send(fd, raw.data(), raw.size(), MSG_NOSIGNAL) != (ssize_t)raw.size()) {
+            reused = wasReused;
+            return -1;
+        }
+
+        // Header
+        size_t headerEnd;
+        while((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            if(!fill()) { reused = wasReused; return -1; }
+        }
+        std::string header = buffer.substr(0, headerEnd);
+        buffer.erase(0, headerEnd + 4);
+        int status = 0;
+        if(sscanf(header.c_str(), "HTTP/1.%*d %d", &status) != 1) return -1;
+
+        std::string lower = header;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        bool close = lower.find("connection: close") != std::string::npos;
+        size_t pos = lower.find("content-length:");
+        if(pos != std::string::npos) {
+            size_t length = strtoul(lower.c_str() + pos + 15, nullptr, 10);
+            while(buffer.size() < length) {
+                if(!fill()) return -1;
+            }
+            body = buffer.substr(0, length);
+            buffer.erase(0, length);
+        } else {
+            // No length: body ends when the server closes the connection
+            while(fill()) {}
+            body.swap(buffer);
+            buffer.clear();
+            close = true;
+        }
+        if(close || !opt.keepAlive) this->close();
+        return status;
+    }
+
+    bool fill() {
+        char chunk[2048];
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if(n <= 0) return false;
+        buffer.append(chunk, n);
+        return true;
+    }
+};
+
+// ============================================================================
+// CLIENT THREAD
+// ============================================================================
+
+static std::string buildRequest(const Options &opt, const Endpoint &ep, uint32_t clientID,
+                                uint32_t transaction, std::mt19937 &rng) {
+    char path[128];
+    snprintf(path, sizeof(path), "/api/v1/rotator/%d/%s", opt.device, ep.method);
+    char ids[64];
+    snprintf(ids, sizeof(ids), "ClientID=%u&ClientTransactionID=%u", clientID, transaction);
+    const char *connection = opt.keepAlive ? "keep-alive" : "close";
+
+    char request[512];
+    if(!ep.put) {
+        snprintf(request, sizeof(request),
+                 "GET %s?%s HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\nAccept: application/json\r\n\r\n",
+                 path, ids, opt.host.c_str(), connection);
+    } else {
+        char body[128];
+        if(strcmp(ep.method, "move") == 0) {
+            std::uniform_real_distribution<double> d(-0.5, 0.5);
+            snprintf(body, sizeof(body), "Position=%.3f&%s", d(rng), ids);
+        } else if(strcmp(ep.method, "moveabsolute") == 0) {
+            std::uniform_real_distribution<double> d(0.0, 359.0);
+            snprintf(body, sizeof(body), "Position=%.3f&%s", d(rng), ids);
+        } else {
+            snprintf(body, sizeof(body), "%s", ids);
+        }
+        snprintf(request, sizeof(request),
+                 "PUT %s HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\n"
+                 "Content-Type: application/x-www-form-urlencoded\r\nContent-Length: %zu\r\n\r\n%s",
+                 path, opt.host.c_str(), connection, strlen(body), body);
+    }
+    return request;
+}
+
+// Alpaca-level check of a 200 response
+static bool responseOk(const std::string &body, uint32_t transaction) {
+    size_t pos = body.find("\"ErrorNumber\":");
+    if(pos == std::string::npos || atoi(body.c_str() + pos + 14) != 0) return false;
+    pos = body.find("\"ClientTransactionID\":");
+    return pos != std::string::npos && strtoul(body.c_str() + pos + 22, nullptr, 10) == transaction;
+}
+
+static void clientThread(const Options &opt, const sockaddr_in &addr, const std::vector<double> &weights,
+                         uint32_t clientID, Clock::time_point end, Result &result) {
+    std::mt19937 rng(clientID * 7919u);
+    std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+    Connection conn(opt, addr);
+    uint32_t transaction = 0;
+    std::string body;
+
+    auto interval = opt.rate > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / opt.rate))
+                                 : Clock::duration::zero();
+    // Stagger connections over one interval
+    Clock::time_point scheduled = Clock::now() + interval * clientID / std::max(opt.connections, 1);
+
+    while(scheduled < end) {
+        if(opt.rate > 0) std::this_thread::sleep_until(scheduled);
+        Clock::time_point start = opt.rate > 0 ? scheduled : Clock::now();
+
+        size_t e = pick(rng);
+        transaction++;
+        std::string raw = buildRequest(opt, endpoints[e], clientID, transaction, rng);
+        int status = conn.request(raw, body);
+        uint32_t us = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+        result.latencyUs[e].push_back(us);
+        if(status != 200 || !responseOk(body, transaction)) {
+            result.errors[e]++;
+        }
+        if(status < 0 && opt.rate <= 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Unreachable: don't spin
+        }
+        scheduled = opt.rate > 0 ? scheduled + interval : Clock::now();
+    }
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+
+static double percentile(const std::vector<uint32_t> &sorted, double p) {
+    if(sorted.empty()) return 0;
+    size_t i = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(i, sorted.size() - 1)] / 1000.0;
+}
+
+static void report(const Options &opt, std::vector<Result> &results, double seconds) {
+    if(opt.csv) {
+        printf("endpoint,count,errors,error_rate,rps,p50_ms,p99_ms,p999_ms,max_ms\n");
+    } else {
+        printf("\n%-20s %8s %7s %7s %8s %9s %9s %9s %9s\n", "endpoint", "count", "errors", "err%",
+               "req/s", "p50 ms", "p99 ms", "p999 ms", "max ms");
+    }
+
+    std::vector<uint32_t> all;
+    uint64_t allErrors = 0;
+    auto line = [&](const char *name, std::vector<uint32_t> &lat, uint64_t errors) {
+        std::sort(lat.begin(), lat.end());
+        double rate = lat.empty() ? 0 : 100.0 * errors / lat.size();
+        const char *format = opt.csv ? "%s,%zu,%llu,%.3f,%.1f,%.2f,%.2f,%.2f,%.2f\n"
+                                     : "%-20s %8zu %7llu %6.2f%% %8.1f %9.2f %9.2f %9.2f %9.2f\n";
+        printf(format, name, lat.size(), (unsigned long long)errors, rate, lat.size() / seconds,
+               percentile(lat, 0.50), percentile(lat, 0.99), percentile(lat, 0.999),
+               lat.empty() ? 0.0 : lat.back() / 1000.0);
+    };
+
+    for(size_t e = 0; e < endpointCount; e++) {
+        std::vector<uint32_t> lat;
+        uint64_t errors = 0;
+        for(Result &r : results) {
+            lat.insert(lat.end(), r.latencyUs[e].begin(), r.latencyUs[e].end());
+            errors += r.errors[e];
+        }
+        if(lat.empty()) continue;
+        all.insert(all.end(), lat.begin(), lat.end());
+        allErrors += errors;
+        line(endpoints[e].method, lat, errors);
+    }
+    line("total", all, allErrors);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void usage() {
+    printf("usage: alpaca_load [--host H] [--port P] [--device N] [--connections C]\n"
+           "                   [--rate R] [--duration S] [--timeout MS] [--close] [--csv]\n"
+           "                   [--mix name:weight,...]\n"
+           "  --rate      requests/s per connection (0 = as fast as possible)\n"
+           "  --close     new TCP connection per request instead of keep-alive\n"
+           "  --mix       endpoints: ");
+    for(size_t e = 0; e < endpointCount; e++) printf("%s%s", e ? ", " : "", endpoints[e].method);
+    printf("\n             default position:40,ismoving:40,targetposition:10,move:5,halt:5\n");
+}
+
+static bool parseMix(const std::string &mix, std::vector<double> &weights) {
+    weights.assign(endpointCount, 0);
+    size_t start = 0;
+    while(start < mix.size()) {
+        size_t end = mix.find(',', start);
+        std::string item = mix.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        size_t colon = item.find(':');
+        std::string name = item.substr(0, colon);
+        double w = colon == std::string::npos ? 1 : atof(item.c_str() + colon + 1);
+        size_t e = 0;
+        while(e < endpointCount && name != endpoints[e].method) e++;
+        if(e == endpointCount) {
+            fprintf(stderr, "unknown endpoint in mix: %s\n", name.c_str());
+            return false;
+        }
+        weights[e] = w;
+        if(end == std::string::npos) break;
+        start = end + 1;
+    }
+    return std::any_of(weights.begin(), weights.end(), [](double w) { return w > 0; });
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    for(int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char * {
+            if(i + 1 >= argc) { usage(); exit(1); }
+            return argv[++i];
+        };
+        if(a == "--host") opt.host = next();
+        else if(a == "--port") opt.port = atoi(next());
+        else if(a == "--device") opt.device = atoi(next());
+        else if(a == "--connections") opt.connections = std::max(1, atoi(next()));
+        else if(a == "--rate") opt.rate = atof(next());
+        else if(a == "--duration") opt.duration = atof(next());
+        else if(a == "--timeout") opt.timeoutMs = atoi(next());
+        else if(a == "--mix") opt.mix = next();
+        else if(a == "--close") opt.keepAlive = false;
+        else if(a == "--csv") opt.csv = true;
+        else { usage(); return a == "--help" || a == "-h" ? 0 : 1; }
+    }
+
+    std::vector<double> weights;
+    if(!parseMix(opt.mix, weights)) return 1;
+
+    addrinfo hints = {}, *info = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if(getaddrinfo(opt.host.c_str(), nullptr, &hints, &info) != 0 || !info) {
+        fprintf(stderr, "cannot resolve %s\n", opt.host.c_str());
+        return 1;
+    }
+    sockaddr_in addr = *(const sockaddr_in *)info->ai_addr;
+    addr.sin_port = htons(opt.port);
+    freeaddrinfo(info);
+
+    if(!opt.csv) {
+        char pacing[48] = "unpaced";
+        if(opt.rate > 0) snprintf(pacing, sizeof(pacing), "%g req/s each", opt.rate);
+        printf("alpaca_load: %s:%d device %d, %d connections, %s, %g s, %s\n", opt.host.c_str(), opt.port,
+               opt.device, opt.connections, pacing, opt.duration, opt.keepAlive ? "keep-alive" : "connection per request");
+    }
+
+    std::vector<Result> results(opt.connections);
+    std::vector<std::thread> threads;
+    Clock::time_point begin = Clock::now();
+    Clock::time_point end = begin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(opt.duration));
+    for(int c = 0; c < opt.connections; c++) {
+        threads.emplace_back(clientThread, std::cref(opt), std::cref(addr), std::cref(weights),
+                             (uint32_t)(c + 1), end, std::ref(results[c]));
+    }
+    for(std::thread &t : threads) t.join();
+
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    report(opt, results, seconds);
+    return 0;
+}
@@ -0,0 +1,82 @@
+// ============================================================================
+// Host benchmark: fixed-point angle pipeline vs. legacy double math
+// ============================================================================
+// Build & run on Linux (not part of the PlatformIO firmware build):
+//   g++ -O2 -std=gnu++17 -Iinclude tools/angle_bench.cpp -o angle_bench && ./angle_bench
+// ============================================================================
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include "angle_math.h"
+
+// Legacy implementation (as in getServoAngle()/moveServoToAngle() before)
+static double legacyStepsToAngle(int32_t currentPos) {
+    double motorDegrees = (currentPos / 4096.0) * 360.0;
+    double gearDegrees = motorDegrees / 2.0;
+    while(gearDegrees >= 360.0) gearDegrees -= 360.0;
+    while(gearDegrees < 0.0) gearDegrees += 360.0;
+    return gearDegrees;
+}
+
+static int32_t legacyMoveDelta(double currentAngle, double angleDeg) {
+    while(angleDeg >= 360.0) angleDeg -= 360.0;
+    while(angleDeg < 0.0) angleDeg += 360.0;
+    double deltaDeg = angleDeg - currentAngle;
+    while(deltaDeg > 180.0) deltaDeg -= 360.0;
+    while(deltaDeg < -180.0) deltaDeg += 360.0;
+    double motorDegrees = deltaDeg * 2.0;
+    return (int32_t)((motorDegrees / 360.0) * 4096.0);
+}
+
+template<typename F>
+static void run(const char *name, size_t n, F fn) {
+    volatile int64_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < n; i++) {
+        sink = sink + fn(i);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double sec = std::chrono::duration<double>(t1 - t0).count();
+    printf("%-44s %12.2f Mconv/s  (%.1f ns/conv)\n", name, n / sec / 1e6, sec * 1e9 / n);
+}
+
+int main() {
+    const size_t N = 20000000;
+    std::vector<int32_t> steps(4096);
+    std::vector<double> degrees(4096);
+    for(size_t i = 0; i < steps.size(); i++) {
+        steps[i] = (int32_t)(i * 7919) % (4 * GEAR_STEPS_PER_REV) - 2 * GEAR_STEPS_PER_REV;
+        degrees[i] = (double)((i * 104729) % 36000) / 100.0;
+    }
+
+    printf("== steps -> angle (normal range) ==\n");
+    run("legacy double + while wrap", N, [&](size_t i) {
+        return (int64_t)(legacyStepsToAngle(steps[i & 4095]) * 1000);
+    });
+    run("fixed-point stepsToMilliDegrees", N, [&](size_t i) {
+        return (int64_t)stepsToMilliDegrees(steps[i & 4095]);
+    });
+
+    printf("== steps -> angle (corrupted accumulator, 250000 revs) ==\n");
+    const int32_t big = 250000 * GEAR_STEPS_PER_REV;  // ~2e9 steps, stays inside int32
+    run("legacy double + while wrap", N / 1000, [&](size_t i) {
+        return (int64_t)(legacyStepsToAngle(big + steps[i & 4095]) * 1000);
+    });
+    run("fixed-point stepsToMilliDegrees", N, [&](size_t i) {
+        return (int64_t)stepsToMilliDegrees(big + steps[i & 4095]);
+    });
+
+    printf("== shortest-path move delta ==\n");
+    run("legacy double + while wrap", N, [&](size_t i) {
+        return (int64_t)legacyMoveDelta(degrees[i & 4095], degrees[(i + 1) & 4095]);
+    });
+    run("fixed-point shortestStepDelta", N, [&](size_t i) {
+        return (int64_t)shortestStepDelta(steps[i & 4095], steps[(i + 1) & 4095]);
+    });
+    run("degreesToSteps + shortestStepDelta (JSON)", N, [&](size_t i) {
+        return (int64_t)shortestStepDelta(steps[i & 4095], degreesToSteps(degrees[(i + 1) & 4095]));
+    });
+    return 0;
+}
@@ -0,0 +1,113 @@
+# ============================================================================
+# Embed web/ into the firmware: minify, gzip, ETag -> src/web_assets.cpp
+# ============================================================================
+# Runs before every PlatformIO build (extra_scripts = pre:tools/embed_web.py)
+# or by hand:  python3 tools/embed_web.py
+# The output is only rewritten when an asset changed, so unchanged pages do
+# not trigger a rebuild. The generated file is checked in.
+# ============================================================================
+
+import gzip
+import hashlib
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 (PlatformIO/SCons)
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+WEB_DIR = os.path.join(PROJECT_DIR, "web")
+OUTPUT = os.path.join(PROJECT_DIR, "src", "web_assets.cpp")
+
+CONTENT_TYPES = {
+    ".html": "text/html; charset=UTF-8",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+}
+
+
+def minify_css(css):
+    css = re.sub(r"/\*.*?\*/", "", css, flags=re.S)
+    css = re.sub(r"\s+", " ", css)
+    return re.sub(r"\s*([{}:;,>])\s*", r"\1", css).replace(";}", "}").strip()
+
+
+def minify_js(js):
+    # Conservative: drop comment-only lines and indentation, keep line breaks (ASI)
+    lines = [line.strip() for line in js.splitlines()]
+    return "\n".join(line for line in lines if line and not line.startswith("//"))
+
+
+def minify_html(html):
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.S)
+    html = re.sub(r"(<style>)(.*?)(</style>)", lambda m: m.group(1) + minify_css(m.group(2)) + m.group(3), html, flags=re.S)
+    html = re.sub(r"(<script>)(.*?)(</script>)", lambda m: m.group(1) + minify_js(m.group(2)) + m.group(3), html, flags=re.S)
+    parts = re.split(r"(<script>.*?</script>)", html, flags=re.S)
+    for i in range(0, len(parts), 2):
+        parts[i] = re.sub(r">\s+<", "><", re.sub(r"\n\s*", "\n", parts[i])).replace("\n", " ")
+    return "".join(parts).replace("> <script>", "><script>").replace("</script> <", "</script><").strip()
+
+
+def minify(name, text):
+    ext = os.path.splitext(name)[1]
+    if ext == ".html":
+        return minify_html(text)
+    if ext == ".css":
+        return minify_css(text)
+    if ext == ".js":
+        return minify_js(text)
+    return text
+
+
+def identifier(name):
+    return "web_" + re.sub(r"[^0-9a-zA-Z]", "_", name)
+
+
+def generate():
+    assets = []
+    for name in sorted(os.listdir(WEB_DIR)):
+        ext = os.path.splitext(name)[1]
+        if ext not in CONTENT_TYPES:
+            continue
+        with open(os.path.join(WEB_DIR, name), "rb") as f:
+            source = f.read()
+        data = source
+        if ext in (".html", ".css", ".js"):
+            data = minify(name, source.decode("utf-8")).encode("utf-8")
+        packed = gzip.compress(data, compresslevel=9, mtime=0)  # mtime=0: reproducible bytes and ETag
+        etag = hashlib.sha1(packed).hexdigest()[:16]
+        assets.append((name, CONTENT_TYPES[ext], packed, etag, len(source), len(data)))
+
+    out = []
+    out.append("// Generated by tools/embed_web.py from web/ - do not edit.\n")
+    out.append('#include "web_assets.h"\n\n')
+    for name, _, packed, _, source_len, min_len in assets:
+        out.append("// %s: %d bytes source, %d minified, %d gzip\n" % (name, source_len, min_len, len(packed)))
+        out.append("static const uint8_t %s[] = {\n" % identifier(name))
+        for i in range(0, len(packed), 16):
+            out.append("    " + ", ".join("0x%02x" % b for b in packed[i:i + 16]) + ",\n")
+        out.append("};\n\n")
+    out.append("const WebAsset webAssets[] = {\n")
+    for name, content_type, packed, etag, _, _ in assets:
+        out.append('    {"%s", "%s", %s, sizeof(%s), "\\"%s\\""},\n'
+                   % (name, content_type, identifier(name), identifier(name), etag))
+    out.append("};\n\n")
+    out.append("const size_t webAssetCount = sizeof(webAssets) / sizeof(webAssets[0]);\n")
+    text = "".join(out)
+
+    old = None
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, "r") as f:
+            old = f.read()
+    if text != old:
+        with open(OUTPUT, "w") as f:
+            f.write(text)
+    for name, _, packed, etag, source_len, _ in assets:
+        print("web asset %-16s %6d -> %5d bytes  ETag %s" % (name, source_len, len(packed), etag))
+
+
+generate()
@@ -0,0 +1,4 @@
+#pragma once
+
+// Host platform: the display is not simulated (display_control.h only needs the type)
+class Adafruit_SSD1306;
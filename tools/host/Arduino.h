@@ -0,0 +1,156 @@
+#pragma once
+
+// ============================================================================
+// HOST PLATFORM: Arduino core subset
+// ============================================================================
+// Just enough of the ESP32 Arduino core for the web and Alpaca modules to
+// build and run on Linux (tools/alpaca_host.cpp). Time comes from the
+// monotonic clock, Serial output is discarded, heap figures come from the
+// host operator new/delete (see host_platform.h).
+// ============================================================================
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <string>
+
+typedef uint8_t byte;
+
+#define F(x) x
+#define PROGMEM
+#define IRAM_ATTR
+
+class String {
+public:
+    String() {}
+    String(const char *c) : s(c ? c : "") {}
+    String(const std::string &c) : s(c) {}
+    String(char c) : s(1, c) {}
+    String(int v) : s(std::to_string(v)) {}
+    String(unsigned v) : s(std::to_string(v)) {}
+    String(long v) : s(std::to_string(v)) {}
+    String(unsigned long v) : s(std::to_string(v)) {}
+    String(long long v) : s(std::to_string(v)) {}
+    String(unsigned long long v) : s(std::to_string(v)) {}
+    String(float v, unsigned decimals = 2) : String((double)v, decimals) {}
+    String(double v, unsigned decimals = 2) {
+        char b[64];
+        snprintf(b, sizeof(b), "%.*f", (int)decimals, v);
+        s = b;
+    }
+
+    String &operator+=(const String &o) { s += o.s; return *this; }
+    String &operator+=(const char *o) { s += o; return *this; }
+    String &operator+=(char o) { s += o; return *this; }
+    friend String operator+(const String &a, const String &b) { return String(a.s + b.s); }
+    friend String operator+(const String &a, const char *b) { return String(a.s + b); }
+    friend String operator+(const char *a, const String &b) { return String(a + b.s); }
+    bool operator==(const char *o) const { return s == o; }
+    bool operator==(const String &o) const { return s == o.s; }
+    bool operator!=(const char *o) const { return s != o; }
+    bool operator!=(const String &o) const { return s != o.s; }
+    char operator[](unsigned i) const { return i < s.size() ? s[i] : 0; }
+
+    const char *c_str() const { return s.c_str(); }
+    unsigned length() const { return s.size(); }
+    bool isEmpty() const { return s.empty(); }
+    void reserve(unsigned n) { s.reserve(n); }
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return atof(s.c_str()); }
+    double toDouble() const { return atof(s.c_str()); }
+    bool equals(const String &o) const { return s == o.s; }
+    bool equalsIgnoreCase(const String &o) const { return strcasecmp(s.c_str(), o.s.c_str()) == 0; }
+    bool startsWith(const String &p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+    bool endsWith(const String &p) const {
+        return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0;
+    }
+    int indexOf(char c, unsigned from = 0) const { return position(s.find(c, from)); }
+    int indexOf(const String &t, unsigned from = 0) const { return position(s.find(t.s, from)); }
+    String substring(unsigned from) const { return from < s.size() ? String(s.substr(from)) : String(); }
+    String substring(unsigned from, unsigned to) const {
+        return from < to && from < s.size() ? String(s.substr(from, to - from)) : String();
+    }
+    void replace(const String &find, const String &with) {
+        if(find.s.empty()) return;
+        for(size_t p = s.find(find.s); p != std::string::npos; p = s.find(find.s, p + with.s.size())) {
+            s.replace(p, find.s.size(), with.s);
+        }
+    }
+    void toLowerCase() { for(char &c : s) c = tolower((unsigned char)c); }
+    void toUpperCase() { for(char &c : s) c = toupper((unsigned char)c); }
+    void trim() {
+        size_t a = s.find_first_not_of(" \t\r\n");
+        size_t b = s.find_last_not_of(" \t\r\n");
+        s = a == std::string::npos ? std::string() : s.substr(a, b - a + 1);
+    }
+
+private:
+    static int position(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+    std::string s;
+};
+
+// Serial output is discarded on the host; the harness reports through stdout
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) { return 1; }
+    virtual size_t write(const uint8_t *, size_t n) { return n; }
+    size_t write(const char *s) { return strlen(s); }
+    template<class T> size_t print(const T &) { return 0; }
+    template<class T> size_t print(const T &, int) { return 0; }
+    template<class T> size_t println(const T &) { return 0; }
+    template<class T> size_t println(const T &, int) { return 0; }
+    size_t println() { return 0; }
+    size_t printf(const char *, ...) { return 0; }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+    virtual void flush() {}
+};
+
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long, uint32_t = 0, int8_t = -1, int8_t = -1) {}
+    void end() {}
+    operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+template<class T, class L, class H>
+T constrain(T x, L low, H high) {
+    return x < low ? low : (x > high ? high : x);
+}
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+class EspClass {
+public:
+    void restart();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getMaxAllocHeap();
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getCycleCount();   // esp_timer time at getCpuFreqMHz()
+};
+extern EspClass ESP;
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char *server1,
+                const char *server2 = nullptr, const char *server3 = nullptr);
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "IPAddress.h"
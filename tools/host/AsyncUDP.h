@@ -0,0 +1,28 @@
+#pragma once
+
+// Host platform: UDP sockets accept the configuration and never receive
+#include "WiFi.h"
+#include <functional>
+
+class IPv6Address {
+public:
+    IPv6Address() {}
+    explicit IPv6Address(const uint8_t *) {}
+};
+
+class AsyncUDPPacket {
+public:
+    uint8_t *data() { return nullptr; }
+    size_t length() { return 0; }
+    bool isIPv6() { return false; }
+    size_t write(const uint8_t *, size_t len) { return len; }
+};
+typedef std::function<void(AsyncUDPPacket &packet)> AuPacketHandlerFunction;
+
+class AsyncUDP {
+public:
+    void onPacket(AuPacketHandlerFunction) {}
+    bool listen(const IPAddress &, uint16_t) { return true; }
+    bool listenMulticast(const IPv6Address &, uint16_t, uint8_t = 1) { return true; }
+    void close() {}
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+// Host platform: captive portal DNS is a no-op
+#include "WiFi.h"
+
+class DNSServer {
+public:
+    bool start(uint16_t, const char *, const IPAddress &) { return true; }
+    void processNextRequest() {}
+    void stop() {}
+};
@@ -0,0 +1,214 @@
+#pragma once
+
+// ============================================================================
+// HOST PLATFORM: ESPAsyncWebServer subset
+// ============================================================================
+// The request/response API the firmware handlers use, implemented without a
+// network: a request is built from method, URL (with query), form body and
+// headers, AsyncWebServer::hostHandle() picks the handler the way the
+// library does (handlers in registration order, URI exact or as "uri/"
+// prefix, then onNotFound), runs it and drains the response it sent.
+//
+// Abstract responses are drained through _fillBuffer() in hostSegment-sized
+// pieces (default one TCP segment), like the async_tcp send path; the body
+// is stored decoded (no chunk framing). Response objects are deleted after
+// draining, which returns pooled responses to their pool.
+// ============================================================================
+
+#include "Arduino.h"
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef enum {
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServerRequest;
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+
+class AsyncWebParameter {
+public:
+    AsyncWebParameter(const String &name, const String &value, bool form = false)
+        : paramName(name), paramValue(value), form(form) {}
+    const String &name() const { return paramName; }
+    const String &value() const { return paramValue; }
+    bool isPost() const { return form; }
+
+private:
+    String paramName;
+    String paramValue;
+    bool form;
+};
+
+class AsyncWebHeader {
+public:
+    AsyncWebHeader(const String &name, const String &value) : headerName(name), headerValue(value) {}
+    const String &name() const { return headerName; }
+    const String &value() const { return headerValue; }
+
+private:
+    String headerName;
+    String headerValue;
+};
+
+// ============================================================================
+// RESPONSES
+// ============================================================================
+
+class AsyncWebServerResponse {
+public:
+    virtual ~AsyncWebServerResponse() {}
+    void addHeader(const String &name, const String &value) { headers.emplace_back(name, value); }
+    void setCode(int code) { _code = code; }
+    virtual bool _sourceValid() const { return false; }
+
+    // Host: status line, headers and body into the request's host* fields
+    virtual void _hostSend(AsyncWebServerRequest *request);
+
+protected:
+    int _code = 0;
+    String _contentType;
+    size_t _contentLength = 0;
+    bool _chunked = false;
+    bool _sendContentLength = true;
+    std::vector<AsyncWebHeader> headers;
+};
+
+class AsyncBasicResponse : public AsyncWebServerResponse {
+public:
+    AsyncBasicResponse(int code, const String &contentType = String(), const String &content = String());
+    bool _sourceValid() const override { return true; }
+    void _hostSend(AsyncWebServerRequest *request) override;
+
+private:
+    String content;
+};
+
+class AsyncProgmemResponse : public AsyncWebServerResponse {
+public:
+    AsyncProgmemResponse(int code, const String &contentType, const uint8_t *content, size_t len);
+    bool _sourceValid() const override { return true; }
+    void _hostSend(AsyncWebServerRequest *request) override;
+
+private:
+    const uint8_t *content;
+};
+
+class AsyncAbstractResponse : public AsyncWebServerResponse {
+public:
+    virtual size_t _fillBuffer(uint8_t *, size_t) { return 0; }
+    void _hostSend(AsyncWebServerRequest *request) override;
+};
+
+// ============================================================================
+// REQUEST
+// ============================================================================
+
+class AsyncWebServerRequest {
+public:
+    // Host: url may carry a query string; body is application/x-www-form-urlencoded (PUT/POST)
+    AsyncWebServerRequest(WebRequestMethod method, const char *url, const char *body = nullptr);
+    ~AsyncWebServerRequest();
+    AsyncWebServerRequest(const AsyncWebServerRequest &) = delete;
+    AsyncWebServerRequest &operator=(const AsyncWebServerRequest &) = delete;
+
+    WebRequestMethodComposite method() const { return requestMethod; }
+    const String &url() const { return requestUrl; }
+    uint8_t version() const { return httpVersion; }   // 0 = HTTP/1.0, 1 = HTTP/1.1
+
+    size_t params() const { return requestParams.size(); }
+    const AsyncWebParameter *getParam(size_t i) const { return i < requestParams.size() ? &requestParams[i] : nullptr; }
+    const AsyncWebParameter *getParam(const String &name, bool post = false) const;
+    bool hasParam(const String &name, bool post = false) const { return getParam(name, post) != nullptr; }
+    bool hasArg(const char *name) const;
+    const String &arg(const String &name) const;
+
+    size_t headers() const { return requestHeaders.size(); }
+    bool hasHeader(const String &name) const { return getHeader(name) != nullptr; }
+    const AsyncWebHeader *getHeader(const String &name) const;
+    const String &header(const char *name) const;
+
+    void send(AsyncWebServerResponse *response);
+    void send(int code, const String &contentType = String(), const String &content = String());
+    AsyncWebServerResponse *beginResponse(int code, const String &contentType = String(), const String &content = String());
+    AsyncWebServerResponse *beginResponse_P(int code, const String &contentType, const uint8_t *content, size_t len);
+
+    // Host: request setup and the captured response
+    void hostAddHeader(const char *name, const char *value) { requestHeaders.emplace_back(name, value); }
+    void hostSetVersion(uint8_t version) { httpVersion = version; }
+    void hostFinish();                       // drain and delete the response that was sent
+
+    size_t hostSegment = 1460;               // bytes per _fillBuffer call
+    int hostSends = 0;                       // send() calls; the server expects exactly one
+    int hostCode = 0;                        // 0: no response sent
+    std::string hostContentType;
+    std::vector<AsyncWebHeader> hostHeaders;
+    std::string hostBody;
+    const String *hostHeader(const char *name) const;
+
+private:
+    void addParams(const char *text, size_t len, bool form);
+
+    WebRequestMethodComposite requestMethod;
+    String requestUrl;
+    uint8_t httpVersion = 1;
+    std::vector<AsyncWebParameter> requestParams;
+    std::vector<AsyncWebHeader> requestHeaders;
+    AsyncWebServerResponse *response = nullptr;
+};
+
+// ============================================================================
+// HANDLERS & SERVER
+// ============================================================================
+
+class AsyncWebHandler {
+public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest *) { return false; }
+    virtual void handleRequest(AsyncWebServerRequest *) {}
+    virtual bool isRequestHandlerTrivial() { return true; }
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler {
+public:
+    AsyncCallbackWebHandler(const String &uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest)
+        : uri(uri), method(method), onRequest(onRequest) {}
+    bool canHandle(AsyncWebServerRequest *request) override;
+    void handleRequest(AsyncWebServerRequest *request) override;
+
+private:
+    String uri;
+    WebRequestMethodComposite method;
+    ArRequestHandlerFunction onRequest;
+};
+
+class AsyncWebServer {
+public:
+    explicit AsyncWebServer(uint16_t port) {}
+    ~AsyncWebServer();
+    void begin() {}
+
+    AsyncCallbackWebHandler &on(const char *uri, ArRequestHandlerFunction onRequest) {
+        return on(uri, HTTP_ANY, onRequest);
+    }
+    AsyncCallbackWebHandler &on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest);
+    AsyncWebHandler &addHandler(AsyncWebHandler *handler);
+    void onNotFound(ArRequestHandlerFunction fn) { notFound = fn; }
+
+    // Host: run the request through the handlers and capture the response
+    void hostHandle(AsyncWebServerRequest &request);
+
+private:
+    std::vector<AsyncWebHandler *> handlers;
+    ArRequestHandlerFunction notFound;
+};
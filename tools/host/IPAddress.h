@@ -0,0 +1,24 @@
+#pragma once
+
+// Host platform: IPv4 address as in the Arduino core
+class IPAddress {
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+    explicit IPAddress(uint32_t address) { memcpy(bytes, &address, 4); }
+
+    uint8_t operator[](int i) const { return bytes[i & 3]; }
+    operator uint32_t() const {
+        uint32_t address;
+        memcpy(&address, bytes, 4);
+        return address;
+    }
+    String toString() const {
+        char b[16];
+        snprintf(b, sizeof(b), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+        return String(b);
+    }
+
+private:
+    uint8_t bytes[4] = {};
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+// Host platform: NVS namespaces kept in memory for the lifetime of the process
+#include "Arduino.h"
+
+class Preferences {
+public:
+    bool begin(const char *name, bool readOnly = false);
+    void end();
+    bool clear();
+    bool remove(const char *key);
+    bool isKey(const char *key);
+
+    size_t putBytes(const char *key, const void *value, size_t len);
+    size_t getBytes(const char *key, void *buf, size_t maxLen);
+    size_t getBytesLength(const char *key);
+
+    size_t putString(const char *key, const String &value) { return putBytes(key, value.c_str(), value.length()); }
+    String getString(const char *key, const String &defaultValue = String());
+
+    size_t putBool(const char *key, bool value) { return putValue(key, (uint8_t)value); }
+    bool getBool(const char *key, bool defaultValue = false) { return getValue(key, (uint8_t)defaultValue) != 0; }
+    size_t putUChar(const char *key, uint8_t value) { return putValue(key, value); }
+    uint8_t getUChar(const char *key, uint8_t defaultValue = 0) { return getValue(key, defaultValue); }
+    size_t putUShort(const char *key, uint16_t value) { return putValue(key, value); }
+    uint16_t getUShort(const char *key, uint16_t defaultValue = 0) { return getValue(key, defaultValue); }
+    size_t putInt(const char *key, int32_t value) { return putValue(key, value); }
+    int32_t getInt(const char *key, int32_t defaultValue = 0) { return getValue(key, defaultValue); }
+    size_t putUInt(const char *key, uint32_t value) { return putValue(key, value); }
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0) { return getValue(key, defaultValue); }
+
+private:
+    template<typename T> size_t putValue(const char *key, T value) { return putBytes(key, &value, sizeof(T)); }
+    template<typename T> T getValue(const char *key, T defaultValue) {
+        T value;
+        return getBytesLength(key) == sizeof(T) && getBytes(key, &value, sizeof(T)) == sizeof(T) ? value : defaultValue;
+    }
+
+    std::string space;
+    bool open = false;
+    bool readOnly = false;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+// Host platform: a station that is connected (see hostWiFi in host_platform.h)
+#include "Arduino.h"
+
+typedef enum { WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_CONNECTED = 3, WL_CONNECT_FAILED = 4, WL_DISCONNECTED = 6 } wl_status_t;
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+typedef enum { WIFI_AUTH_OPEN = 0, WIFI_AUTH_WPA2_PSK = 3 } wifi_auth_mode_t;
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP = 8,
+} arduino_event_id_t;
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+
+class WiFiClass {
+public:
+    wl_status_t status();
+    wifi_mode_t getMode() { return wifiMode; }
+    bool mode(wifi_mode_t m) { wifiMode = m; return true; }
+    void begin(const char *, const char * = nullptr) {}
+    bool disconnect(bool = false, bool = false) { return true; }
+    bool softAP(const char *, const char * = nullptr) { return true; }
+    bool softAPConfig(IPAddress, IPAddress, IPAddress) { return true; }
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+    IPAddress localIP();
+    String macAddress() { return "02:00:00:00:00:01"; }
+    String SSID() { return "host"; }
+    String SSID(int) { return "host"; }
+    int8_t RSSI();
+    int8_t RSSI(int) { return RSSI(); }
+    wifi_auth_mode_t encryptionType(int) { return WIFI_AUTH_WPA2_PSK; }
+    int16_t scanNetworks(bool = false, bool = false) { return 0; }
+    void scanDelete() {}
+    bool setAutoReconnect(bool) { return true; }
+    bool enableIpV6() { return true; }
+    int onEvent(WiFiEventCb callback, arduino_event_id_t = (arduino_event_id_t)0);
+
+private:
+    wifi_mode_t wifiMode = WIFI_STA;
+};
+extern WiFiClass WiFi;
@@ -0,0 +1,13 @@
+#pragma once
+
+// Host platform: heap figures of the host operator new/delete, as if the
+// firmware ran on an ESP32 heap of HOST_HEAP_SIZE bytes
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_minimum_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
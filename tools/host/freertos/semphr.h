@@ -0,0 +1,6 @@
+#pragma once
+
+// Host platform: mutexes always succeed (single threaded)
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
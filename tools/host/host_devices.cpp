@@ -0,0 +1,344 @@
+// ============================================================================
+// HOST PLATFORM: simulated rotators and display
+// ============================================================================
+// servo_control.h and display_control.h without a servo bus. Motion requests
+// are queued and merged as on the device; hostServoFlush() plays the bus
+// task sending them, hostServoPoll() also lets every rotator arrive and
+// reads it back. Moving and target follow servo_control.cpp: a request is
+// moving from the queue until a read after the write shows it arrived.
+// ============================================================================
+
+#include <Arduino.h>
+#include "host_platform.h"
+#include "servo_control.h"
+#include "display_control.h"
+#include "angle_math.h"
+
+enum SimMotion { SIM_NONE = 0, SIM_TO, SIM_BY, SIM_HALT };
+
+struct SimRotator {
+    int32_t position = 0;       // logical steps, not wrapped
+    int32_t target = 0;         // active move
+    SimMotion queued = SIM_NONE;
+    int32_t queuedSteps = 0;
+    int64_t queuedUs = 0;
+    bool reverse = false;
+    int speed = 1000;
+    int mode = 3;
+    int32_t stepsPerRev = GEAR_STEPS_PER_REV;
+    int64_t moveSentUs = 0;
+    int64_t feedbackUs = 0;
+    LinkHealth link;
+};
+
+static SimRotator sim[MAX_ROTATORS];
+static int rotatorCount = 1;
+static bool servoReady = true;
+static MotionStats motionStats;
+static PollSchedule pollSchedule;
+static bool displayEnabled = true;
+
+static bool validDevice(int dev) {
+    return servoReady && dev >= 0 && dev < rotatorCount;
+}
+
+// Target of a queued request seen from the current position, as getMotionState()
+static int32_t simTarget(const SimRotator &r) {
+    switch(r.queued) {
+        case SIM_TO: return r.position + shortestStepDelta(r.position, r.queuedSteps);
+        case SIM_BY: return r.position + r.queuedSteps;
+        case SIM_HALT: return r.position;
+        default: return r.target;
+    }
+}
+
+static bool simMoving(const SimRotator &r) {
+    if(r.link.state == LINK_OFFLINE) return false;
+    bool queued = r.queued == SIM_TO || r.queued == SIM_BY;
+    bool unread = r.moveSentUs && r.feedbackUs <= r.moveSentUs;
+    return queued || unread || r.position != r.target;
+}
+
+// ============================================================================
+// HOST CONTROLS
+// ============================================================================
+
+void hostSetRotatorCount(int count) {
+    rotatorCount = count < 1 ? 1 : count > MAX_ROTATORS ? MAX_ROTATORS : count;
+}
+
+void hostServoFlush() {
+    int64_t now = esp_timer_get_time();
+    for(int dev = 0; dev < rotatorCount; dev++) {
+        SimRotator &r = sim[dev];
+        if(r.link.state == LINK_OFFLINE) {
+            r.queued = SIM_NONE;   // dropped like on the device
+            continue;
+        }
+        if(r.queued == SIM_NONE) continue;
+        r.target = simTarget(r);
+        uint32_t waited = (uint32_t)(now - r.queuedUs);
+        motionStats.applied++;
+        motionStats.lastDelayUs = waited;
+        if(waited > motionStats.maxDelayUs) motionStats.maxDelayUs = waited;
+        r.queued = SIM_NONE;
+        r.moveSentUs = now;
+    }
+}
+
+void hostServoPoll() {
+    hostServoFlush();
+    int64_t now = esp_timer_get_time();
+    for(int dev = 0; dev < rotatorCount; dev++) {
+        SimRotator &r = sim[dev];
+        if(r.link.state == LINK_OFFLINE) continue;
+        r.position = r.target;
+        r.feedbackUs = now + 1;   // the read that follows the move
+    }
+}
+
+int32_t hostServoSteps(int dev) {
+    return validDevice(dev) ? sim[dev].position : 0;
+}
+
+void hostSetServoReady(bool ready) {
+    servoReady = ready;
+}
+
+void hostSetRotatorOnline(int dev, bool online) {
+    if(!validDevice(dev)) return;
+    LinkHealth &link = sim[dev].link;
+    if(online == (link.state != LINK_OFFLINE)) return;
+    link.state = online ? LINK_ONLINE : LINK_OFFLINE;
+    link.changedUs = esp_timer_get_time();
+    if(!online) link.outages++;
+}
+
+// ============================================================================
+// SERVO CONTROL
+// ============================================================================
+
+void initServo() {}
+int scanForMotors() { return rotatorCount; }
+bool isServoReady() { return servoReady; }
+int getRotatorCount() { return servoReady ? rotatorCount : 0; }
+void startServoBusTasks() {}
+
+bool startBusBenchmark(uint32_t durationMs) { return false; }
+BusBenchResult getBusBenchmarkResult() { return BusBenchResult(); }
+
+PollSchedule getPollSchedule() { return pollSchedule; }
+void setPollSchedule(const PollSchedule &schedule) { pollSchedule = schedule; }
+void setStreamPollInterval(uint16_t ms) {}
+
+BusPollStats getBusPollStats(int bus) {
+    BusPollStats s;
+    if(bus != 0) return s;
+    s.enabled = true;
+    s.rotators = rotatorCount;
+    for(int dev = 0; dev < rotatorCount; dev++) {
+        if(simMoving(sim[dev])) s.moving = true;
+    }
+    return s;
+}
+
+static void postMotion(int dev, SimMotion kind, int32_t steps) {
+    if(!validDevice(dev)) return;
+    SimRotator &r = sim[dev];
+    if(r.queued != SIM_NONE) {
+        motionStats.merged++;
+    } else {
+        r.queuedUs = esp_timer_get_time();
+    }
+    if(kind == SIM_BY && (r.queued == SIM_BY || r.queued == SIM_TO)) {
+        r.queuedSteps += steps;
+    } else {
+        r.queued = kind;
+        r.queuedSteps = steps;
+    }
+    motionStats.requests++;
+}
+
+void requestMoveTo(int dev, int32_t targetSteps) { postMotion(dev, SIM_TO, targetSteps); }
+void requestMoveBy(int dev, int32_t deltaSteps) { postMotion(dev, SIM_BY, deltaSteps); }
+void requestHalt(int dev) { postMotion(dev, SIM_HALT, 0); }
+
+MotionStats getMotionStats() { return motionStats; }
+void resetMotionStats() { motionStats = MotionStats(); }
+
+void moveServoToSteps(int dev, int32_t targetSteps) {
+    requestMoveTo(dev, targetSteps);
+    hostServoPoll();
+}
+
+void moveServoToAngle(int dev, double angleDeg) {
+    moveServoToSteps(dev, degreesToSteps(angleDeg, getStepsPerRev(dev)));
+}
+
+void moveServoByAngle(int dev, double deltaDeg) {
+    requestMoveBy(dev, degreesToSteps(deltaDeg, getStepsPerRev(dev)));
+    hostServoPoll();
+}
+
+void gotoPosition(int dev, int targetPosition, int currentPos) {
+    moveServoToSteps(dev, targetPosition);
+}
+
+void resetServoAngleZero(int dev) { setZeroPointExact(dev); }
+void setZeroPointMode3(int dev) { setZeroPointExact(dev); }
+
+void setZeroPointExact(int dev) {
+    if(!validDevice(dev)) return;
+    sim[dev].position = sim[dev].target = 0;
+}
+
+void setCurrentTargetPosition(int dev, int32_t steps) {
+    if(!validDevice(dev)) return;
+    sim[dev].position = sim[dev].target = steps;
+}
+
+void stopServo(int dev) {
+    if(!validDevice(dev)) return;
+    sim[dev].queued = SIM_NONE;
+    sim[dev].target = sim[dev].position;
+}
+
+void servoTorque(int dev, bool enable) {}
+
+ServoLinkResult getServoLinkResult() {
+    ServoLinkResult result;
+    result.cached = true;
+    return result;
+}
+
+void forgetServoLinkCache() {}
+
+ServoConfigResult getServoConfigResult(int dev) {
+    ServoConfigResult result;
+    result.verified = validDevice(dev);   // simulated EEPROM always matches
+    return result;
+}
+
+bool getJournalEntry(int dev, JournalEntry &entry) {
+    if(!validDevice(dev)) return false;
+    const SimRotator &r = sim[dev];
+    bool settled = !simMoving(r);
+    entry.bus = 0;
+    entry.id = dev + 1;
+    entry.flags = settled ? 0 : JOURNAL_IN_FLIGHT;
+    entry.reserved = 0;
+    entry.position = r.target;
+    entry.motorTarget = r.target;
+    entry.spanSteps = abs(r.target - r.position);
+    return settled;
+}
+
+PositionRestore getPositionRestore(int dev) {
+    return PositionRestore();   // the simulation always starts at 0
+}
+
+void setMode(int dev, int mode) {
+    if(validDevice(dev)) sim[dev].mode = mode;
+}
+
+int32_t getServoSteps(int dev) {
+    return validDevice(dev) ? wrapSteps(sim[dev].position, sim[dev].stepsPerRev) : 0;
+}
+
+int32_t getLastServoSteps(int dev) {
+    return getServoSteps(dev);
+}
+
+int64_t getLastMoveSentUs(int dev) {
+    return validDevice(dev) ? sim[dev].moveSentUs : 0;
+}
+
+int64_t getLastFeedbackUs(int dev) {
+    return validDevice(dev) ? sim[dev].feedbackUs : 0;
+}
+
+bool isMotionSettled(int dev, int64_t *readUs) {
+    if(!validDevice(dev)) return false;
+    const SimRotator &r = sim[dev];
+    if(readUs) *readUs = r.feedbackUs;
+    return !simMoving(r) && r.feedbackUs > r.moveSentUs;
+}
+
+double getServoAngle(int dev) {
+    return stepsToDegrees(getServoSteps(dev), getStepsPerRev(dev));
+}
+
+bool getRotatorSnapshot(int dev, RotatorSnapshot &snapshot) {
+    if(!validDevice(dev)) return false;
+    const SimRotator &r = sim[dev];
+    snapshot.moving = simMoving(r);
+    snapshot.steps = wrapSteps(r.position, r.stepsPerRev);
+    snapshot.targetSteps = wrapSteps(simTarget(r), r.stepsPerRev);
+    snapshot.stepsPerRev = r.stepsPerRev;
+    snapshot.stale = r.link.state == LINK_OFFLINE;
+    snapshot.timeUs = r.feedbackUs;   // polled state, as on the device
+    return true;
+}
+
+void getFeedback() {}
+
+bool isServoMoving(int dev) {
+    return validDevice(dev) && simMoving(sim[dev]);
+}
+
+bool isMotorBlocked(int dev) { return validDevice(dev) && sim[dev].link.state == LINK_OFFLINE; }
+bool isFeedbackStale(int dev) { return isMotorBlocked(dev); }
+LinkHealth getLinkHealth(int dev) { return validDevice(dev) ? sim[dev].link : LinkHealth(); }
+
+const char *linkStateName(LinkState state) {
+    return state == LINK_ONLINE ? "online" : state == LINK_DEGRADED ? "degraded" : "offline";
+}
+int getServoLoad(int dev) { return 0; }
+int getServoSpeed(int dev) { return isServoMoving(dev) ? getActiveSpeed(dev) : 0; }
+int getServoVoltage(int dev) { return validDevice(dev) ? 120 : 0; }
+int getServoCurrent(int dev) { return 0; }
+int getServoTemperature(int dev) { return validDevice(dev) ? 30 : 0; }
+int getServoMode(int dev) { return validDevice(dev) ? sim[dev].mode : 0; }
+int getMotorID(int dev) { return validDevice(dev) ? dev + 1 : -1; }
+int getServoModel(int dev) { return 0; }   // no model register in the simulation
+int getServoBus(int dev) { return validDevice(dev) ? 0 : -1; }
+int32_t getStepsPerRev(int dev) { return validDevice(dev) ? sim[dev].stepsPerRev : GEAR_STEPS_PER_REV; }
+int getGearRatio(int dev) { return getStepsPerRev(dev) / SERVO_STEPS_PER_REV; }
+
+bool setGearRatio(int dev, int ratio) {
+    if(!validDevice(dev) || ratio < 1 || ratio > GEAR_RATIO_MAX || simMoving(sim[dev])) return false;
+    sim[dev].stepsPerRev = SERVO_STEPS_PER_REV * ratio;
+    return true;
+}
+
+void setReverseDirection(int dev, bool reverse) {
+    if(validDevice(dev)) sim[dev].reverse = reverse;
+}
+
+bool getReverseDirection(int dev) {
+    return validDevice(dev) && sim[dev].reverse;
+}
+
+int32_t getCurrentTargetPosition(int dev) {
+    return validDevice(dev) ? sim[dev].target : 0;
+}
+
+void setActiveSpeed(int dev, int speed) {
+    if(validDevice(dev)) sim[dev].speed = constrain(speed, 100, 4000);
+}
+
+int getActiveSpeed(int dev) {
+    return validDevice(dev) ? sim[dev].speed : 0;
+}
+
+// ============================================================================
+// DISPLAY
+// ============================================================================
+
+void initDisplay() {}
+void startDisplayTask() {}
+void displayMotorScan() {}
+void displayMessage(const char *line1, const char *line2, const char *line3, const char *line4) {}
+void displayOff() { displayEnabled = false; }
+void displayOn() { displayEnabled = true; }
+bool isDisplayEnabled() { return displayEnabled; }
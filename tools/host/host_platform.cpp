@@ -0,0 +1,315 @@
+// ============================================================================
+// HOST PLATFORM: Arduino core, ESP-IDF and FreeRTOS on Linux
+// ============================================================================
+// Clock, counted heap, registered-only tasks, manually fired timers, WiFi
+// station state and in-memory Preferences. See host_platform.h.
+// ============================================================================
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <Preferences.h>
+#include <esp_heap_caps.h>
+#include <esp_system.h>
+#include "host_platform.h"
+#include <chrono>
+#include <map>
+#include <new>
+#include <vector>
+#include <malloc.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+
+// ============================================================================
+// TIME
+// ============================================================================
+
+static const auto startTime = std::chrono::steady_clock::now();
+
+int64_t esp_timer_get_time() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+unsigned long millis() {
+    return (unsigned long)(esp_timer_get_time() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)esp_timer_get_time();
+}
+
+// Nothing runs concurrently on the host: waiting would only slow the harness down
+void delay(unsigned long ms) {}
+
+void yield() {}
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char *server1, const char *server2, const char *server3) {}
+
+// ============================================================================
+// HEAP
+// ============================================================================
+// Counted with the allocator's real block sizes; the figures stand in for the
+// ESP32 heap so handler heap statistics work unchanged.
+
+static HostHeapStats heap;
+
+static void *countedAlloc(size_t size) {
+    void *p = malloc(size ? size : 1);
+    if(!p) return nullptr;
+    heap.allocations++;
+    heap.liveBytes += malloc_usable_size(p);
+    if(heap.liveBytes > heap.peakBytes) heap.peakBytes = heap.liveBytes;
+    return p;
+}
+
+static void countedFree(void *p) {
+    if(!p) return;
+    heap.frees++;
+    heap.liveBytes -= malloc_usable_size(p);
+    free(p);
+}
+
+void *operator new(size_t size) {
+    void *p = countedAlloc(size);
+    if(!p) throw std::bad_alloc();
+    return p;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size); }
+void operator delete(void *p) noexcept { countedFree(p); }
+void operator delete[](void *p) noexcept { countedFree(p); }
+void operator delete(void *p, size_t) noexcept { countedFree(p); }
+void operator delete[](void *p, size_t) noexcept { countedFree(p); }
+
+HostHeapStats hostHeapStats() {
+    return heap;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return heap.liveBytes < HOST_HEAP_SIZE ? HOST_HEAP_SIZE - heap.liveBytes : 0;
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    return heap.peakBytes < HOST_HEAP_SIZE ? HOST_HEAP_SIZE - heap.peakBytes : 0;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return heap_caps_get_free_size(caps);
+}
+
+uint32_t EspClass::getFreeHeap() { return heap_caps_get_free_size(MALLOC_CAP_8BIT); }
+uint32_t EspClass::getMinFreeHeap() { return heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT); }
+uint32_t EspClass::getHeapSize() { return HOST_HEAP_SIZE; }
+uint32_t EspClass::getMaxAllocHeap() { return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT); }
+
+uint32_t EspClass::getCycleCount() {
+    return (uint32_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count()
+                      * getCpuFreqMHz() / 1000);
+}
+
+static int restarts = 0;
+static std::vector<shutdown_handler_t> shutdownHandlers;
+
+esp_err_t esp_register_shutdown_handler(shutdown_handler_t handler) {
+    shutdownHandlers.push_back(handler);
+    return ESP_OK;
+}
+
+static esp_reset_reason_t resetReason = ESP_RST_POWERON;
+
+esp_reset_reason_t esp_reset_reason() {
+    return resetReason;
+}
+
+void hostSetResetReason(esp_reset_reason_t reason) {
+    resetReason = reason;
+}
+
+void EspClass::restart() {
+    for(shutdown_handler_t handler : shutdownHandlers) handler();
+    restarts++;
+}
+
+int hostRestarts() {
+    return restarts;
+}
+
+// ============================================================================
+// FREERTOS
+// ============================================================================
+// Tasks are registered, not run: their loops never return and the harness
+// drives the code they would call directly.
+
+struct HostTask {
+    const char *name;
+};
+static std::vector<HostTask *> tasks;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char *name, uint32_t stackDepth, void *param,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core) {
+    tasks.push_back(new HostTask{name});
+    if(handle) *handle = tasks.back();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint32_t stackDepth, void *param,
+                       UBaseType_t priority, TaskHandle_t *handle) {
+    return xTaskCreatePinnedToCore(code, name, stackDepth, param, priority, handle, tskNO_AFFINITY);
+}
+
+int hostTaskCount() {
+    return (int)tasks.size();
+}
+
+void vTaskDelay(TickType_t ticks) { delay(ticks); }
+void vTaskDelete(TaskHandle_t task) {}
+TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }   // the harness thread
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task) { return 1; }
+TickType_t xTaskGetTickCount() { return (TickType_t)millis(); }
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) { return 0; }
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) { return 0; }
+BaseType_t xTaskNotifyGive(TaskHandle_t task) { return pdPASS; }
+BaseType_t xPortGetCoreID() { return ARDUINO_RUNNING_CORE; }
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    static int mutex;
+    return &mutex;
+}
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) { return pdTRUE; }
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) { return pdTRUE; }
+
+// ============================================================================
+// ESP_TIMER
+// ============================================================================
+
+struct esp_timer {
+    esp_timer_create_args_t args;
+    int64_t deadlineUs;
+    bool armed;
+};
+static std::vector<esp_timer *> timers;
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out) {
+    esp_timer *t = new esp_timer{*args, 0, false};
+    timers.push_back(t);
+    *out = t;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) {
+    if(timer->armed) return ESP_FAIL;   // ESP_ERR_INVALID_STATE on the device
+    timer->deadlineUs = esp_timer_get_time() + (int64_t)timeoutUs;
+    timer->armed = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if(!timer->armed) return ESP_FAIL;
+    timer->armed = false;
+    return ESP_OK;
+}
+
+int hostRunTimers(bool force) {
+    int fired = 0;
+    int64_t now = esp_timer_get_time();
+    for(esp_timer *t : timers) {
+        if(!t->armed || (!force && t->deadlineUs > now)) continue;
+        t->armed = false;
+        t->args.callback(t->args.arg);
+        fired++;
+    }
+    return fired;
+}
+
+// ============================================================================
+// WIFI
+// ============================================================================
+
+static bool wifiConnected = true;
+static int8_t wifiRssi = -55;
+static WiFiEventCb wifiEvent = nullptr;
+
+void hostSetWiFi(bool connected, int8_t rssi) {
+    bool changed = connected != wifiConnected;
+    wifiConnected = connected;
+    wifiRssi = rssi;
+    if(changed && wifiEvent) {
+        wifiEvent(connected ? ARDUINO_EVENT_WIFI_STA_GOT_IP : ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
+}
+
+wl_status_t WiFiClass::status() {
+    return wifiConnected ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+IPAddress WiFiClass::localIP() {
+    return wifiConnected ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+int8_t WiFiClass::RSSI() {
+    return wifiConnected ? wifiRssi : 0;
+}
+
+int WiFiClass::onEvent(WiFiEventCb callback, arduino_event_id_t) {
+    wifiEvent = callback;
+    return 1;
+}
+
+// ============================================================================
+// PREFERENCES
+// ============================================================================
+
+static std::map<std::string, std::map<std::string, std::string>> nvs;
+
+bool Preferences::begin(const char *name, bool readOnly) {
+    space = name;
+    open = true;
+    this->readOnly = readOnly;
+    return true;
+}
+
+void Preferences::end() {
+    open = false;
+}
+
+bool Preferences::clear() {
+    if(!open || readOnly) return false;
+    nvs[space].clear();
+    return true;
+}
+
+bool Preferences::remove(const char *key) {
+    if(!open || readOnly) return false;
+    return nvs[space].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+    return open && nvs[space].count(key) > 0;
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len) {
+    if(!open || readOnly) return 0;
+    nvs[space][key].assign((const char *)value, len);
+    return len;
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+    if(!open) return 0;
+    auto &entries = nvs[space];
+    auto it = entries.find(key);
+    return it == entries.end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) {
+    size_t len = getBytesLength(key);
+    if(len == 0 || len > maxLen) return 0;
+    memcpy(buf, nvs[space][key].data(), len);
+    return len;
+}
+
+String Preferences::getString(const char *key, const String &defaultValue) {
+    if(!isKey(key)) return defaultValue;
+    return String(nvs[space][key]);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+// ============================================================================
+// HOST PLATFORM CONTROLS
+// ============================================================================
+// What the harness can see and steer beyond the device API. Firmware modules
+// never include this header.
+//
+// Heap: every operator new/delete on the host is counted; the ESP heap calls
+// report HOST_HEAP_SIZE minus the live bytes, so the firmware's own heap
+// statistics (alpacastats, /metrics) show the real allocations of the code.
+//
+// Tasks and timers: xTaskCreate() only registers the task, esp_timer
+// one-shots only fire from hostRunTimers(). Handlers run on the caller's
+// thread, as they do on the async_tcp task.
+// ============================================================================
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_system.h"
+
+#define HOST_HEAP_SIZE (320 * 1024)
+
+struct HostHeapStats {
+    uint64_t allocations = 0;   // operator new calls since start
+    uint64_t frees = 0;
+    size_t liveBytes = 0;
+    size_t peakBytes = 0;
+};
+HostHeapStats hostHeapStats();
+
+// Fire every one-shot timer whose deadline has passed (all of them if force)
+int hostRunTimers(bool force = false);
+int hostTaskCount();                 // tasks registered by xTaskCreate
+int hostRestarts();                  // ESP.restart() calls, shutdown handlers run first
+void hostSetResetReason(esp_reset_reason_t reason);   // esp_reset_reason(), power-on by default
+
+// Station link as seen by WiFi.status() / RSSI() / localIP()
+void hostSetWiFi(bool connected, int8_t rssi = -55);
+
+// Simulated rotators (host_servo.cpp): moves are queued like on the device
+// and arrive when the harness lets the "bus task" run
+void hostSetRotatorCount(int count);
+void hostServoFlush();               // queued moves are sent, not yet arrived or read back
+void hostServoPoll();                // every queued or active move arrives
+int32_t hostServoSteps(int dev);     // raw position, not wrapped
+void hostSetRotatorOnline(int dev, bool online);  // offline: no moves, stale state
+void hostSetServoReady(bool ready);  // false: servo boot stage still running, no rotators
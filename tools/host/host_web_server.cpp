@@ -0,0 +1,238 @@
+// ============================================================================
+// HOST PLATFORM: ESPAsyncWebServer request routing and response capture
+// ============================================================================
+// See ESPAsyncWebServer.h in this directory.
+// ============================================================================
+
+#include <ESPAsyncWebServer.h>
+
+// ============================================================================
+// REQUEST
+// ============================================================================
+
+static int hexDigit(char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// application/x-www-form-urlencoded: '+' is a space, %XX a byte
+static String urlDecode(const char *text, size_t len) {
+    std::string out;
+    for(size_t i = 0; i < len; i++) {
+        if(text[i] == '+') {
+            out += ' ';
+        } else if(text[i] == '%' && i + 2 < len && hexDigit(text[i + 1]) >= 0 && hexDigit(text[i + 2]) >= 0) {
+            out += (char)(hexDigit(text[i + 1]) * 16 + hexDigit(text[i + 2]));
+            i += 2;
+        } else {
+            out += text[i];
+        }
+    }
+    return String(out);
+}
+
+AsyncWebServerRequest::AsyncWebServerRequest(WebRequestMethod method, const char *url, const char *body)
+    : requestMethod(method) {
+    const char *query = strchr(url, '?');
+    requestUrl = urlDecode(url, query ? (size_t)(query - url) : strlen(url));
+    if(query) addParams(query + 1, strlen(query + 1), false);
+    if(body) addParams(body, strlen(body), true);
+    // Room for the largest response (/metrics): capturing allocates nothing that benchmarks would count
+    hostContentType.reserve(64);
+    hostBody.reserve(65536);
+}
+
+AsyncWebServerRequest::~AsyncWebServerRequest() {
+    delete response;
+}
+
+void AsyncWebServerRequest::addParams(const char *text, size_t len, bool form) {
+    const char *end = text + len;
+    while(text < end) {
+        const char *amp = (const char *)memchr(text, '&', end - text);
+        const char *stop = amp ? amp : end;
+        const char *eq = (const char *)memchr(text, '=', stop - text);
+        if(stop > text) {
+            const char *nameEnd = eq ? eq : stop;
+            requestParams.emplace_back(urlDecode(text, nameEnd - text),
+                                       eq ? urlDecode(eq + 1, stop - eq - 1) : String(), form);
+        }
+        text = stop + 1;
+    }
+}
+
+const AsyncWebParameter *AsyncWebServerRequest::getParam(const String &name, bool post) const {
+    for(const AsyncWebParameter &p : requestParams) {
+        if(p.name() == name && p.isPost() == post) return &p;
+    }
+    return nullptr;
+}
+
+bool AsyncWebServerRequest::hasArg(const char *name) const {
+    for(const AsyncWebParameter &p : requestParams) {
+        if(p.name() == name) return true;
+    }
+    return false;
+}
+
+const String &AsyncWebServerRequest::arg(const String &name) const {
+    static const String empty;
+    for(const AsyncWebParameter &p : requestParams) {
+        if(p.name() == name) return p.value();
+    }
+    return empty;
+}
+
+const AsyncWebHeader *AsyncWebServerRequest::getHeader(const String &name) const {
+    for(const AsyncWebHeader &h : requestHeaders) {
+        if(h.name().equalsIgnoreCase(name)) return &h;
+    }
+    return nullptr;
+}
+
+const String &AsyncWebServerRequest::header(const char *name) const {
+    static const String empty;
+    const AsyncWebHeader *h = getHeader(name);
+    return h ? h->value() : empty;
+}
+
+const String *AsyncWebServerRequest::hostHeader(const char *name) const {
+    for(const AsyncWebHeader &h : hostHeaders) {
+        if(h.name().equalsIgnoreCase(name)) return &h.value();
+    }
+    return nullptr;
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse *r) {
+    hostSends++;
+    if(response) delete response;   // a second send() is a handler bug; the last one wins
+    response = r;
+}
+
+void AsyncWebServerRequest::send(int code, const String &contentType, const String &content) {
+    send(beginResponse(code, contentType, content));
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse(int code, const String &contentType, const String &content) {
+    return new AsyncBasicResponse(code, contentType, content);
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse_P(int code, const String &contentType,
+                                                               const uint8_t *content, size_t len) {
+    return new AsyncProgmemResponse(code, contentType, content, len);
+}
+
+void AsyncWebServerRequest::hostFinish() {
+    if(!response) return;
+    response->_hostSend(this);
+    delete response;
+    response = nullptr;
+}
+
+// ============================================================================
+// RESPONSES
+// ============================================================================
+
+void AsyncWebServerResponse::_hostSend(AsyncWebServerRequest *request) {
+    request->hostCode = _code;
+    request->hostContentType.assign(_contentType.c_str(), _contentType.length());
+    request->hostHeaders = headers;
+    request->hostBody.clear();
+}
+
+AsyncBasicResponse::AsyncBasicResponse(int code, const String &contentType, const String &content)
+    : content(content) {
+    _code = code;
+    _contentType = contentType;
+    _contentLength = content.length();
+}
+
+void AsyncBasicResponse::_hostSend(AsyncWebServerRequest *request) {
+    AsyncWebServerResponse::_hostSend(request);
+    request->hostBody.append(content.c_str(), content.length());
+}
+
+AsyncProgmemResponse::AsyncProgmemResponse(int code, const String &contentType, const uint8_t *content, size_t len)
+    : content(content) {
+    _code = code;
+    _contentType = contentType;
+    _contentLength = len;
+}
+
+void AsyncProgmemResponse::_hostSend(AsyncWebServerRequest *request) {
+    AsyncWebServerResponse::_hostSend(request);
+    request->hostBody.append((const char *)content, _contentLength);
+}
+
+// As the async_tcp send path: one _fillBuffer call per segment until the
+// declared length is sent or, without one, until the source returns 0
+void AsyncAbstractResponse::_hostSend(AsyncWebServerRequest *request) {
+    AsyncWebServerResponse::_hostSend(request);
+    bool knownLength = _sendContentLength && !_chunked;
+    uint8_t segment[1460];
+    size_t room = request->hostSegment < sizeof(segment) ? request->hostSegment : sizeof(segment);
+    size_t total = 0;
+    for(;;) {
+        size_t want = room;
+        if(knownLength) {
+            if(total >= _contentLength) break;
+            if(want > _contentLength - total) want = _contentLength - total;
+        }
+        size_t n = _fillBuffer(segment, want);
+        if(n == 0) break;
+        request->hostBody.append((const char *)segment, n);
+        total += n;
+    }
+}
+
+// ============================================================================
+// HANDLERS & SERVER
+// ============================================================================
+
+// As AsyncCallbackWebHandler: method bit, then "prefix*", exact URI or "uri/...".
+// Compared in place: the library's temporary Strings are not part of what the harness measures.
+bool AsyncCallbackWebHandler::canHandle(AsyncWebServerRequest *request) {
+    if(!(method & request->method())) return false;
+    const char *url = request->url().c_str();
+    size_t n = uri.length();
+    if(n && uri[n - 1] == '*') return strncmp(url, uri.c_str(), n - 1) == 0;
+    return n == 0 || (strncmp(url, uri.c_str(), n) == 0 && (url[n] == '\0' || url[n] == '/'));
+}
+
+void AsyncCallbackWebHandler::handleRequest(AsyncWebServerRequest *request) {
+    if(onRequest) onRequest(request);
+}
+
+AsyncWebServer::~AsyncWebServer() {
+    for(AsyncWebHandler *h : handlers) delete h;
+}
+
+AsyncCallbackWebHandler &AsyncWebServer::on(const char *uri, WebRequestMethodComposite method,
+                                            ArRequestHandlerFunction onRequest) {
+    AsyncCallbackWebHandler *handler = new AsyncCallbackWebHandler(uri, method, onRequest);
+    handlers.push_back(handler);
+    return *handler;
+}
+
+AsyncWebHandler &AsyncWebServer::addHandler(AsyncWebHandler *handler) {
+    handlers.push_back(handler);
+    return *handler;
+}
+
+void AsyncWebServer::hostHandle(AsyncWebServerRequest &request) {
+    for(AsyncWebHandler *h : handlers) {
+        if(h->canHandle(&request)) {
+            h->handleRequest(&request);
+            request.hostFinish();
+            return;
+        }
+    }
+    if(notFound) {
+        notFound(&request);
+    } else {
+        request.send(404);
+    }
+    request.hostFinish();
+}
@@ -0,0 +1,183 @@
+// ============================================================================
+// Host decoder for the binary telemetry stream (TCP port 8765)
+// ============================================================================
+// Build & run on Linux (not part of the PlatformIO firmware build):
+//   g++ -O2 -std=gnu++17 tools/telemetry_stream.cpp -o telemetry_stream
+//   ./telemetry_stream --host 192.168.1.50 --rate 50 --duration 60 > run.csv
+//
+// Writes one CSV line per record to stdout:
+//   seq,time_s,dev,position_steps,angle_deg,speed,load,status
+// Gaps in seq (records the device dropped because the reader was too slow)
+// are reported on stderr; the summary at the end states records, gaps, lost
+// records and the effective rate. Layout: include/telemetry_stream.h.
+// ============================================================================
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define STREAM_MAGIC 0x5354524D
+#define STREAM_VERSION 1
+
+#pragma pack(push, 1)
+struct StreamHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    int32_t stepsPerRev;
+    uint8_t rotators;
+    uint8_t rateHz;
+    uint16_t reserved;
+};
+
+struct StreamRecord {
+    uint32_t seq;
+    uint64_t timeUs;
+    int32_t position;
+    int16_t speed;
+    int16_t load;
+    uint8_t status;
+    uint8_t dev;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StreamHeader) == 16, "StreamHeader layout");
+static_assert(sizeof(StreamRecord) == 22, "StreamRecord layout");
+
+struct Options {
+    std::string host = "192.168.4.1";
+    std::string port = "8765";
+    int rate = 0;           // 0 = keep the device setting
+    double duration = 0;    // 0 = until the connection closes
+};
+
+static void usage() {
+    fprintf(stderr,
+            "usage: telemetry_stream [--host H] [--port P] [--rate HZ] [--duration S]\n"
+            "  --rate      position poll rate while streaming, 1..100 Hz\n"
+            "  --duration  stop after S seconds (default: until closed)\n");
+    exit(2);
+}
+
+enum ReadResult { READ_OK, READ_IDLE, READ_CLOSED };
+
+// READ_IDLE only when the receive timeout hit before the first byte, so a
+// record is never split
+static ReadResult readFull(int fd, void *buffer, size_t length) {
+    uint8_t *p = (uint8_t *)buffer;
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = recv(fd, p + done, length - done, 0);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (done == 0) return READ_IDLE;
+            continue;
+        }
+        if (n <= 0) return READ_CLOSED;
+        done += n;
+    }
+    return READ_OK;
+}
+
+static int connectTo(const Options &o) {
+    addrinfo hints = {}, *result = nullptr;
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(o.host.c_str(), o.port.c_str(), &hints, &result) != 0) return -1;
+    int fd = -1;
+    for (addrinfo *a = result; a; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) continue;
+        if (connect(fd, a->ai_addr, a->ai_addrlen) == 0) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(result);
+    return fd;
+}
+
+int main(int argc, char **argv) {
+    Options o;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) usage();
+        if (arg == "--host") o.host = argv[++i];
+        else if (arg == "--port") o.port = argv[++i];
+        else if (arg == "--rate") o.rate = atoi(argv[++i]);
+        else if (arg == "--duration") o.duration = atof(argv[++i]);
+        else usage();
+    }
+    if (o.rate < 0 || o.rate > 100) usage();
+
+    int fd = connectTo(o);
+    if (fd < 0) {
+        fprintf(stderr, "cannot connect to %s:%s\n", o.host.c_str(), o.port.c_str());
+        return 1;
+    }
+    // A receive timeout lets --duration end a quiet stream
+    timeval tv = {1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    StreamHeader h;
+    if (readFull(fd, &h, sizeof(h)) != READ_OK) {
+        fprintf(stderr, "no stream header\n");
+        return 1;
+    }
+    if (h.magic != STREAM_MAGIC || h.version != STREAM_VERSION || h.recordSize != sizeof(StreamRecord)) {
+        fprintf(stderr, "unsupported stream: magic %08x version %u record size %u\n",
+                h.magic, h.version, h.recordSize);
+        return 1;
+    }
+    if (o.rate) {
+        char command[32];
+        int n = snprintf(command, sizeof(command), "rate %d\n", o.rate);
+        send(fd, command, n, 0);
+    }
+    fprintf(stderr, "connected: %u rotator(s), %d steps/rev, %u Hz\n",
+            h.rotators, h.stepsPerRev, o.rate ? o.rate : h.rateHz);
+
+    printf("seq,time_s,dev,position_steps,angle_deg,speed,load,status\n");
+    auto start = std::chrono::steady_clock::now();
+    uint64_t records = 0, gaps = 0, lost = 0;
+    uint64_t firstUs = 0, lastUs = 0;
+    uint32_t expected = 0;
+    bool first = true;
+    int stepsPerRev = h.stepsPerRev > 0 ? h.stepsPerRev : 4096;
+
+    for (;;) {
+        if (o.duration > 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= o.duration) break;
+        StreamRecord r;
+        ReadResult result = readFull(fd, &r, sizeof(r));
+        if (result == READ_IDLE) continue;
+        if (result == READ_CLOSED) break;
+        if (!first && r.seq != expected) {
+            uint32_t missing = r.seq - expected;
+            fprintf(stderr, "gap: seq %u..%u (%u records)\n", expected, r.seq - 1, missing);
+            gaps++;
+            lost += missing;
+        }
+        if (first) firstUs = r.timeUs;
+        first = false;
+        expected = r.seq + 1;
+        lastUs = r.timeUs;
+        records++;
+
+        double angle = (double)(r.position % stepsPerRev) * 360.0 / stepsPerRev;
+        if (angle < 0) angle += 360.0;
+        printf("%u,%.6f,%u,%d,%.3f,%d,%d,%u\n", r.seq, r.timeUs / 1e6, r.dev, r.position, angle, r.speed, r.load, r.status);
+    }
+    close(fd);
+
+    double spanS = (lastUs - firstUs) / 1e6;
+    fprintf(stderr, "records %llu, gaps %llu, lost %llu, %.1f records/s over %.1f s\n",
+            (unsigned long long)records, (unsigned long long)gaps, (unsigned long long)lost,
+            spanS > 0 ? (records - 1) / spanS : 0.0, spanS);
+    return lost ? 3 : 0;
+}